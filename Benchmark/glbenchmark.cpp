@@ -0,0 +1,634 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :glbenchmark.cpp
+  @brief    :Headless rendering benchmark of the plot widgets
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include <QApplication>
+#include <QSurfaceFormat>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOffscreenSurface>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLTimerQuery>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QStringList>
+#include <QFile>
+#include <QDir>
+#include <QMap>
+#include <QImage>
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#include "Dialogs/glwindow.h"
+#include "Dialogs/xy_glwindow.h"
+#include "Managers/prefmanager.h"
+#include "Managers/decimator.h"
+#include "FontManager/fontmanager.h"
+
+#ifndef USE_VERTEX_ID
+#error "the benchmark measures the vertex ID rendering path used by ESPlot"
+#endif
+
+#define BENCH_PLOT_TIME 0
+#define BENCH_PLOT_XY 1
+
+#define BENCH_UPLOAD_FULL 0  //the whole visible window is copied and uploaded every frame
+#define BENCH_UPLOAD_STREAM 1  //only the new samples are written into the circular buffer
+#define BENCH_UPLOAD_M4 2  //the visible window is decimated per pixel column
+
+#define BENCH_RANGE 60.0  //range of the synthetic signals
+
+typedef struct _benchCase
+{
+    int plot;
+    int upload;
+    int lines;  //LINE_RENDERER_GS or LINE_RENDERER_QUAD, only for the time plot
+    int n_signals;
+    int n_points;
+    bool dots;  //dots instead of lines
+    bool overlays;  //legend and statistics
+} benchCase;
+
+typedef struct _benchResult
+{
+    double prepare_ms;  //CPU time spent preparing the buffers
+    double upload_ms;  //time spent sending the buffers to the GPU
+    double draw_ms;  //CPU time of paintGL up to glFinish
+    double gpu_ms;  //GPU time of paintGL from the timer queries, -1 when they are not available
+    QImage frame;  //last rendered frame
+} benchResult;
+
+typedef struct _benchContext
+{
+    QOpenGLContext *context;
+    QOffscreenSurface *surface;
+    QOpenGLFramebufferObject *fbo;
+    QOpenGLTimerQuery *timer;  //nullptr when the timer queries are not supported
+    int width, height;
+} benchContext;
+
+//the widgets are never shown: their GL entry points are driven directly on the offscreen context of the benchmark
+//makeCurrent and doneCurrent of a widget which has not been shown do nothing, so the offscreen context stays current
+class benchGLWindow : public GLWindow
+{
+public:
+    benchGLWindow(appPreferencesStruct *pref, fontManager *font) : GLWindow(nullptr, "Benchmark", pref, font) {}
+    void bench_Initialize() { initializeGL(); }
+    void bench_Paint() { paintGL(); }
+};
+
+class benchXYGLWindow : public XY_GLWindow
+{
+public:
+    benchXYGLWindow(appPreferencesStruct *pref, fontManager *font) : XY_GLWindow(nullptr, "Benchmark", pref, font) {}
+    void bench_Initialize() { initializeGL(); }
+    void bench_Paint() { paintGL(); }
+};
+
+static const char *plotNames[] = {"time", "xy"};
+static const char *uploadNames[] = {"full", "stream", "m4"};
+static const char *lineNames[] = {"auto", "gs", "quad"};
+
+int create_Context(benchContext *ctx, int width, int height)
+{
+    QOpenGLFramebufferObjectFormat fboFormat;
+
+    ctx->width = width;
+    ctx->height = height;
+    ctx->fbo = nullptr;
+    ctx->timer = nullptr;
+
+    ctx->context = new QOpenGLContext;
+    ctx->context->setFormat(QSurfaceFormat::defaultFormat());
+    if (ctx->context->create() == false)
+    {
+        qDebug("The OpenGL context could not be created");
+        return -1;
+    }
+
+    ctx->surface = new QOffscreenSurface;
+    ctx->surface->setFormat(ctx->context->format());
+    ctx->surface->create();
+    if (ctx->context->makeCurrent(ctx->surface) == false)
+    {
+        qDebug("The offscreen surface could not be made current");
+        return -1;
+    }
+
+    fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    ctx->fbo = new QOpenGLFramebufferObject(width, height, fboFormat);
+    if (ctx->fbo->isValid() == false)
+    {
+        qDebug("The framebuffer object could not be created");
+        return -1;
+    }
+
+    ctx->timer = new QOpenGLTimerQuery;
+    if (ctx->timer->create() == false)  //needs OpenGL 3.3 or GL_ARB_timer_query
+    {
+        delete ctx->timer;
+        ctx->timer = nullptr;
+    }
+
+    return 0;
+}
+
+void fill_Signals(std::vector<std::vector<float>> *data, int n_signals, int length, bool cosine)
+{
+    int i, j;
+    uint32_t seed;
+    double phase;
+
+    //sine waves with a different frequency per signal and some deterministic noise, so that the runs can be compared
+    data->resize(static_cast<size_t>(n_signals));
+    seed = 12345;
+    for (i = 0; i < n_signals; i++)
+    {
+        (*data)[static_cast<size_t>(i)].resize(static_cast<size_t>(length));
+        for (j = 0; j < length; j++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            phase = 2.0 * M_PI * static_cast<double>(j) * static_cast<double>(i + 1) / 1000.0;
+            if (cosine == true)
+                phase += M_PI / 2.0;
+            (*data)[static_cast<size_t>(i)][static_cast<size_t>(j)] = static_cast<float>((0.7 * BENCH_RANGE * sin(phase)) + (0.1 * BENCH_RANGE * ((static_cast<double>(seed >> 8) / 16777216.0) - 0.5)));
+        }
+    }
+}
+
+QVector<SigProperty> create_Properties(int n_signals, bool dots)
+{
+    QVector<SigProperty> prop;
+    int i;
+
+    prop.resize(n_signals);
+    for (i = 0; i < n_signals; i++)
+    {
+        prop[i].index = static_cast<uint32_t>(i);
+        prop[i].name = "Signal " + QString::number(i);
+        prop[i].color = QColor::fromHsv((i * 47) % 360, 200, 230);
+        prop[i].line_width = 1.5f;
+        prop[i].lineRendering = !dots;
+        prop[i].dotRendering = dots;
+        prop[i].triggerAct = nullptr;
+        prop[i].stats.initialized = true;
+        prop[i].stats.min = static_cast<float>(-BENCH_RANGE);
+        prop[i].stats.max = static_cast<float>(BENCH_RANGE);
+        prop[i].stats.mean = 0.0f;
+        prop[i].stats.rms = 0.0f;
+        prop[i].stats.std = 0.0f;
+        prop[i].stats.n_samples = 0;
+    }
+
+    return prop;
+}
+
+//draws one frame into the framebuffer object and measures it
+template <typename T> void draw_Frame(benchContext *ctx, T *w, double *draw_ms, double *gpu_ms)
+{
+    QOpenGLFunctions *f = ctx->context->functions();
+    QElapsedTimer t;
+
+    ctx->fbo->bind();
+    f->glViewport(0, 0, ctx->width, ctx->height);
+    t.start();
+    if (ctx->timer != nullptr)
+        ctx->timer->begin();
+    w->bench_Paint();
+    if (ctx->timer != nullptr)
+        ctx->timer->end();
+    f->glFinish();
+    *draw_ms += static_cast<double>(t.nsecsElapsed()) / 1e6;
+    if (ctx->timer != nullptr)
+        *gpu_ms += static_cast<double>(ctx->timer->waitForResult()) / 1e6;
+}
+
+int run_Time_Plot(benchContext *ctx, benchCase c, int frames, appPreferencesStruct *pref, fontManager *font, benchResult *res)
+{
+    benchGLWindow *w;
+    std::vector<std::vector<float>> data;
+    std::vector<float*> ptr;
+    QVector<GLfloat> buffer;
+    QVector<SigProperty> prop;
+    QVector<int> idx;
+    QVector<uint64_t> abs_start, epoch;
+    QElapsedTimer t;
+    double prepare_ms, upload_ms, draw_ms, gpu_ms;
+    int i, frame, advance, start, columns, n_out;
+    float step_x;
+
+    advance = c.n_points / 20;  //the window scrolls by 5% every frame
+    if (advance < 1)
+        advance = 1;
+    fill_Signals(&data, c.n_signals, c.n_points + (frames * advance), false);
+    ptr.resize(static_cast<size_t>(c.n_signals));
+    for (i = 0; i < c.n_signals; i++)
+        ptr[static_cast<size_t>(i)] = data[static_cast<size_t>(i)].data();
+
+    prop = create_Properties(c.n_signals, c.dots);
+    abs_start.resize(c.n_signals);
+    epoch.fill(1, c.n_signals);
+
+    w = new benchGLWindow(pref, font);
+    w->setMinimumSize(1, 1);
+    w->resize(ctx->width, ctx->height);
+    w->setGridNSamples(c.n_points);
+    w->setGridMinY(-BENCH_RANGE);
+    w->setGridMaxY(BENCH_RANGE);
+    w->get_Grid()->recreate_Grid();
+    ctx->fbo->bind();
+    w->bench_Initialize();
+    w->set_Line_Renderer(c.lines);
+    w->enable_legend(c.overlays);
+    w->enable_stats(c.overlays);
+
+    prepare_ms = 0.0; upload_ms = 0.0; draw_ms = 0.0; gpu_ms = 0.0;
+    //frame 0 warms up the buffers and the shaders and it is not counted
+    for (frame = 0; frame <= frames; frame++)
+    {
+        if (frame == 1)
+        {
+            prepare_ms = 0.0; upload_ms = 0.0; draw_ms = 0.0; gpu_ms = 0.0;
+        }
+        start = frame * advance;
+
+        //CPU preparation, the same work done by plot_Window before the upload
+        t.start();
+        columns = 0;
+        n_out = c.n_points;
+        step_x = 0.0f;
+        if (c.upload == BENCH_UPLOAD_M4)
+        {
+            columns = w->get_Pixel_Columns();
+            if (m4Decimator::isWorthwhile(c.n_points, columns) == true)
+            {
+                n_out = columns * M4_POINTS_PER_COLUMN;
+                step_x = w->get_Grid()->get_StepX() * static_cast<float>(c.n_points - 1) / static_cast<float>(n_out - 1);
+                buffer.resize(c.n_signals * n_out);
+                for (i = 0; i < c.n_signals; i++)
+                    m4Decimator::decimate(ptr[static_cast<size_t>(i)] + start, c.n_points, columns, buffer.data() + (i * n_out));
+            }
+            else
+                columns = 0;
+        }
+        if ((c.upload == BENCH_UPLOAD_FULL) || ((c.upload == BENCH_UPLOAD_M4) && (columns == 0)))
+        {
+            buffer.resize(c.n_signals * c.n_points);
+            for (i = 0; i < c.n_signals; i++)
+                memcpy(buffer.data() + (i * c.n_points), ptr[static_cast<size_t>(i)] + start, static_cast<size_t>(c.n_points) * sizeof(float));
+        }
+        if (c.upload == BENCH_UPLOAD_STREAM)
+        {
+            for (i = 0; i < c.n_signals; i++)
+                abs_start[i] = static_cast<uint64_t>(start);
+        }
+        idx.resize(c.n_signals);
+        for (i = 0; i < c.n_signals; i++)
+            idx[i] = i * n_out;
+        prepare_ms += static_cast<double>(t.nsecsElapsed()) / 1e6;
+
+        //upload, glFinish makes sure that the transfer is included
+        t.restart();
+        if (c.upload == BENCH_UPLOAD_STREAM)
+        {
+            w->set_X_Step(0.0f);
+            w->stream_Signal_Buffer(c.n_signals, c.n_points, ptr.data(), start, abs_start, epoch, prop);
+        }
+        else
+        {
+            w->set_X_Step(step_x);
+            w->parallel_prepare_Signal_Buffer(c.n_signals, n_out, &buffer, prop, idx);
+        }
+        ctx->context->functions()->glFinish();
+        upload_ms += static_cast<double>(t.nsecsElapsed()) / 1e6;
+
+        draw_Frame(ctx, w, &draw_ms, &gpu_ms);
+    }
+
+    res->prepare_ms = prepare_ms / frames;
+    res->upload_ms = upload_ms / frames;
+    res->draw_ms = draw_ms / frames;
+    res->gpu_ms = -1.0;
+    if (ctx->timer != nullptr)
+        res->gpu_ms = gpu_ms / frames;
+    res->frame = ctx->fbo->toImage();
+
+    delete w;  //the offscreen context is still current, the GL objects of the widget are released
+
+    return 0;
+}
+
+int run_XY_Plot(benchContext *ctx, benchCase c, int frames, appPreferencesStruct *pref, fontManager *font, benchResult *res)
+{
+    benchXYGLWindow *w;
+    std::vector<std::vector<float>> x_data, y_data;
+    QVector<GLfloat> x_buffer, y_buffer;
+    QVector<XY_SigProperty> prop;
+    QVector<SigProperty> sig_prop;
+    QVector<int> idx;
+    QElapsedTimer t;
+    double prepare_ms, upload_ms, draw_ms, gpu_ms;
+    int i, frame, advance, start;
+
+    advance = c.n_points / 20;
+    if (advance < 1)
+        advance = 1;
+    fill_Signals(&x_data, c.n_signals, c.n_points + (frames * advance), true);
+    fill_Signals(&y_data, c.n_signals, c.n_points + (frames * advance), false);
+
+    sig_prop = create_Properties(c.n_signals, c.dots);
+    prop.resize(c.n_signals);
+    idx.resize(c.n_signals);
+    for (i = 0; i < c.n_signals; i++)
+    {
+        prop[i].x_index = static_cast<uint32_t>(2 * i);
+        prop[i].y_index = static_cast<uint32_t>((2 * i) + 1);
+        prop[i].name = sig_prop[i].name;
+        prop[i].color = sig_prop[i].color;
+        prop[i].line_width = sig_prop[i].line_width;
+        prop[i].lineRendering = sig_prop[i].lineRendering;
+        prop[i].dotRendering = sig_prop[i].dotRendering;
+        idx[i] = i * c.n_points;
+    }
+
+    w = new benchXYGLWindow(pref, font);
+    w->setMinimumSize(1, 1);
+    w->resize(ctx->width, ctx->height);
+    w->setGridMinX(-BENCH_RANGE);
+    w->setGridMaxX(BENCH_RANGE);
+    w->setGridMinY(-BENCH_RANGE);
+    w->setGridMaxY(BENCH_RANGE);
+    w->get_Grid()->recreate_Grid();
+    ctx->fbo->bind();
+    w->bench_Initialize();
+    w->enable_legend(c.overlays);
+
+    prepare_ms = 0.0; upload_ms = 0.0; draw_ms = 0.0; gpu_ms = 0.0;
+    for (frame = 0; frame <= frames; frame++)
+    {
+        if (frame == 1)
+        {
+            prepare_ms = 0.0; upload_ms = 0.0; draw_ms = 0.0; gpu_ms = 0.0;
+        }
+        start = frame * advance;
+
+        t.start();
+        x_buffer.resize(c.n_signals * c.n_points);
+        y_buffer.resize(c.n_signals * c.n_points);
+        for (i = 0; i < c.n_signals; i++)
+        {
+            memcpy(x_buffer.data() + (i * c.n_points), x_data[static_cast<size_t>(i)].data() + start, static_cast<size_t>(c.n_points) * sizeof(float));
+            memcpy(y_buffer.data() + (i * c.n_points), y_data[static_cast<size_t>(i)].data() + start, static_cast<size_t>(c.n_points) * sizeof(float));
+        }
+        prepare_ms += static_cast<double>(t.nsecsElapsed()) / 1e6;
+
+        t.restart();
+        w->prepare_Signal_Buffer(c.n_signals, c.n_points, &x_buffer, &y_buffer, prop, idx, c.n_points);
+        ctx->context->functions()->glFinish();
+        upload_ms += static_cast<double>(t.nsecsElapsed()) / 1e6;
+
+        draw_Frame(ctx, w, &draw_ms, &gpu_ms);
+    }
+
+    res->prepare_ms = prepare_ms / frames;
+    res->upload_ms = upload_ms / frames;
+    res->draw_ms = draw_ms / frames;
+    res->gpu_ms = -1.0;
+    if (ctx->timer != nullptr)
+        res->gpu_ms = gpu_ms / frames;
+    res->frame = ctx->fbo->toImage();
+
+    delete w;
+
+    return 0;
+}
+
+QVector<int> parse_List(QString text)
+{
+    QVector<int> values;
+    QStringList items;
+    int i, v;
+    bool ok;
+
+    items = text.split(",", QString::SkipEmptyParts);
+    for (i = 0; i < items.count(); i++)
+    {
+        v = items[i].trimmed().toInt(&ok);
+        if ((ok == true) && (v > 0))
+            values.append(v);
+    }
+    return values;
+}
+
+QString case_Key(benchCase c)
+{
+    QString key;
+
+    key = QString(plotNames[c.plot]) + "," + QString(uploadNames[c.upload]) + "," + QString(lineNames[c.lines]) + "," + QString::number(c.n_signals) + "," + QString::number(c.n_points) + ",";
+    if (c.dots == true)
+        key += "dots,";
+    else
+        key += "lines,";
+    if (c.overlays == true)
+        key += "on";
+    else
+        key += "off";
+    return key;
+}
+
+//reads a previous output of the benchmark: the key columns are associated with the total time per frame
+QMap<QString, double> load_Baseline(QString filename)
+{
+    QMap<QString, double> baseline;
+    QFile file(filename);
+    QStringList fields;
+    QString line;
+
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+    {
+        qDebug("The baseline file could not be opened");
+        return baseline;
+    }
+    while (file.atEnd() == false)
+    {
+        line = QString(file.readLine()).trimmed();
+        fields = line.split(",");
+        if ((fields.count() < 10) || (fields[0] == "plot"))
+            continue;
+        baseline.insert(QStringList(fields.mid(0, 7)).join(","), fields[7].toDouble() + fields[8].toDouble() + fields[9].toDouble());
+    }
+    return baseline;
+}
+
+int main(int argc, char *argv[])
+{
+    QSurfaceFormat fmt;
+    QCommandLineParser parser;
+    QVector<int> signalCounts, pointCounts;
+    QVector<benchCase> cases;
+    QMap<QString, double> baseline;
+    QStringList plots, uploads, lines;
+    benchContext ctx;
+    benchCase c;
+    benchResult res;
+    double total, tolerance;
+    int i, j, p, u, l, d, o, frames, regressions;
+
+    //without a display the offscreen platform is used, another platform can still be chosen with QT_QPA_PLATFORM
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") == true)
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    Q_INIT_RESOURCE(resources);
+    QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ESPlot rendering benchmark");
+
+    parser.setApplicationDescription("Renders the plot widgets offscreen with synthetic data and reports prepare, upload and draw time per frame.");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("frames", "Frames measured for each case.", "n", "50"));
+    parser.addOption(QCommandLineOption("width", "Width of the framebuffer.", "pixels", "1280"));
+    parser.addOption(QCommandLineOption("height", "Height of the framebuffer.", "pixels", "720"));
+    parser.addOption(QCommandLineOption("signals", "Comma separated list of signal counts.", "list", "1,4,16"));
+    parser.addOption(QCommandLineOption("points", "Comma separated list of points per plot.", "list", "1000,10000,100000"));
+    parser.addOption(QCommandLineOption("plots", "Comma separated list of plots (time, xy).", "list", "time,xy"));
+    parser.addOption(QCommandLineOption("uploads", "Comma separated list of upload modes of the time plot (full, stream, m4).", "list", "full,stream,m4"));
+    parser.addOption(QCommandLineOption("lines", "Comma separated list of line renderers of the time plot (gs, quad).", "list", "gs,quad"));
+    parser.addOption(QCommandLineOption("samples", "Multisampling of the context.", "n", "0"));
+    parser.addOption(QCommandLineOption("baseline", "Previous output of the benchmark, the cases slower than the baseline are reported.", "file"));
+    parser.addOption(QCommandLineOption("tolerance", "Allowed slow down with respect to the baseline in percent.", "percent", "25"));
+    parser.addOption(QCommandLineOption("images", "Directory where the last frame of every case is saved.", "dir"));
+    parser.process(app);
+
+    frames = parser.value("frames").toInt();
+    if (frames < 1)
+        frames = 1;
+    signalCounts = parse_List(parser.value("signals"));
+    pointCounts = parse_List(parser.value("points"));
+    plots = parser.value("plots").split(",", QString::SkipEmptyParts);
+    uploads = parser.value("uploads").split(",", QString::SkipEmptyParts);
+    lines = parser.value("lines").split(",", QString::SkipEmptyParts);
+    tolerance = parser.value("tolerance").toDouble();
+
+    //same context requested by ESPlot
+    fmt.setDepthBufferSize(24);
+    fmt.setVersion(3, 2);
+    fmt.setProfile(QSurfaceFormat::CoreProfile);
+    fmt.setSamples(parser.value("samples").toInt());
+    QSurfaceFormat::setDefaultFormat(fmt);
+
+    if (create_Context(&ctx, parser.value("width").toInt(), parser.value("height").toInt()) != 0)
+        return 1;
+
+    prefManager prefMng;
+    fontManager fontMgr(prefMng.getPreferences());
+    fontMgr.addFont("Euler", ":/fonts/3rdparty/Fonts/Euler/euler.otf");
+    fontMgr.addFont("Libertine", ":/fonts/3rdparty/Fonts/Linux Libertine/LinLibertine_M.otf");
+    fontMgr.addFont("Quattrocento", ":/fonts/3rdparty/Fonts/Quattrocento/Quattrocento-Regular.ttf");
+    fontMgr.setDefaultFont("Euler");
+
+    //list of the cases
+    for (p = 0; p < 2; p++)
+    {
+        if (plots.contains(plotNames[p]) == false)
+            continue;
+        for (u = 0; u < 3; u++)
+        {
+            if ((p == BENCH_PLOT_XY) && (u != BENCH_UPLOAD_FULL))
+                continue;  //the xy plot has only the full upload
+            if ((p == BENCH_PLOT_TIME) && (uploads.contains(uploadNames[u]) == false))
+                continue;
+            for (l = LINE_RENDERER_GS; l <= LINE_RENDERER_QUAD; l++)
+            {
+                if ((p == BENCH_PLOT_XY) && (l != LINE_RENDERER_GS))
+                    continue;  //the xy plot has only the geometry shader
+                if ((p == BENCH_PLOT_TIME) && (lines.contains(lineNames[l]) == false))
+                    continue;
+                for (i = 0; i < signalCounts.count(); i++)
+                    for (j = 0; j < pointCounts.count(); j++)
+                        for (d = 0; d < 2; d++)
+                            for (o = 0; o < 2; o++)
+                            {
+                                c.plot = p; c.upload = u; c.lines = l;
+                                c.n_signals = signalCounts[i]; c.n_points = pointCounts[j];
+                                c.dots = (d == 1); c.overlays = (o == 1);
+                                cases.append(c);
+                            }
+            }
+        }
+    }
+
+    if (parser.isSet("baseline") == true)
+        baseline = load_Baseline(parser.value("baseline"));
+    if (parser.isSet("images") == true)
+        QDir().mkpath(parser.value("images"));
+
+    QTextStream out(stdout);
+    out << "# " << reinterpret_cast<const char*>(ctx.context->functions()->glGetString(GL_RENDERER)) << " " << reinterpret_cast<const char*>(ctx.context->functions()->glGetString(GL_VERSION)) << endl;
+    if (ctx.timer == nullptr)
+        out << "# timer queries not available, gpu_ms is -1" << endl;
+    out << "plot,upload,lines,signals,points,rendering,overlays,prepare_ms,upload_ms,draw_ms,gpu_ms" << endl;
+
+    regressions = 0;
+    for (i = 0; i < cases.count(); i++)
+    {
+        if (cases[i].plot == BENCH_PLOT_TIME)
+            run_Time_Plot(&ctx, cases[i], frames, prefMng.getPreferences(), &fontMgr, &res);
+        else
+            run_XY_Plot(&ctx, cases[i], frames, prefMng.getPreferences(), &fontMgr, &res);
+
+        out << case_Key(cases[i]) << "," << QString::number(res.prepare_ms, 'f', 3) << "," << QString::number(res.upload_ms, 'f', 3) << "," << QString::number(res.draw_ms, 'f', 3) << "," << QString::number(res.gpu_ms, 'f', 3) << endl;
+
+        if (parser.isSet("images") == true)
+            res.frame.save(parser.value("images") + "/" + QString(case_Key(cases[i])).replace(",", "_") + ".png");
+
+        total = res.prepare_ms + res.upload_ms + res.draw_ms;
+        if ((baseline.contains(case_Key(cases[i])) == true) && (total > (baseline.value(case_Key(cases[i])) * (1.0 + (tolerance / 100.0)))))
+        {
+            out << "# REGRESSION " << case_Key(cases[i]) << " " << QString::number(total, 'f', 3) << " ms instead of " << QString::number(baseline.value(case_Key(cases[i])), 'f', 3) << " ms" << endl;
+            regressions++;
+        }
+    }
+
+    ctx.context->makeCurrent(ctx.surface);
+    delete ctx.timer;
+    delete ctx.fbo;
+    ctx.context->doneCurrent();
+    delete ctx.context;
+    delete ctx.surface;
+
+    if (regressions > 0)
+        return 2;
+    return 0;
+}
@@ -0,0 +1,91 @@
+#  *********************************************************************************************************************************************************
+#  @file     :glbenchmark.pro
+#  @brief    :Project file of the rendering benchmark of ESPlot
+#  *********************************************************************************************************************************************************
+#  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+#  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+
+#  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+
+#  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+#  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU Affero General Public License as
+#  published by the Free Software Foundation, either version 3 of the
+#  License, or any later version.
+
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#  GNU Affero General Public License for more details.
+
+#  You should have received a copy of the GNU Affero General Public License
+#  along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+
+#  Commercial licensing opportunities
+#  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+#  *********************************************************************************************************************************************************
+
+TARGET = ESPlotBenchmark
+
+QT += widgets
+QT += core
+
+CONFIG += c++11
+CONFIG += qt
+CONFIG += console
+CONFIG -= app_bundle
+
+QMAKE_CFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CFLAGS_RELEASE += -O3
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+# the plot widgets are compiled from the sources of ESPlot with the same flags
+RESOURCES = $$PWD/../resources.qrc
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += USE_VERTEX_ID
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    glbenchmark.cpp \
+    $$PWD/../FontManager/fontmanager.cpp \
+    $$PWD/../FontManager/glyphloader.cpp \
+    $$PWD/../Creators/densitymap.cpp \
+    $$PWD/../Creators/grid.cpp \
+    $$PWD/../Creators/grid_xy.cpp \
+    $$PWD/../Creators/legendCreator.cpp \
+    $$PWD/../Creators/statcreator.cpp \
+    $$PWD/../Creators/textrenderer.cpp \
+    $$PWD/../Creators/tooltipcreator.cpp \
+    $$PWD/../Dialogs/glwindow.cpp \
+    $$PWD/../Dialogs/xy_glwindow.cpp \
+    $$PWD/../Managers/decimator.cpp \
+    $$PWD/../Managers/glresourcemanager.cpp \
+    $$PWD/../Managers/prefmanager.cpp \
+    $$PWD/../Managers/thumbnailgrabber.cpp
+
+HEADERS += \
+    $$PWD/../FontManager/fontmanager.h \
+    $$PWD/../FontManager/glyphloader.h \
+    $$PWD/../Creators/densitymap.h \
+    $$PWD/../Creators/grid.h \
+    $$PWD/../Creators/grid_xy.h \
+    $$PWD/../Creators/legendCreator.h \
+    $$PWD/../Creators/statcreator.h \
+    $$PWD/../Creators/textrenderer.h \
+    $$PWD/../Creators/tooltipcreator.h \
+    $$PWD/../Dialogs/glwindow.h \
+    $$PWD/../Dialogs/xy_glwindow.h \
+    $$PWD/../Managers/decimator.h \
+    $$PWD/../Managers/glresourcemanager.h \
+    $$PWD/../Managers/prefmanager.h \
+    $$PWD/../Managers/thumbnailgrabber.h \
+    $$PWD/../definitions.h
+
+include($$PWD/../freetype.pri)
@@ -0,0 +1,369 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :kernelbenchmark.cpp
+  @brief    :Benchmark and equivalence check of the float kernels
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QStringList>
+#include <QVector>
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#include "Managers/floatkernels.h"
+
+#define CHECK_ROUNDS 2000  //random cases of the equivalence check
+#define CHECK_MAX_LENGTH 600  //longer than the vectors and the unrolled loops of every instruction set
+#define CHECK_TOLERANCE 1e-9  //relative, the sums are accumulated in a different order by the vector loops
+
+#define BENCH_RANGE 60.0f  //range of the synthetic signals
+
+static volatile double sink;  //keeps the results of the timed loops
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+//scalar references, the plain loops replaced by the kernels
+
+void ref_Reduce(const float *data, int N, spanReduction *out)
+{
+    int k;
+
+    out->min = INFINITY;
+    out->max = -INFINITY;
+    out->sum = 0.0;
+    out->sumsq = 0.0;
+    out->finite = 0;
+    for (k = 0; k < N; k++)
+    {
+        if (isfinite(data[k]) == false)
+            continue;
+        if (data[k] < out->min)
+            out->min = data[k];
+        if (data[k] > out->max)
+            out->max = data[k];
+        out->sum += static_cast<double>(data[k]);
+        out->sumsq += static_cast<double>(data[k]) * static_cast<double>(data[k]);
+        out->finite++;
+    }
+}
+
+double ref_Deviations(const float *data, int N, double mean)
+{
+    int k;
+    double d, m2;
+
+    m2 = 0.0;
+    for (k = 0; k < N; k++)
+    {
+        if (isfinite(data[k]) == false)
+            continue;
+        d = static_cast<double>(data[k]) - mean;
+        m2 += d * d;
+    }
+    return m2;
+}
+
+bool ref_Crossing(const float *data, int k, float level, int edge)
+{
+    if (edge == KERNEL_EDGE_RISING)
+        return (data[k - 1] < level) && (data[k] >= level);
+    return (data[k - 1] > level) && (data[k] <= level);
+}
+
+int ref_Find_First(const float *data, int from, int to, float level, int edge)
+{
+    int k;
+
+    if (from < 1)
+        from = 1;
+    for (k = from; k < to; k++)
+        if (ref_Crossing(data, k, level, edge) == true)
+            return k;
+    return -1;
+}
+
+int ref_Find_Last(const float *data, int from, int to, float level, int edge)
+{
+    int k;
+
+    if (from < 1)
+        from = 1;
+    for (k = to - 1; k >= from; k--)
+        if (ref_Crossing(data, k, level, edge) == true)
+            return k;
+    return -1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//linear congruential generator, the same data on every machine
+float next_Random(uint32_t *seed)
+{
+    *seed = (*seed * 1664525u) + 1013904223u;
+    return (static_cast<float>(*seed >> 8) / 16777216.0f) * 2.0f * BENCH_RANGE - BENCH_RANGE;
+}
+
+//sine with noise, one sample in nan_every is NAN or infinite (never if nan_every is 0)
+void fill_Data(std::vector<float> *data, int N, int nan_every, uint32_t *seed)
+{
+    int k;
+
+    data->resize(static_cast<size_t>(N));
+    for (k = 0; k < N; k++)
+    {
+        (*data)[static_cast<size_t>(k)] = BENCH_RANGE * sinf(static_cast<float>(k) * 0.05f) + 0.1f * next_Random(seed);
+        if ((nan_every > 0) && ((*seed % static_cast<uint32_t>(nan_every)) == 0))
+        {
+            if ((*seed & 0x100) == 0)
+                (*data)[static_cast<size_t>(k)] = NAN;
+            else
+                (*data)[static_cast<size_t>(k)] = INFINITY;
+        }
+    }
+}
+
+bool same_Sum(double a, double b)
+{
+    return fabs(a - b) <= CHECK_TOLERANCE * (1.0 + fabs(a));
+}
+
+//compares every kernel with its scalar reference on random lengths, ranges, levels and missing samples, returns the mismatches
+int check_Kernels(QTextStream *out)
+{
+    std::vector<float> data;
+    float *ptr[2];
+    spanReduction r, ref;
+    uint32_t seed;
+    int i, N, from, to, edge, errors, a, b;
+    float level, min, max, ref_min, ref_max;
+    bool found, ref_found;
+
+    seed = 1;
+    errors = 0;
+    for (i = 0; i < CHECK_ROUNDS; i++)
+    {
+        N = static_cast<int>((seed >> 4) % CHECK_MAX_LENGTH) + 1;
+        fill_Data(&data, N, static_cast<int>(i % 4) * 7, &seed);
+
+        floatKernels::reduce(data.data(), N, &r);
+        ref_Reduce(data.data(), N, &ref);
+        if ((r.finite != ref.finite) || (r.min != ref.min) || (r.max != ref.max) || (same_Sum(ref.sum, r.sum) == false) || (same_Sum(ref.sumsq, r.sumsq) == false))
+        {
+            *out << "# MISMATCH reduce, length " << N << endl;
+            errors++;
+        }
+        if (ref.finite > 0)
+        {
+            if (same_Sum(ref_Deviations(data.data(), N, ref.sum / ref.finite), floatKernels::sumSquaredDeviations(data.data(), N, ref.sum / ref.finite)) == false)
+            {
+                *out << "# MISMATCH sumSquaredDeviations, length " << N << endl;
+                errors++;
+            }
+        }
+
+        //the levels also hit the samples exactly, to check the equality of the crossings
+        if ((i % 3) == 0)
+            level = data[static_cast<size_t>(seed % static_cast<uint32_t>(N))];
+        else
+            level = next_Random(&seed);
+        from = static_cast<int>(seed % static_cast<uint32_t>(N + 1));
+        to = from + static_cast<int>((seed >> 12) % static_cast<uint32_t>(N - from + 1));
+        for (edge = KERNEL_EDGE_RISING; edge <= KERNEL_EDGE_FALLING; edge++)
+        {
+            a = floatKernels::findCrossing(data.data(), from, to, level, edge);
+            b = ref_Find_First(data.data(), from, to, level, edge);
+            if (a != b)
+            {
+                *out << "# MISMATCH findCrossing, length " << N << ", " << a << " instead of " << b << endl;
+                errors++;
+            }
+            a = floatKernels::findLastCrossing(data.data(), from, to, level, edge);
+            b = ref_Find_Last(data.data(), from, to, level, edge);
+            if (a != b)
+            {
+                *out << "# MISMATCH findLastCrossing, length " << N << ", " << a << " instead of " << b << endl;
+                errors++;
+            }
+        }
+
+        //two signals sharing the buffer, the range is inclusive
+        ptr[0] = data.data();
+        ptr[1] = data.data() + (N / 2);
+        to = (N - 1) / 2;
+        from = std::min(from, to);
+        min = 0.0f;
+        max = 0.0f;
+        found = floatKernels::rangeOfSignals(2, from, to, ptr, &min, &max);
+        ref_found = false;
+        ref_min = INFINITY;
+        ref_max = -INFINITY;
+        for (a = 0; a < 2; a++)
+        {
+            ref_Reduce(ptr[a] + from, to - from + 1, &ref);
+            if (ref.finite == 0)
+                continue;
+            ref_min = std::min(ref_min, ref.min);
+            ref_max = std::max(ref_max, ref.max);
+            ref_found = true;
+        }
+        if ((found != ref_found) || ((found == true) && ((min != ref_min) || (max != ref_max))))
+        {
+            *out << "# MISMATCH rangeOfSignals, length " << N << endl;
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//time per call in microseconds of the scalar reference and of the kernel
+void time_Kernel(int kernel, const std::vector<float> &data, int repeats, double *scalar_us, double *kernel_us)
+{
+    QElapsedTimer timer;
+    spanReduction r;
+    const float *d;
+    double acc;
+    int i, N, pass;
+
+    d = data.data();
+    N = static_cast<int>(data.size());
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        acc = 0.0;
+        timer.start();
+        for (i = 0; i < repeats; i++)
+        {
+            switch (kernel)
+            {
+            case 0:
+                if (pass == 0)
+                    ref_Reduce(d, N, &r);
+                else
+                    floatKernels::reduce(d, N, &r);
+                acc += r.sum;
+                break;
+            case 1:
+                if (pass == 0)
+                    acc += ref_Deviations(d, N, 0.0);
+                else
+                    acc += floatKernels::sumSquaredDeviations(d, N, 0.0);
+                break;
+            default:
+                //the level is above every sample: the whole buffer is scanned
+                if (pass == 0)
+                    acc += ref_Find_First(d, 1, N, 2.0f * BENCH_RANGE, KERNEL_EDGE_RISING);
+                else
+                    acc += floatKernels::findCrossing(d, 1, N, 2.0f * BENCH_RANGE, KERNEL_EDGE_RISING);
+                break;
+            }
+        }
+        if (pass == 0)
+            *scalar_us = static_cast<double>(timer.nsecsElapsed()) / 1000.0 / repeats;
+        else
+            *kernel_us = static_cast<double>(timer.nsecsElapsed()) / 1000.0 / repeats;
+        sink = acc;
+    }
+}
+
+QVector<int> parse_List(QString list)
+{
+    QVector<int> values;
+    QStringList items;
+    int i;
+
+    items = list.split(",", QString::SkipEmptyParts);
+    for (i = 0; i < items.count(); i++)
+        if (items[i].toInt() > 0)
+            values.append(items[i].toInt());
+    return values;
+}
+
+static const char *kernelNames[] = {"reduce", "sumSquaredDeviations", "findCrossing"};
+
+int main(int argc, char *argv[])
+{
+    QCommandLineParser parser;
+    QVector<int> lengths;
+    std::vector<float> data;
+    double scalar_us, kernel_us;
+    uint32_t seed;
+    int i, k, repeats, errors;
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ESPlot kernel benchmark");
+
+    parser.setApplicationDescription("Checks the float kernels against the scalar loops and reports the time per call of both.");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("lengths", "Comma separated list of buffer lengths.", "list", "1000,100000,1000000"));
+    parser.addOption(QCommandLineOption("repeats", "Calls measured for each case.", "n", "100"));
+    parser.addOption(QCommandLineOption("check-only", "Only runs the equivalence check."));
+    parser.process(app);
+
+    lengths = parse_List(parser.value("lengths"));
+    repeats = parser.value("repeats").toInt();
+    if (repeats < 1)
+        repeats = 1;
+
+    QTextStream out(stdout);
+    out << "# instruction set " << floatKernels::getInstructionSet() << endl;
+
+    errors = check_Kernels(&out);
+    out << "# equivalence check: " << errors << " mismatches in " << CHECK_ROUNDS << " cases" << endl;
+    if (parser.isSet("check-only") == true)
+    {
+        if (errors > 0)
+            return 2;
+        return 0;
+    }
+
+    out << "kernel,length,scalar_us,kernel_us,speedup" << endl;
+    seed = 1;
+    for (i = 0; i < lengths.count(); i++)
+    {
+        fill_Data(&data, lengths[i], 0, &seed);
+        for (k = 0; k < 3; k++)
+        {
+            time_Kernel(k, data, repeats, &scalar_us, &kernel_us);
+            out << kernelNames[k] << "," << lengths[i] << "," << QString::number(scalar_us, 'f', 3) << "," << QString::number(kernel_us, 'f', 3) << "," << QString::number(scalar_us / std::max(kernel_us, 1e-6), 'f', 2) << endl;
+        }
+    }
+
+    if (errors > 0)
+        return 2;
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :densitymap.cpp
+  @brief    :Functions for densityMap class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "densitymap.h"
+
+densityMap::densityMap(int bins)
+{
+    nBins = bins;
+    bin.fill(0.0f, nBins * nBins);
+
+    scale = 1.0f;
+    maxBin = 0.0f;
+    dirtyFirst = 0;
+    dirtyLast = nBins - 1;  //the texture has to be filled once
+}
+
+void densityMap::clear()
+{
+    bin.fill(0.0f);
+
+    scale = 1.0f;
+    maxBin = 0.0f;
+    dirtyFirst = 0;
+    dirtyLast = nBins - 1;
+}
+
+void densityMap::decay(float factor)
+{
+    if (factor >= 1.0f)
+        return;
+
+    if (factor <= 0.0f)
+    {
+        clear();
+        return;
+    }
+
+    scale *= factor;
+    if (scale < DENSITY_MIN_SCALE)
+        renormalize();
+}
+
+void densityMap::renormalize()
+{
+    int i;
+
+    for (i = 0; i < bin.count(); i++)
+        bin[i] *= scale;
+    maxBin *= scale;
+    scale = 1.0f;
+
+    dirtyFirst = 0;
+    dirtyLast = nBins - 1;
+}
+
+void densityMap::addPoints(const float *x, const float *y, int N, QVector4D mapping)
+{
+    int i, bx, by;
+    float px, py, weight, half;
+
+    if (N <= 0)
+        return;
+
+    weight = 1.0f / scale;
+    half = static_cast<float>(nBins) / 2.0f;
+
+    for (i = 0; i < N; i++)
+    {
+        if ((std::isfinite(x[i]) == false) || (std::isfinite(y[i]) == false))
+            continue;
+
+        px = (x[i] * mapping.x()) + mapping.z();
+        py = (y[i] * mapping.y()) + mapping.w();
+        if ((px < -1.0f) || (px >= 1.0f) || (py < -1.0f) || (py >= 1.0f))  //outside the plot area
+            continue;
+
+        bx = static_cast<int>((px + 1.0f) * half);
+        by = static_cast<int>((py + 1.0f) * half);
+        addBin(bx, by, weight);
+    }
+}
+
+void densityMap::addTrace(const float *y, int N, float x0, float dx, float convY, float offY)
+{
+    int k, column, row, prevColumn, prevRow, c, r, next;
+    float weight, half, py;
+
+    weight = 1.0f / scale;
+    half = static_cast<float>(nBins) / 2.0f;
+    prevColumn = -1;
+    prevRow = -1;
+
+    //as the beam of a scope: every bin crossed by the trace is lit once, also between two samples
+    for (k = 0; k < N; k++)
+    {
+        if (std::isfinite(y[k]) == false)
+        {
+            prevColumn = -1;
+            continue;
+        }
+
+        column = static_cast<int>(std::floor((x0 + (static_cast<float>(k) * dx) + 1.0f) * half));
+        py = std::floor(((y[k] * convY) + offY + 1.0f) * half);
+        if (py < -1.0f)  //the rows outside the map are only needed to join the samples
+            py = -1.0f;
+        if (py > static_cast<float>(nBins))
+            py = static_cast<float>(nBins);
+        row = static_cast<int>(py);
+
+        if ((prevColumn == -1) || (column < prevColumn))
+            addBin(column, row, weight);
+        else if (column == prevColumn)
+            addColumn(column, prevRow, row, weight);
+        else
+        {
+            r = prevRow;
+            for (c = prevColumn + 1; c <= column; c++)
+            {
+                next = prevRow + (((row - prevRow) * (c - prevColumn)) / (column - prevColumn));
+                addColumn(c, r, next, weight);
+                r = next;
+            }
+        }
+
+        prevColumn = column;
+        prevRow = row;
+    }
+}
+
+void densityMap::addColumn(int column, int from, int to, float weight)
+{
+    int r;
+
+    if (from == to)
+    {
+        addBin(column, to, weight);
+        return;
+    }
+
+    if (to > from)
+        for (r = from + 1; r <= to; r++)
+            addBin(column, r, weight);
+    else
+        for (r = from - 1; r >= to; r--)
+            addBin(column, r, weight);
+}
+
+void densityMap::addBin(int column, int row, float weight)
+{
+    float *cell;
+
+    if ((column < 0) || (column >= nBins) || (row < 0) || (row >= nBins))
+        return;
+
+    cell = bin.data() + (row * nBins) + column;
+    *cell += weight;
+    if (*cell > maxBin)
+        maxBin = *cell;
+
+    if ((dirtyLast == -1) || (row < dirtyFirst))
+        dirtyFirst = row;
+    if (row > dirtyLast)
+        dirtyLast = row;
+}
+
+bool densityMap::getDirtyRows(int *first, int *last)
+{
+    if (dirtyLast == -1)
+        return false;
+
+    *first = dirtyFirst;
+    *last = dirtyLast;
+
+    dirtyFirst = 0;
+    dirtyLast = -1;
+
+    return true;
+}
@@ -0,0 +1,78 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :densitymap.h
+  @brief    :Header for the densityMap class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef DENSITYMAP_H
+#define DENSITYMAP_H
+
+#include <QVector>
+#include <QVector4D>
+
+#include <cmath>
+
+#define DENSITY_BINS        512  //bins along each axis of the histogram
+#define DENSITY_MIN_SCALE   1.0e-6f  //below this scale the bins are multiplied out before the weights lose precision
+
+//2-D histogram of points or traces over the normalized plot area (-1, 1), rows from the bottom
+//The decay is applied by scaling the weight of the next points instead of touching every bin => the cost of a batch depends only on its points:
+//the counts are bin * scale and a new point adds 1 / scale. The rows changed since the last upload are tracked.
+class densityMap
+{
+public:
+    densityMap(int bins);
+
+    void clear();
+    void decay(float factor);  //multiplies every count by factor (0 - 1)
+    void addPoints(const float *x, const float *y, int N, QVector4D mapping);  //mapping = conv_fact x, conv_fact y, Y axis, X axis as in XYLine.vsh
+    void addTrace(const float *y, int N, float x0, float dx, float convY, float offY);  //sample k at (x0 + k * dx, y * convY + offY), the samples are joined
+
+    int getBins() { return nBins; }
+    const float *getData() { return bin.constData(); }
+    float getScale() { return scale; }
+    float getMaxCount() { return maxBin * scale; }  //highest count of a single bin
+    bool getDirtyRows(int *first, int *last);  //rows changed since the last call, false if none
+    void invalidate() { dirtyFirst = 0; dirtyLast = nBins - 1; }  //the whole histogram has to be uploaded again
+
+private:
+    int nBins;
+    QVector<float> bin;
+    float scale;
+    float maxBin;
+    int dirtyFirst;
+    int dirtyLast;  //-1 if nothing changed
+
+    void renormalize();
+    void addBin(int column, int row, float weight);
+    void addColumn(int column, int from, int to, float weight);  //rows after from up to to, only to if they are the same
+};
+
+#endif // DENSITYMAP_H
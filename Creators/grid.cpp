@@ -73,6 +73,8 @@ Grid::Grid(appPreferencesStruct *pref, QString title, int width, int height, fon
 
     txtRnd = new textRenderer(title_fontname, fontMgr);
 
+    grid_revision = 0;
+    text_revision = 0;
     prepare_grid_data();
 }
 
@@ -83,40 +85,58 @@ Grid::~Grid()
 
 void Grid::recreate_Grid()
 {
+    //nothing is built again as long as the range, the layout and the preferences have not changed
+    if ((grid_dirty == false) && (preferences_changed() == false))
+        return;
+
     grid_data.clear();  //deletes the actual buffer
     prepare_grid_data();
 }
 
 void Grid::recreate_Grid(float max_Y, float min_Y)
 {
-    grid_data.clear();  //deletes the actual buffer
+    if (max_Y <= min_Y)
+        max_Y = min_Y + 100;  //by default
+
+    if ((max_Y != max_y) || (min_Y != min_y))
+        grid_dirty = true;
     max_y = max_Y;
     min_y = min_Y;
 
-    if (max_y <= min_y)
-        max_y = min_y + 100;  //by default
-
-    prepare_grid_data();
+    recreate_Grid();
 }
 
 void Grid::update_Text(int width, int height)
 {
+    if ((width != screen_width) || (height != screen_height))
+        text_dirty = true;
     screen_width = width;
     screen_height = height;
 
-    prepare_Text();
+    if (preferences_changed() == true)
+        prepare_grid_data();  //colors and sizes of the labels are taken from the preferences
+    else if (text_dirty == true)
+        prepare_Text();
 }
 
 void Grid::set_x_grid_ratio(int ratio)
 {
     if ((ratio >= 5) && (ratio <= 200))
+    {
+        if (ratio != xGridRatio)
+            grid_dirty = true;
         xGridRatio = ratio;
+    }
 }
 
 void Grid::set_y_grid_ratio(int ratio)
 {
     if ((ratio >= 5) && (ratio <= 200))
+    {
+        if (ratio != yGridRatio)
+            grid_dirty = true;
         yGridRatio = ratio;
+    }
 }
 
 void Grid::updateFont()
@@ -125,6 +145,7 @@ void Grid::updateFont()
 
     title_fontname = preferences->titleAxis_font;
     txtRnd = new textRenderer(title_fontname, fontMgr);
+    prepare_Text();  //the labels and the font texture have to come from the new renderer
 }
 
 void Grid::prepare_Axis()
@@ -272,6 +293,8 @@ void Grid::prepare_Text()
     }
 
     fontTexture = txtRnd->getTexture();
+    text_dirty = false;
+    text_revision++;
 }
 
 void Grid::add_in_buffer(float x, float y)
@@ -321,9 +344,23 @@ void Grid::prepare_grid_data()
     if (drawGrid == true)
         prepare_Grid();
     prepare_Axis();
+    grid_dirty = false;
+    grid_revision++;
     prepare_Text();
 }
 
+bool Grid::preferences_changed()
+{
+    if ((color_axis != preferences->axis_color) || (color_grid != preferences->grid_color) || (titleLabelColor != preferences->titleLabel_color))
+        return true;
+    if ((axis_width != preferences->axis_linewidth) || (grid_width != preferences->grid_linewidth) || (smooth_grid != preferences->smoothGrid))
+        return true;
+    if ((titleLabel_size != preferences->titleLabel_size) || (axisLabel_size != preferences->axisLabel_size))
+        return true;
+
+    return false;
+}
+
 float Grid::getMinYAxisGrid(int ratio)
 {
     double diff, diff_log;
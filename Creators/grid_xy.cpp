@@ -76,6 +76,8 @@ Grid_XY::Grid_XY(appPreferencesStruct *pref, QString title, int width, int heigh
 
     txtRnd = new textRenderer(title_fontname, fontMgr);
 
+    grid_revision = 0;
+    text_revision = 0;
     prepare_grid_data();
 }
 
@@ -86,45 +88,63 @@ Grid_XY::~Grid_XY()
 
 void Grid_XY::recreate_Grid()
 {
+    //nothing is built again as long as the range, the layout and the preferences have not changed
+    if ((grid_dirty == false) && (preferences_changed() == false))
+        return;
+
     grid_data.clear();  //deletes the actual buffer
     prepare_grid_data();
 }
 
 void Grid_XY::recreate_Grid(float max_X, float min_X, float max_Y, float min_Y)
 {
-    grid_data.clear();  //deletes the actual buffer
+    if (max_X <= min_X)
+        max_X = min_X + 100;  //by default
+
+    if (max_Y <= min_Y)
+        max_Y = min_Y + 100;  //by default
+
+    if ((max_X != max_x) || (min_X != min_x) || (max_Y != max_y) || (min_Y != min_y))
+        grid_dirty = true;
     max_x = max_X;
     min_x = min_X;
     max_y = max_Y;
     min_y = min_Y;
 
-    if (max_x <= min_x)
-        max_x = min_x + 100;  //by default
-
-    if (max_y <= min_y)
-        max_y = min_y + 100;  //by default
-
-    prepare_grid_data();
+    recreate_Grid();
 }
 
 void Grid_XY::update_Text(int width, int height)
 {
+    if ((width != screen_width) || (height != screen_height))
+        text_dirty = true;
     screen_width = width;
     screen_height = height;
 
-    prepare_Text();
+    if (preferences_changed() == true)
+        prepare_grid_data();  //colors and sizes of the labels are taken from the preferences
+    else if (text_dirty == true)
+        prepare_Text();
 }
 
 void Grid_XY::set_x_grid_ratio(int ratio)
 {
     if ((ratio >= 5) && (ratio <= 200))
+    {
+        if (ratio != xGridRatio)
+            grid_dirty = true;
         xGridRatio = ratio;
+    }
 }
 
 void Grid_XY::set_y_grid_ratio(int ratio)
 {
     if ((ratio >= 5) && (ratio <= 200))
+    {
+        if (ratio != yGridRatio)
+            grid_dirty = true;
         yGridRatio = ratio;
+    }
 }
 
 void Grid_XY::updateFont()
@@ -133,6 +153,7 @@ void Grid_XY::updateFont()
 
     title_fontname = preferences->titleAxis_font;
     txtRnd = new textRenderer(title_fontname, fontMgr);
+    prepare_Text();  //the labels and the font texture have to come from the new renderer
 }
 
 void Grid_XY::prepare_Axis()
@@ -278,6 +299,8 @@ void Grid_XY::prepare_Text()
     }
 
     fontTexture = txtRnd->getTexture();
+    text_dirty = false;
+    text_revision++;
 }
 
 void Grid_XY::add_in_buffer(float x, float y)
@@ -332,9 +355,23 @@ void Grid_XY::prepare_grid_data()
     if (drawGrid == true)
         prepare_Grid();
     prepare_Axis();
+    grid_dirty = false;
+    grid_revision++;
     prepare_Text();
 }
 
+bool Grid_XY::preferences_changed()
+{
+    if ((color_axis != preferences->axis_color) || (color_grid != preferences->grid_color) || (titleLabelColor != preferences->titleLabel_color))
+        return true;
+    if ((axis_width != preferences->axis_linewidth) || (grid_width != preferences->grid_linewidth) || (smooth_grid != preferences->smoothGrid))
+        return true;
+    if ((titleLabel_size != preferences->titleLabel_size) || (axisLabel_size != preferences->axisLabel_size))
+        return true;
+
+    return false;
+}
+
 float Grid_XY::getMinYAxisGrid(int ratio)
 {
     double diff, diff_log;
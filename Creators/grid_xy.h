@@ -43,6 +43,8 @@
 #include <QMatrix4x4>
 #include <QVector4D>
 
+#include <stdint.h>
+
 #include "Managers/prefmanager.h"
 #include "Creators/textrenderer.h"
 #include "FontManager/fontmanager.h"
@@ -59,15 +61,20 @@ public:
     QVector<GLfloat> *getTextData() { return &text_data; }
     int count() { return data_count; }
     int vertexCount() { return data_count / 2; }
-    void setTitle(QString title) { plotTitle = title; }
+    void setTitle(QString title) { if (title != plotTitle) text_dirty = true; plotTitle = title; }
 
-    void setTransformationMatrix(QMatrix4x4 mat) { transfMatrix = mat; }
+    void setTransformationMatrix(QMatrix4x4 mat) { if (mat != transfMatrix) text_dirty = true; transfMatrix = mat; }
 
-    void setDrawGrid(bool enable) { drawGrid = enable; }
+    void setDrawGrid(bool enable) { if (enable != drawGrid) grid_dirty = true; drawGrid = enable; }
     bool getDrawGrid() { return drawGrid; }
-    void setDrawTitle(bool enable) { drawTitle = enable; }
-    void setDrawYLabels(bool enable) { drawYLabels = enable; }
-    void setDrawXLabels(bool enable) { drawXLabels = enable; }
+    void setDrawTitle(bool enable) { if (enable != drawTitle) text_dirty = true; drawTitle = enable; }
+    void setDrawYLabels(bool enable) { if (enable != drawYLabels) text_dirty = true; drawYLabels = enable; }
+    void setDrawXLabels(bool enable) { if (enable != drawXLabels) text_dirty = true; drawXLabels = enable; }
+
+    //the revisions change every time the geometry or the labels are built again, the plots upload them to the GPU only then
+    uint64_t getGridRevision() { return grid_revision; }
+    uint64_t getTextRevision() { return text_revision; }
+    void invalidate() { grid_dirty = true; }
 
     void recreate_Grid(float max_X, float min_X, float max_Y, float min_Y);
     void recreate_Grid();
@@ -86,17 +93,17 @@ public:
     float get_grid_y() { return grid_y; }
     float get_grid_x() { return grid_x; }
 
-    void set_max_x(float max) { max_x = max; }
-    void set_min_x(float min) { min_x = min; }
-    void set_max_y(float max) { max_y = max; }
-    void set_min_y(float min) { min_y = min; }
-    void set_grid_x(float gridx) { grid_x = gridx; }
-    void set_grid_y(float gridy) { grid_y = gridy; }
+    void set_max_x(float max) { max_x = max; grid_dirty = true; }
+    void set_min_x(float min) { min_x = min; grid_dirty = true; }
+    void set_max_y(float max) { max_y = max; grid_dirty = true; }
+    void set_min_y(float min) { min_y = min; grid_dirty = true; }
+    void set_grid_x(float gridx) { grid_x = gridx; grid_dirty = true; }
+    void set_grid_y(float gridy) { grid_y = gridy; grid_dirty = true; }
     void set_axis_color(QColor color);
     void set_grid_color(QColor color);
     void set_axis_width(GLfloat width);
     void set_grid_width(GLfloat width);
-    void set_base_time(float time) { if (time > 0) base_time = time; }
+    void set_base_time(float time) { if (time > 0) { base_time = time; grid_dirty = true; } }
     void set_x_grid_ratio(int ratio);
     void set_y_grid_ratio(int ratio);
 
@@ -158,6 +165,11 @@ private:
 
     int screen_width, screen_height;
 
+    bool grid_dirty;  //the axis, the grid and the labels have to be built again
+    bool text_dirty;  //only the labels have to be built again
+    uint64_t grid_revision;
+    uint64_t text_revision;
+
     bool smooth_grid;
     bool smooth_axes;
 
@@ -169,6 +181,7 @@ private:
     GLfloat abs_GLfloat(GLfloat value);
 
     void prepare_grid_data();
+    bool preferences_changed();
 
     float getMinYAxisGrid(int ratio);
     float getMinXAxisGrid(int ratio);
@@ -38,6 +38,13 @@ legendCreator::legendCreator(QString fontName, fontManager *font)
     fontMgr = font;
     char_Size = 12;  //12 pixels by default
     line_space = 10;  //10 pixels by default
+    screen_Width = 1;
+    screen_Height = 1;
+
+    changed = true;
+    last_x = 0.0f;
+    last_y = 0.0f;
+    legend_revision = 1;  //the plots start from revision 0 => the first legend is always uploaded
 
     txtRnd = new textRenderer(fontName, fontMgr);
 
@@ -51,10 +58,30 @@ legendCreator::~legendCreator()
 
 void legendCreator::setScreenSize(int width, int height)
 {
-    if (width > 0)
+    if ((width > 0) && (width != screen_Width))
+    {
         screen_Width = width;
-    if (height > 0)
+        changed = true;
+    }
+    if ((height > 0) && (height != screen_Height))
+    {
         screen_Height = height;
+        changed = true;
+    }
+}
+
+void legendCreator::setSignals(QVector<SigProperty> properties)
+{
+    int i;
+
+    if (properties.count() != sig_properties.count())
+        changed = true;
+    else
+        for (i = 0; i < properties.count(); i++)
+            if ((properties[i].name != sig_properties[i].name) || (properties[i].color != sig_properties[i].color))
+                changed = true;
+
+    sig_properties = properties;
 }
 
 void legendCreator::createLegend(float x, float y)
@@ -62,11 +89,15 @@ void legendCreator::createLegend(float x, float y)
     int i, N;
     float penY;  //keeps track of the y location
     float width, height;
-    float start_x, end_x, length;
+    float start_x, length;
     float minX;
 
     //x and y are referring to the topright position. we then aling to the right
 
+    //the legend is written again only if a name, a color or the position changed
+    if ((changed == false) && (x == last_x) && (y == last_y))
+        return;
+
     //first we delete all the data
     legendData.clear();
     indexes.clear();
@@ -80,16 +111,13 @@ void legendCreator::createLegend(float x, float y)
     for (i = 0; i < N; i++)
     {
         indexes.append(penY);
-        end_x = txtRnd->prepareText(x, penY, sig_properties[i].name, sig_properties[i].color, char_Size, screen_Width, screen_Height, true);
-        length = end_x - x;
+        length = txtRnd->measureText(sig_properties[i].name, char_Size, screen_Width, screen_Height);
         start_x = x - length;
 
-        txtRnd->prepareText(start_x, penY, sig_properties[i].name, sig_properties[i].color, char_Size, screen_Width, screen_Height, true);
+        txtRnd->appendText(start_x, penY, sig_properties[i].name, sig_properties[i].color, char_Size, screen_Width, screen_Height, true, &legendData);
         if (start_x < minX)
             minX = start_x;
 
-        legendData.append(*txtRnd->getTextBuffer());  //we add the new data
-
         //now we update the penY position
         penY -= static_cast<float>( (char_Size + line_space)) / static_cast<float>(screen_Height) * 2.0f;
     }
@@ -106,6 +134,11 @@ void legendCreator::createLegend(float x, float y)
     btmRight.setY(static_cast<double>(penY - (height * 0.1f)));
 
     prepareBackgroundArea();
+
+    changed = false;
+    last_x = x;
+    last_y = y;
+    legend_revision++;
 }
 
 int legendCreator::verifyMousePosition(float x, float y)
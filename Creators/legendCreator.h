@@ -49,14 +49,15 @@ public:
     legendCreator(QString fontName, fontManager *font);
     ~legendCreator();
 
-    void setSignals(QVector<SigProperty> properties) { sig_properties = properties; }
-    void setCharSize(int size) { if (char_Size >= 1) char_Size = size; }
+    void setSignals(QVector<SigProperty> properties);
+    void setCharSize(int size) { if ((size >= 1) && (size != char_Size)) { char_Size = size; changed = true; } }
     void setScreenSize(int width, int height);
-    void setLineSpace(int space) { if (space >= 0) line_space = space; }
-    void setBackGroundColor(QColor color) { backGround = color; }
+    void setLineSpace(int space) { if ((space >= 0) && (space != line_space)) { line_space = space; changed = true; } }
+    void setBackGroundColor(QColor color) { if (color != backGround) { backGround = color; changed = true; } }
 
     void createLegend(float x, float y);  //creates the legend starting to write at x, y intended topLeft
     QVector<float> *getLegendData() { return &legendData; }
+    uint64_t getLegendRevision() { return legend_revision; }  //changes every time legendData is built again
     QVector<float> *getLegendAreaData() { return &legendAreaData; }
     QImage getLegendTexture() { return txtRnd->getTexture(); }
     int verifyMousePosition(float x, float y);  //verifies if the position belong to the legend and in case to which signal
@@ -83,6 +84,10 @@ private:
     QVector<float> legendData;  //it will contains all the strings
     QVector<float> legendAreaData;  //contains the vertexes for plotting the legend background area
 
+    bool changed;  //legendData has to be built again
+    float last_x, last_y;
+    uint64_t legend_revision;
+
     void prepareBackgroundArea(void);
 };
 
@@ -32,7 +32,6 @@
   */
 
 #include "statcreator.h"
-#include <QLocale>
 
 statCreator::statCreator(QString fontName, fontManager *font)
 {
@@ -40,6 +39,13 @@ statCreator::statCreator(QString fontName, fontManager *font)
 
     char_Size = 12;  //12 pixels by default
     line_space = 10;  //10 pixels by default
+    screen_Width = 1;
+    screen_Height = 1;
+
+    changed = true;
+    last_x = 0.0f;
+    last_y = 0.0f;
+    stat_revision = 1;  //the plots start from revision 0 => the first stats are always uploaded
 
     txtRnd = new textRenderer(fontName, fontMgr);
 }
@@ -51,18 +57,77 @@ statCreator::~statCreator()
 
 void statCreator::setScreenSize(int width, int height)
 {
-    if (width > 0)
+    if ((width > 0) && (width != screen_Width))
+    {
         screen_Width = width;
-    if (height > 0)
+        changed = true;
+    }
+    if ((height > 0) && (height != screen_Height))
+    {
         screen_Height = height;
+        changed = true;
+    }
+}
+
+void statCreator::setSignals(QVector<SigProperty> properties)
+{
+    int i;
+    bool all;
+
+    all = (properties.count() != sig_properties.count());
+    if (all == true)
+    {
+        statText.resize(properties.count());
+        changed = true;
+    }
+
+    for (i = 0; i < properties.count(); i++)
+    {
+        if ((all == true) || (sameStats(&properties[i].stats, &sig_properties[i].stats) == false))
+        {
+            statText[i] = formatStats(&properties[i].stats);
+            changed = true;
+        }
+        else if (properties[i].color != sig_properties[i].color)
+            changed = true;
+    }
+
+    sig_properties = properties;
+}
+
+bool statCreator::sameStats(const statisticInfo *a, const statisticInfo *b)
+{
+    if ((a->min != b->min) || (a->max != b->max) || (a->mean != b->mean))
+        return false;
+    if ((a->rms != b->rms) || (a->std != b->std) || (a->n_samples != b->n_samples))
+        return false;
+
+    return true;
+}
+
+QString statCreator::formatStats(const statisticInfo *stats)
+{
+    QString text;
+
+    text = "Min: " + locale.toString(stats->min, 'g', 3);
+    text += " Max: " + locale.toString(stats->max, 'g', 3);
+    text += " Avg: " + locale.toString(stats->mean, 'g', 3);
+    text += " RMS: " + locale.toString(stats->rms, 'g', 3);
+    text += " Std: " + locale.toString(stats->std, 'g', 3);
+    text += " Samples: " + locale.toString(static_cast<qlonglong>(stats->n_samples));
+
+    return text;
 }
 
 void statCreator::createStat(float x, float y)
 {
     int i, N;
     float penY;  //keeps track of the y location
-    QString text;
-    float start_x, end_x, length;
+    float length;
+
+    //the statistics are written again only if a string, a color or the position changed
+    if ((changed == false) && (x == last_x) && (y == last_y))
+        return;
 
     //first we delete all the data
     statData.clear();
@@ -70,26 +135,18 @@ void statCreator::createStat(float x, float y)
     penY = y;
     N = sig_properties.count();
 
-//    qDebug() << "Number of signals " << N;
-    QLocale locale;
-
     //we align to the right
     for (i = N - 1; i >= 0; i--)
     {
-        //We prepare the string first
-        text = "Min: " + locale.toString(sig_properties[i].stats.min, 'g', 3);
-        text += " Max: " + locale.toString(sig_properties[i].stats.max, 'g', 3);
-        text += " Avg: " + locale.toString(sig_properties[i].stats.mean, 'g', 3);
-        text += " Samples: " + locale.toString(static_cast<qlonglong>(sig_properties[i].stats.n_samples));
-
-        end_x = txtRnd->prepareText(x, penY, text, sig_properties[i].color, char_Size, screen_Width, screen_Height, false);
-        length = end_x - x;
-        start_x = x - length;
-        txtRnd->prepareText(start_x, penY, text, sig_properties[i].color, char_Size, screen_Width, screen_Height, false);
-
-        statData.append(*txtRnd->getTextBuffer());  //we add the new data
+        length = txtRnd->measureText(statText[i], char_Size, screen_Width, screen_Height);
+        txtRnd->appendText(x - length, penY, statText[i], sig_properties[i].color, char_Size, screen_Width, screen_Height, false, &statData);
 
         //now we update the penY position
         penY += static_cast<float>( (char_Size + line_space)) / static_cast<float>(screen_Height) * 2.0f;
     }
+
+    changed = false;
+    last_x = x;
+    last_y = y;
+    stat_revision++;
 }
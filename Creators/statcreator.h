@@ -37,6 +37,7 @@
 #include <QVector>
 #include <QString>
 #include <QColor>
+#include <QLocale>
 
 #include "textrenderer.h"
 #include "FontManager/fontmanager.h"
@@ -48,13 +49,14 @@ public:
     statCreator(QString fontName, fontManager *font);
     ~statCreator();
 
-    void setSignals(QVector<SigProperty> properties) { sig_properties = properties; }
-    void setCharSize(int size) { if (char_Size >= 1) char_Size = size; }
+    void setSignals(QVector<SigProperty> properties);  //the strings are formatted again only for the statistics that changed
+    void setCharSize(int size) { if ((size >= 1) && (size != char_Size)) { char_Size = size; changed = true; } }
     void setScreenSize(int width, int height);
-    void setLineSpace(int space) { if (space >= 0) line_space = space; }
+    void setLineSpace(int space) { if ((space >= 0) && (space != line_space)) { line_space = space; changed = true; } }
 
     void createStat(float x, float y);  //creates the legend starting to write at x, y intended bottomLeft
     QVector<float> *getStatData() { return &statData; }
+    uint64_t getStatRevision() { return stat_revision; }  //changes every time statData is built again
     QImage getStatTexture() { return txtRnd->getTexture(); }
 
 private:
@@ -71,6 +73,15 @@ private:
     QString font_filename;
 
     QVector<float> statData;  //it will contains all the generated strings
+
+    QVector<QString> statText;  //formatted statistics per signal
+    QLocale locale;
+    bool changed;  //statData has to be built again
+    float last_x, last_y;
+    uint64_t stat_revision;
+
+    bool sameStats(const statisticInfo *a, const statisticInfo *b);
+    QString formatStats(const statisticInfo *stats);
 };
 
 #endif // STATCREATOR_H
@@ -36,50 +36,155 @@
 
 textRenderer::textRenderer(QString fontName, fontManager *font)
 {
+    std::shared_ptr<const glyphAtlas> atlas;
+
     fontMgr = font;
 
-    fontMgr->getGlyph(fontName, &glyph, &metrics, &CellWidth, &CellHeight, &nColumns);
+    cacheWidth = 0;
+    cacheHeight = 0;
+    sdf = false;
+    padding = 0;
+
+    atlas = fontMgr->getAtlas(fontName);  //shared with all the other renderers using the same font
+    if (atlas != nullptr)
+    {
+        glyph = atlas->glyph;
+        metrics = atlas->metrics;
+        CellWidth = atlas->cellWidth;
+        CellHeight = atlas->cellHeight;
+        nColumns = atlas->nColumns;
+        sdf = atlas->sdf;
+        padding = atlas->padding;
+    }
 }
 
 float textRenderer::prepareText(float x, float y, QString text, QColor color, int pixel, int width, int height, bool topLeft)
 {
-    //The textBuffer is prepared in the following way
-    // X Y ImgX ImgY R G B A
+    textBuffer.clear();
+
+    return appendText(x, y, text, color, pixel, width, height, topLeft, &textBuffer);
+}
 
+float textRenderer::appendText(float x, float y, QString text, QColor color, int pixels, int width, int height, bool topLeft, QVector<float> *out)
+{
     //The arguments x and y represent the coordinates of the top-left corner if topLeft is true
-    //The argument scale is needed to change dimension of the writing
-    int i;
-    float penX;  //gives the starting x point for writing. y is fixed
-    double r, g, b, a;
-    int glyphWidth, glyphHeight;
+    //the cached layout is only moved to x, y
+    int i, start, N;
+    const textLayout *layout;
+    const float *src;
+    float *dst;
+
+    layout = getLayout(text, color, pixels, width, height, topLeft);
+
+    N = layout->vertices.count();
+    start = out->count();
+    out->resize(start + N);
 
-    //pixel indicates the height of the capital letter A in pixels
+    src = layout->vertices.constData();
+    dst = out->data() + start;
+    for (i = 0; i < N; i += 8)
+    {
+        dst[i] = src[i] + x;
+        dst[i + 1] = src[i + 1] + y;
+        dst[i + 2] = src[i + 2];
+        dst[i + 3] = src[i + 3];
+        dst[i + 4] = src[i + 4];
+        dst[i + 5] = src[i + 5];
+        dst[i + 6] = src[i + 6];
+        dst[i + 7] = src[i + 7];
+    }
+
+    return x + layout->advance;  //return the position of the end of the line
+}
+
+float textRenderer::measureText(QString text, int pixels, int width, int height)
+{
+    int i;
     float scaleX, scaleY;
+    float penX;
+    QHash<QPair<QString, int>, float>::const_iterator cached;
+
+    //the advance of a string already laid out with the same size is reused
+    cached = advanceCache.constFind(qMakePair(text, pixels));
+    if ((width == cacheWidth) && (height == cacheHeight) && (cached != advanceCache.constEnd()))
+        return cached.value();
+
+    getScale(pixels, width, height, &scaleX, &scaleY);
+
+    penX = 0.0f;
+    for (i = 0; i < text.length(); i++)
+    {
+        unsigned char c = static_cast<unsigned char>(text.at(i).toLatin1()) - 32;  //the first 32 characters are ignored in the glyph
+        penX += metrics[c].AdvanceX / 64 * scaleX;
+    }
+
+    return penX;
+}
+
+void textRenderer::getScale(int pixels, int width, int height, float *scaleX, float *scaleY)
+{
+    //pixels indicates the height of the capital letter A in pixels
     int char_A_width, char_A_height;
     float pixelX;  //while pixel gives the number of pixel in height referred to character H, here we determine given the aspect ratio of A the pixel in the X direction
 
-    char_A_width = metrics[static_cast<unsigned char>(QChar('A').toLatin1()) - 32].Width;
-    char_A_height = metrics[static_cast<unsigned char>(QChar('A').toLatin1()) - 32].Rows;
+    char_A_width = metrics[static_cast<unsigned char>(QChar('A').toLatin1()) - 32].Width - (2 * padding);
+    char_A_height = metrics[static_cast<unsigned char>(QChar('A').toLatin1()) - 32].Rows - (2 * padding);
+
+    pixelX = static_cast<float>(pixels) * static_cast<float>(char_A_width) / static_cast<float>(char_A_height);
+    *scaleY = static_cast<float>(pixels) / static_cast<float>(char_A_height) * 2.0f / static_cast<float>(height);
+    *scaleX = pixelX / static_cast<float>(char_A_width) * 2.0f / static_cast<float>(width);
+}
+
+const textLayout *textRenderer::getLayout(QString text, QColor color, int pixels, int width, int height, bool topLeft)
+{
+    //The vertices are prepared in the following way
+    // X Y ImgX ImgY R G B A
+    int i;
+    float penX, penY;  //gives the starting point for writing
+    double r, g, b, a;
+    int glyphWidth, glyphHeight;
+    float scaleX, scaleY;
+    float *v;
+    textLayoutKey key;
+    textLayout *layout;
+    QHash<textLayoutKey, textLayout>::iterator cached;
+
+    //the layouts depend on the screen size
+    if ((width != cacheWidth) || (height != cacheHeight) || (layoutCache.count() >= TEXT_CACHE_MAX_ENTRIES))
+    {
+        layoutCache.clear();
+        advanceCache.clear();
+        cacheWidth = width;
+        cacheHeight = height;
+    }
+
+    key.text = text;
+    key.color = color.rgba();
+    key.pixels = pixels;
+    key.topLeft = topLeft;
+    cached = layoutCache.find(key);
+    if (cached != layoutCache.end())
+        return &cached.value();  //the string has already been written in the same way
+
+    layout = &layoutCache[key];
 
-    pixelX = static_cast<float>(pixel) * static_cast<float>(char_A_width) / static_cast<float>(char_A_height);
-    scaleY = static_cast<float>(pixel) / static_cast<float>(char_A_height) * 2.0f / static_cast<float>(height);
-    scaleX = pixelX / static_cast<float>(char_A_width) * 2.0f / static_cast<float>(width);
+    getScale(pixels, width, height, &scaleX, &scaleY);
 
     //we bring y now to indicate the bottomLeft corner by subtracting the height of the capital letter A
+    penX = 0.0f;
+    penY = 0.0f;
     if (topLeft == true)
-        y -= static_cast<float>(char_A_height) * scaleY;
+        penY -= static_cast<float>(metrics[static_cast<unsigned char>(QChar('A').toLatin1()) - 32].Rows - (2 * padding)) * scaleY;
 
-    //the rest is to be implemented
-    penX = x;
     color.getRgbF(&r, &g, &b, &a);
     glyphWidth = glyph.width();
     glyphHeight = glyph.height();
 
-    textBuffer.clear();
+    layout->vertices.resize(text.length() * 48);
+    v = layout->vertices.data();
 
     for (i = 0; i < text.length(); i++)
     {
-        //here we create the textBuffer
         //first we locate the character
         unsigned char c = static_cast<unsigned char>(text.at(i).toLatin1()) - 32;  //the first 32 characters are ignored in the glyph
         float x_c_pos, y_c_pos;
@@ -87,6 +192,8 @@ float textRenderer::prepareText(float x, float y, QString text, QColor color, in
         float y0, y1;
         float x0, x1;
         float char_width, char_height;
+        float corner[6][4];  //X Y ImgX ImgY of the two triangles
+        int k;
 
         x_c_i = (c % nColumns) * CellWidth;
         y_c_i = glyph.height() - (c / nColumns * CellHeight) - CellHeight;  //the second cellheight is because of the different axis direction of the y-axis
@@ -96,33 +203,31 @@ float textRenderer::prepareText(float x, float y, QString text, QColor color, in
         //We define now the x,y position of the rectangle
         x0 = penX + (static_cast<float>(metrics[c].Left) * scaleX);
         x1 = x0 + (static_cast<float>(metrics[c].Width * scaleX));
-        y0 = y - (static_cast<float>(metrics[c].Rows - metrics[c].Top) * scaleY);
+        y0 = penY - (static_cast<float>(metrics[c].Rows - metrics[c].Top) * scaleY);
         y1 = y0 + (static_cast<float>(metrics[c].Rows) * scaleY);
 
-        //Prepares the data to be inserted in textBuffer
         char_width = static_cast<float>(metrics[c].Width) / static_cast<float>(glyphWidth);
         char_height = static_cast<float>(metrics[c].Rows) / static_cast<float>(glyphHeight);
 
-        textBuffer.append(x0); textBuffer.append(y0); textBuffer.append(x_c_pos); textBuffer.append(y_c_pos); textBuffer.append(static_cast<float>(r));
-        textBuffer.append(static_cast<float>(g)); textBuffer.append(static_cast<float>(b)); textBuffer.append(static_cast<float>(a));
-
-        textBuffer.append(x0); textBuffer.append(y1); textBuffer.append(x_c_pos); textBuffer.append(y_c_pos + char_height); textBuffer.append(static_cast<float>(r));
-        textBuffer.append(static_cast<float>(g)); textBuffer.append(static_cast<float>(b)); textBuffer.append(static_cast<float>(a));
-
-        textBuffer.append(x1); textBuffer.append(y1); textBuffer.append(x_c_pos + char_width); textBuffer.append(y_c_pos + char_height);
-        textBuffer.append(static_cast<float>(r)); textBuffer.append(static_cast<float>(g)); textBuffer.append(static_cast<float>(b)); textBuffer.append(static_cast<float>(a));
+        corner[0][0] = x0; corner[0][1] = y0; corner[0][2] = x_c_pos; corner[0][3] = y_c_pos;
+        corner[1][0] = x0; corner[1][1] = y1; corner[1][2] = x_c_pos; corner[1][3] = y_c_pos + char_height;
+        corner[2][0] = x1; corner[2][1] = y1; corner[2][2] = x_c_pos + char_width; corner[2][3] = y_c_pos + char_height;
+        corner[3][0] = x1; corner[3][1] = y1; corner[3][2] = x_c_pos + char_width; corner[3][3] = y_c_pos + char_height;
+        corner[4][0] = x0; corner[4][1] = y0; corner[4][2] = x_c_pos; corner[4][3] = y_c_pos;
+        corner[5][0] = x1; corner[5][1] = y0; corner[5][2] = x_c_pos + char_width; corner[5][3] = y_c_pos;
 
-        textBuffer.append(x1); textBuffer.append(y1); textBuffer.append(x_c_pos + char_width); textBuffer.append(y_c_pos + char_height);
-        textBuffer.append(static_cast<float>(r)); textBuffer.append(static_cast<float>(g)); textBuffer.append(static_cast<float>(b)); textBuffer.append(static_cast<float>(a));
-
-        textBuffer.append(x0); textBuffer.append(y0); textBuffer.append(x_c_pos); textBuffer.append(y_c_pos); textBuffer.append(static_cast<float>(r));
-        textBuffer.append(static_cast<float>(g)); textBuffer.append(static_cast<float>(b)); textBuffer.append(static_cast<float>(a));
-
-        textBuffer.append(x1); textBuffer.append(y0); textBuffer.append(x_c_pos + char_width); textBuffer.append(y_c_pos); textBuffer.append(static_cast<float>(r));
-        textBuffer.append(static_cast<float>(g)); textBuffer.append(static_cast<float>(b)); textBuffer.append(static_cast<float>(a));
+        for (k = 0; k < 6; k++)
+        {
+            v[0] = corner[k][0]; v[1] = corner[k][1]; v[2] = corner[k][2]; v[3] = corner[k][3];
+            v[4] = static_cast<float>(r); v[5] = static_cast<float>(g); v[6] = static_cast<float>(b); v[7] = static_cast<float>(a);
+            v += 8;
+        }
 
         penX += metrics[c].AdvanceX / 64 * scaleX;
     }
 
-    return penX;  //return the position of the end of the line
+    layout->advance = penX;
+    advanceCache.insert(qMakePair(text, pixels), penX);
+
+    return layout;
 }
@@ -36,12 +36,41 @@
 
 #include <QString>
 #include <QImage>
+#include <QColor>
 #include <QVector>
+#include <QHash>
+#include <QPair>
 #include <QChar>
 #include <QDebug>
 
 #include "FontManager/fontmanager.h"
 
+#define TEXT_CACHE_MAX_ENTRIES  512  //once exceeded the layouts are all dropped, the strings in use are laid out again at the next frame
+
+typedef struct _textLayoutKey
+{
+    QString text;
+    QRgb color;
+    int pixels;
+    bool topLeft;
+} textLayoutKey;
+
+inline bool operator==(const textLayoutKey &a, const textLayoutKey &b)
+{
+    return (a.text == b.text) && (a.color == b.color) && (a.pixels == b.pixels) && (a.topLeft == b.topLeft);
+}
+
+inline uint qHash(const textLayoutKey &key, uint seed = 0)
+{
+    return qHash(key.text, seed) ^ qHash(key.color, seed) ^ qHash(key.pixels, seed + 1) ^ static_cast<uint>(key.topLeft);
+}
+
+typedef struct _textLayout
+{
+    QVector<float> vertices;  //6 vertices per glyph (X Y ImgX ImgY R G B A), the pen starts at 0, 0
+    float advance;  //x position of the pen at the end of the line
+} textLayout;
+
 class textRenderer
 {
 public:
@@ -49,21 +78,35 @@ public:
     QImage getTexture() { return glyph; }  //this is the texture that will be loaded in OpenGL
 
     float prepareText(float x, float y, QString text, QColor color, int pixels, int width, int height, bool topLeft);  //prepares the textBuffer
+    float appendText(float x, float y, QString text, QColor color, int pixels, int width, int height, bool topLeft, QVector<float> *out);  //adds the text to out, returns the end of the line
+    float measureText(QString text, int pixels, int width, int height);  //length of the line, no vertex is generated
 
     QVector<float> *getTextBuffer() { return &textBuffer; }
+    bool isSDF() { return sdf; }  //the texture is a distance field, to be drawn with TextureSDF.fsh
 
 private:
     fontManager *fontMgr;
 
     QImage glyph;  //here the glyph is stored
     QVector<Character> metrics;
+    bool sdf;
+    int padding;  //pixels around each glyph of a distance field, not part of the character
 
     QVector<float> textBuffer;
 
+    //layouts of the strings already written, valid for the screen size they have been computed for
+    //the advance does not depend on the color and on the alignment, so it is kept also by string and size for measureText
+    QHash<textLayoutKey, textLayout> layoutCache;
+    QHash<QPair<QString, int>, float> advanceCache;
+    int cacheWidth;
+    int cacheHeight;
+
     int nColumns;
     int CellWidth;
     int CellHeight;
 
+    void getScale(int pixels, int width, int height, float *scaleX, float *scaleY);
+    const textLayout *getLayout(QString text, QColor color, int pixels, int width, int height, bool topLeft);
 };
 
 #endif // TEXTRENDERER_H
@@ -39,6 +39,12 @@ toolTipCreator::toolTipCreator(QString fontname, fontManager *font)
 
     char_Size = 12;  //12 pixels by default
     line_space = 10;  //10 pixels by default
+    screen_Width = 1;
+    screen_Height = 1;
+
+    last_x = 0.0f;
+    last_y = 0.0f;
+    toolTip_revision = 1;  //the plots start from revision 0 => the first tooltip is always uploaded
 
     txtRnd = new textRenderer(fontname, fontMgr);
 }
@@ -59,26 +65,33 @@ void toolTipCreator::setScreenSize(int width, int height)
 void toolTipCreator::createToolTip(float x, float y, QColor color)
 {
     float penY;  //keeps track of the y location
-    QString text1, text2;
-    QLocale locale;
-
-    //first we delete all the data
-    toolTipData.clear();
+    QString text1, text2, key;
 
     //Adds a little offset not to have collision with the indicator
     x = x + 0.01f;
     y = y + 0.01f;
 
-    penY = y;
-
     text1 = "Y: " + locale.toString(y_value, 'g', 3);
     text2 = "X: " + locale.toString(x_value, 'g', 3);
 
-    txtRnd->prepareText(x, penY, text1, color, char_Size, screen_Width, screen_Height, true);
-    toolTipData.append(*txtRnd->getTextBuffer());
+    //the size of the screen and of the characters is part of the key, since they change the vertices
+    key = text1 + "\n" + text2 + "\n" + color.name(QColor::HexArgb) + "\n" + QString::number(char_Size) + " " + QString::number(line_space) + " " + QString::number(screen_Width) + " " + QString::number(screen_Height);
+    if ((key == last_text) && (x == last_x) && (y == last_y))
+        return;
+
+    //first we delete all the data
+    toolTipData.clear();
+
+    penY = y;
+
+    txtRnd->appendText(x, penY, text1, color, char_Size, screen_Width, screen_Height, true, &toolTipData);
     penY -= static_cast<float>( (char_Size + line_space)) / static_cast<float>(screen_Height) * 2.0f;
-    txtRnd->prepareText(x, penY, text2, color, char_Size, screen_Width, screen_Height, true);
-    toolTipData.append(*txtRnd->getTextBuffer());
+    txtRnd->appendText(x, penY, text2, color, char_Size, screen_Width, screen_Height, true, &toolTipData);
+
+    last_text = key;
+    last_x = x;
+    last_y = y;
+    toolTip_revision++;
 }
 
 
@@ -48,13 +48,14 @@ public:
     toolTipCreator(QString fontname, fontManager *font);
     ~toolTipCreator();
 
-    void setCharSize(int size) { if (char_Size >= 1) char_Size = size; }
+    void setCharSize(int size) { if (size >= 1) char_Size = size; }
     void setValues(float x, float y) { x_value = x; y_value = y; }
     void setScreenSize(int width, int height);
     void setLineSpace(int space) { if (space >= 0) line_space = space; }
 
     void createToolTip(float x, float y, QColor color);  //creates the legend starting to write at x, y intended topLeft
     QVector<float> *getToolTipData() { return &toolTipData; }
+    uint64_t getToolTipRevision() { return toolTip_revision; }  //changes every time toolTipData is built again
     QImage getToolTipTexture() { return txtRnd->getTexture(); }
 
 private:
@@ -72,6 +73,11 @@ private:
     QString font_filename;
 
     QVector<float> toolTipData;
+
+    QLocale locale;
+    QString last_text;  //both the lines, the tooltip is written again only if they or its position changed
+    float last_x, last_y;
+    uint64_t toolTip_revision;
 };
 
 #endif // TOOLTIPCREATOR_H
@@ -33,6 +33,7 @@
 
 #include "fft_plot_window.h"
 #include "glwindow.h"
+#include "Managers/floatkernels.h"
 
 fft_plot_Window::fft_plot_Window(QString title, int index, double frequency, int NPoints, appPreferencesStruct *pref, fontManager *font)
 {
@@ -40,6 +41,7 @@ fft_plot_Window::fft_plot_Window(QString title, int index, double frequency, int
 
     Autoscale = false;
     StatsEnabled = true;
+    preparePending = false;
 
     preferences = pref;
     fontMgr = font;
@@ -190,35 +192,25 @@ void fft_plot_Window::thread_prepare_signal(int i, QVector<int> points, QVector<
     float** buff_ptr = static_cast<float**>(pointers[0]);
     float* line_widths = static_cast<float*>(pointers[2]);
 
+    statSummary st;
+#ifndef USE_VERTEX_ID
     int k;
+#endif
 
     sig_properties[i].line_width = line_widths[i];
 
-    //calculates statistics
-    try   //insert to catch out of buffer accesses and/or divisions by zero
-    {
-        if (StatsEnabled == true)
-        {
-            sig_properties[i].stats.n_samples = 0;
-            sig_properties[i].stats.mean = 0;
-
-            if (StatsEnabled == true)  //we can calculate statistics
-            {
-                for (k = start; k <= end; k++)
-                {
-                    if (buff_ptr[i][k] > sig_properties[i].stats.max)
-                        sig_properties[i].stats.max = buff_ptr[i][k];
-                    if (buff_ptr[i][k] < sig_properties[i].stats.min)
-                        sig_properties[i].stats.min = buff_ptr[i][k];
-                    sig_properties[i].stats.n_samples += 1;
-                    if (sig_properties[i].stats.n_samples != 0)
-                        sig_properties[i].stats.mean += ((buff_ptr[i][k] - sig_properties[i].stats.mean) / static_cast<float>(sig_properties[i].stats.n_samples));  //updates average
-                }
-            }
-        }
-    } catch (...)
+    //calculates statistics, min and max are held until the statistics are reset
+    if ((StatsEnabled == true) && (end >= start))
     {
-
+        st = runningStats::summarize(buff_ptr[i] + start, static_cast<uint32_t>(end - start + 1));
+        if (st.max > sig_properties[i].stats.max)
+            sig_properties[i].stats.max = st.max;
+        if (st.min < sig_properties[i].stats.min)
+            sig_properties[i].stats.min = st.min;
+        sig_properties[i].stats.mean = static_cast<float>(st.mean);
+        sig_properties[i].stats.rms = static_cast<float>(runningStats::getRMS(&st));
+        sig_properties[i].stats.std = static_cast<float>(runningStats::getStd(&st));
+        sig_properties[i].stats.n_samples = static_cast<long>(st.n);
     }
 
 #ifdef USE_VERTEX_ID
@@ -241,50 +233,17 @@ void fft_plot_Window::thread_prepare_signal(int i, QVector<int> points, QVector<
 
 void fft_plot_Window::find_min_max_signals(int n_signals, int start, int end, float **buff_ptr, float *Min, float *Max)
 {
-    float min, max;
-    int i, j;
-    bool found;
-
-    min = 0;
-    max = 1;
-    found = false;
-    //we initialize min and max to the first valid value of the first signal
-    for (i = 0; i < n_signals; i++)
-        for (j = start; j <= end; j++)
-        {
-            if ((std::isnan(buff_ptr[i][j]) == false) && (std::isinf(buff_ptr[i][j]) == false))
-            {
-                found = true;
-                min = buff_ptr[i][j];
-                max = min;
-            }
-        }
-
-    if (found == true)
+    //min and max of the finite samples of all the signals, 0 - 1 if there are none
+    if (floatKernels::rangeOfSignals(n_signals, start, end, buff_ptr, Min, Max) == false)
     {
-        for (i = 0; i < n_signals; i++)
-            for (j = start; j <= end; j++)
-            {
-                if ((std::isnan(buff_ptr[i][j]) == false) && (std::isinf(buff_ptr[i][j]) == false))
-                {
-                    if (buff_ptr[i][j] < min)
-                        min = buff_ptr[i][j];
-                    if (buff_ptr[i][j] > max)
-                        max = buff_ptr[i][j];
-                }
-            }
-    }
-    else {
-        min = 0;
-        max = 1;
+        *Min = 0;
+        *Max = 1;
     }
-
-    *Min = static_cast<float>(min);
-    *Max = static_cast<float>(max);
 }
 
 fft_plot_Window::~fft_plot_Window()
 {
+    prepareTasks.wait();  //the tasks of a preparation not completed use the buffers of the window
     delete glPlot;
 }
 
@@ -302,6 +261,8 @@ void fft_plot_Window::addSignal(uint32_t index, QString name, QColor color)
     p.stats.min = 0.0;
     p.stats.n_samples = 0;
     p.stats.mean = 0.0;
+    p.stats.rms = 0.0;
+    p.stats.std = 0.0;
     p.triggerAct = new QAction(this);
     p.triggerAct->setText(p.name);
     p.triggerAct->setCheckable(true);
@@ -354,11 +315,13 @@ int fft_plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, f
     int i; int n_p;
     float step_x;
     float x_axis;
-    bool finished;
     float min, max;  //used for autoscale
     int start, end;
     float distance;
 
+    if (preparePending == true)  //the tasks of the previous preparation still use the buffers
+        complete_Signal_Data();
+
     if (n_signals != sig_properties.count())  //we have a mismatch between the number of signals passed and the number of signals declared in the plot => do not plot anything
         return -1;
 
@@ -367,6 +330,17 @@ int fft_plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, f
     if (n_points < 2)
         return -1;
 
+    //the pointers are copied since the tasks use them after this function has returned
+    prepare_buff.resize(n_signals);
+    prepare_widths.resize(n_signals);
+    for (i = 0; i < n_signals; i++)
+    {
+        prepare_buff[i] = buff_ptr[i];
+        prepare_widths[i] = line_widths[i];
+    }
+    buff_ptr = prepare_buff.data();
+    line_widths = prepare_widths.data();
+
     //we prepare the buffer by using resize (faster than using append)
     if (n_points <= glPlot->get_Grid()->get_N_points()) //n_points tells us how many points are contained in the signal buffers
     {
@@ -413,10 +387,6 @@ int fft_plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, f
     indexes.clear();
     indexes.resize(n_signals);  //indexes to the locations of each signal in the buffer
 
-    QVector<QFuture<void>> res;
-
-    res.resize(n_signals);
-
     for (i = 0; i < n_signals; i++)
         indexes[i] = i * (end - start + 1);
 
@@ -432,22 +402,26 @@ int fft_plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, f
     pointers.push_back(static_cast<void*>(buff_ptr));
     pointers.push_back(static_cast<void*>(colors)); pointers.push_back(static_cast<void*>(line_widths));
 
-    //I load the data in the right format from buff_ptr
-    for (i = 0; i < n_signals; i++)  //Launches the parallel threads
-    {
-        res[i] = QtConcurrent::run(this, &fft_plot_Window::thread_prepare_signal, i, points, floats, pointers);
-    }
+    //I load the data in the right format from buff_ptr, the signals of this and of the other windows are prepared by the worker pool together
+    workerPool::parallelFor(&prepareTasks, n_signals, n_p, std::bind(&fft_plot_Window::thread_prepare_signal, this, std::placeholders::_1, points, floats, pointers));
 
-    //waits for threads to finish
-    finished = false;
-    while (finished == false)
-    {
-        finished = true;
-        for (i = 0; i < n_signals; i++)
-            finished = finished && res[i].isFinished();
-    }
+    preparePending = true;
+    prepare_n_signals = n_signals;
+    prepare_n_p = n_p;
+
+    return 0;
+}
+
+int fft_plot_Window::complete_Signal_Data()
+{
+    if (preparePending == false)
+        return -1;
+
+    //blocks till the signals are prepared, this thread executes the queued tasks meanwhile
+    prepareTasks.wait();
+    preparePending = false;
 
-    glPlot->parallel_prepare_Signal_Buffer(n_signals, n_p, &signal_buffer, sig_properties, indexes);
+    glPlot->parallel_prepare_Signal_Buffer(prepare_n_signals, prepare_n_p, &signal_buffer, sig_properties, indexes);
 
     return 0;
 }
@@ -632,6 +606,8 @@ void fft_plot_Window::triggerResetStats()
         sig_properties[i].stats.mean = 0.0;
         sig_properties[i].stats.min = 0.0;
         sig_properties[i].stats.max = 0.0;
+        sig_properties[i].stats.rms = 0.0;
+        sig_properties[i].stats.std = 0.0;
     }
 }
 
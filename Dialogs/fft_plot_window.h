@@ -62,13 +62,13 @@
 #include <QKeyEvent>
 #include <QDockWidget>
 #include <QStatusBar>
-#include <QFuture>
-#include <QtConcurrent/QtConcurrent>
 
 #include "definitions.h"
 #include "Creators/statcreator.h"
 #include "FontManager/fontmanager.h"
 #include "Managers/prefmanager.h"
+#include "Managers/runningstats.h"
+#include "Managers/workerpool.h"
 #include "Dialogs/glwindow.h"
 #include "Creators/legendCreator.h"
 
@@ -91,6 +91,8 @@ public:
     void setStepFrequency(float step) { stepFrequency = step; }
 
     int parallel_prepare_Signal_Data(int n_signals, int n_points, float** buff_ptr, QColor* colors, float *line_widths, QString* names);  //points to n_signals buffers and indicates how many points to be prepared
+    int complete_Signal_Data(void);  //waits for the preparation running on the worker pool and sends the buffers to the GPU, -1 if none has been started
+    qint64 getStagingMemory() { return static_cast<qint64>(signal_buffer.capacity()) * static_cast<qint64>(sizeof(GLfloat)); }  //bytes allocated for the buffer sent to the GPU
 
     void update(void);
     void updateFonts() { glPlot->updateFonts(); }
@@ -197,6 +199,11 @@ private:
     QVector<int> indexes;  //all the signals are contained into one single buffer. in this vector we store the location at which each signal starts
     QVector<GLfloat> signal_buffer;  //contains the buffer of the signals to be displayed => a multiple of N_signals and N_points
     int signal_buffer_count;
+    taskGroup prepareTasks;  //tasks preparing the signals
+    bool preparePending;
+    int prepare_n_signals, prepare_n_p;
+    QVector<float*> prepare_buff;  //copies of the arguments, used by the tasks after parallel_prepare_Signal_Data has returned
+    QVector<float> prepare_widths;
     void thread_prepare_signal(int i, QVector<int> points, QVector<float> floats, QVector<void*> pointers);
     void find_min_max_signals(int n_signals, int start, int end, float** buff_ptr, float* Min, float *Max);
 };
@@ -40,6 +40,12 @@
 
 #include <math.h>
 
+#ifdef USE_VERTEX_ID
+int GLWindow::probedLineRenderer = LINE_RENDERER_AUTO;
+int GLWindow::probeFrames[2] = {0, 0};
+double GLWindow::probeBest[2] = {0.0, 0.0};
+#endif
+
 GLWindow::GLWindow(QWidget *parent, QString title, appPreferencesStruct *pref, fontManager *font) : QOpenGLWidget(parent)
 {
     this->setMinimumSize(pref->plot_width_size, pref->plot_height_size);
@@ -52,7 +58,38 @@ GLWindow::GLWindow(QWidget *parent, QString title, appPreferencesStruct *pref, f
     plotTitle = title;
 
     N_signals = 0;
+    gridRevision = 0;
+    gridTextRevision = 0;
+
+    m_program = nullptr;  //the resources are created in initializeGL
+    gridTex = nullptr;
+    legendTex = nullptr;
+    statTex = nullptr;
+    toolTipTex = nullptr;
+
     Number_of_Points = 0;
+    x_step = 0.0f;
+
+    thumbs = new thumbnailGrabber(this);  //deleted with the window
+
+    persistence = nullptr;
+    persistenceTex = 0;
+
+#ifdef USE_VERTEX_ID
+    ring_mode = false;
+    ring_capacity = 0;
+    ring_signals = 0;
+    gl32 = nullptr;
+    m_quad_program = nullptr;
+    signalTbo = 0;
+    maxTboTexels = 0;
+    lineRenderer = LINE_RENDERER_AUTO;
+    lineJoin = LINE_JOIN_MITER;
+    sigStyleTex = 0;
+    sigStyleRows = 0;
+    signal_stride = 0;
+    equal_spacing = true;
+#endif
 
     pastValueGain = 1.0f;
 
@@ -130,6 +167,8 @@ void GLWindow::setGridTimeBase(double TimeBase)
 
 void GLWindow::initializeGL()
 {
+    GLfloat quad[8] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};  //plot area covered by the persistence map
+
     makeCurrent();
     QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
 
@@ -145,24 +184,18 @@ void GLWindow::initializeGL()
 
 #ifdef USE_VERTEX_ID
     //VertexID based Program Declaration
-    m_ver_program = new QOpenGLShaderProgram;
-    if (m_ver_program->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/LineVertexID.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_ver_program->addShaderFromSourceFile(QOpenGLShader::Geometry, ":/shaders/Shaders/LineVertexID.gsh") == false)
-        qDebug("Error compiling Geometry Shader");
-    if (m_ver_program->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/LineVertexID.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_ver_program->link() == false)
-        qDebug("Shaders were not linked correctly");
+    m_ver_program = glResourceManager::getProgram(":/shaders/Shaders/LineVertexID.vsh", ":/shaders/Shaders/LineVertexID.gsh", ":/shaders/Shaders/LineVertexID.fsh");
     if (m_ver_program->bind() == false)
         qDebug("Shaders not correctly bound");
 
-    m_in_ver_colorLoc = m_ver_program->uniformLocation("in_color");
     m_in_ver_paramsLoc = m_ver_program->uniformLocation("in_params");
     m_ver_transfMatrixLoc = m_ver_program->uniformLocation("transfMatrix");
     m_ver_screenSizeLoc = m_ver_program->uniformLocation("screen_size");
     m_n_points = m_ver_program->uniformLocation("n_points");
-    m_instance = m_ver_program->uniformLocation("instance");
+    m_first_vertex = m_ver_program->uniformLocation("first_vertex");
+    m_stride = m_ver_program->uniformLocation("stride");
+    m_capacity = m_ver_program->uniformLocation("capacity");
+    m_sig_style = m_ver_program->uniformLocation("sig_style");
     m_pastvaluegainLoc = m_ver_program->uniformLocation("pastValueGain");
 
     m_ver_vao = new QOpenGLVertexArrayObject;
@@ -176,19 +209,42 @@ void GLWindow::initializeGL()
 
     m_ver_vao->release();
     m_ver_program->release();
+
+    gl32 = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_2_Core>();
+    if (gl32 != nullptr)
+        gl32->initializeOpenGLFunctions();
+    else
+        qDebug("OpenGL 3.2 functions not available, the signals are drawn one by one");
+
+    m_quad_program = glResourceManager::getProgram(":/shaders/Shaders/LineQuad.vsh", "", ":/shaders/Shaders/LineQuad.fsh");
+    m_quad_samples = m_quad_program->uniformLocation("samples");
+    m_quad_sig_style = m_quad_program->uniformLocation("sig_style");
+    m_quad_paramsLoc = m_quad_program->uniformLocation("in_params");
+    m_quad_transfMatrixLoc = m_quad_program->uniformLocation("transfMatrix");
+    m_quad_screenSizeLoc = m_quad_program->uniformLocation("screen_size");
+    m_quad_n_points = m_quad_program->uniformLocation("n_points");
+    m_quad_first_vertex = m_quad_program->uniformLocation("first_vertex");
+    m_quad_stride = m_quad_program->uniformLocation("stride");
+    m_quad_capacity = m_quad_program->uniformLocation("capacity");
+    m_quad_region_size = m_quad_program->uniformLocation("region_size");
+    m_quad_n_vertices = m_quad_program->uniformLocation("n_vertices");
+    m_quad_join = m_quad_program->uniformLocation("join_mode");
+    m_quad_pastvaluegainLoc = m_quad_program->uniformLocation("pastValueGain");
+    glGenTextures(1, &signalTbo);
+    maxTboTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTboTexels);
+
+    glGenTextures(1, &sigStyleTex);
+    glBindTexture(GL_TEXTURE_2D, sigStyleTex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);  //without mipmaps the texture would be incomplete
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    sigStyleRows = 0;
 #endif
 
 
     //Line Program Declaration
-    m_program = new QOpenGLShaderProgram;
-    if (m_program->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Line.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_program->addShaderFromSourceFile(QOpenGLShader::Geometry, ":/shaders/Shaders/Line.gsh") == false)
-        qDebug("Error compiling Geometry Shader");
-    if (m_program->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Line.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_program->link() == false)
-        qDebug("Shaders were not linked correctly\n");
+    m_program = glResourceManager::getProgram(":/shaders/Shaders/Line.vsh", ":/shaders/Shaders/Line.gsh", ":/shaders/Shaders/Line.fsh");
     if (m_program->bind() == false)
         qDebug("Shader not correctly bound\n");
 
@@ -227,31 +283,22 @@ void GLWindow::initializeGL()
     m_program->release();
 
 #ifdef USE_VERTEX_ID
-    m_program_dot = new QOpenGLShaderProgram;
-    if (m_program_dot->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/DotVertexID.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_program_dot->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/DotVertexID.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_program_dot->link() == false)
-        qDebug("Shaders were not linked correctly\n");
+    m_program_dot = glResourceManager::getProgram(":/shaders/Shaders/DotVertexID.vsh", "", ":/shaders/Shaders/DotVertexID.fsh");
     if (m_program_dot->bind() == false)
         qDebug("Shader not correctly bound\n");
     m_in_colorLocDot = m_program_dot->uniformLocation("in_color");
     m_in_paramsLocDot = m_program_dot->uniformLocation("in_params");
     m_transfMatrixLocDot = m_program_dot->uniformLocation("transfMatrix");
     m_n_points_dot = m_program_dot->uniformLocation("n_points");
-    m_instance_dot = m_program_dot->uniformLocation("instance");
+    m_first_vertex_dot = m_program_dot->uniformLocation("first_vertex");
+    m_stride_dot = m_program_dot->uniformLocation("stride");
+    m_capacity_dot = m_program_dot->uniformLocation("capacity");
+    m_sig_style_dot = m_program_dot->uniformLocation("sig_style");
     m_pastvaluegainLocDot = m_program_dot->uniformLocation("pastValueGain");
 
     m_program_dot->release();
 #else
-    m_program_dot = new QOpenGLShaderProgram;
-    if (m_program_dot->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Dot.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_program_dot->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Dot.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_program_dot->link() == false)
-        qDebug("Shaders were not linked correctly\n");
+    m_program_dot = glResourceManager::getProgram(":/shaders/Shaders/Dot.vsh", "", ":/shaders/Shaders/Dot.fsh");
     if (m_program_dot->bind() == false)
         qDebug("Shader not correctly bound\n");
     m_in_colorLocDot = m_program_dot->uniformLocation("in_color");
@@ -261,13 +308,7 @@ void GLWindow::initializeGL()
     m_program_dot->release();
 #endif
 
-    m_program_zoom = new QOpenGLShaderProgram;
-    if (m_program_zoom->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Zoom.vsh") == false)
-        qDebug("Error compiling Zoom Vertex Shader");
-    if (m_program_zoom->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Zoom.fsh") == false)
-        qDebug("Error compiling Zoom Geometry Shader");
-    if (m_program_zoom->link() == false)
-        qDebug("Zoom shaders were not linked correctly\n");
+    m_program_zoom = glResourceManager::getProgram(":/shaders/Shaders/Zoom.vsh", "", ":/shaders/Shaders/Zoom.fsh");
     if (m_program_zoom->bind() == false)
         qDebug("Zoom shader not correctly bound\n");
 
@@ -283,13 +324,44 @@ void GLWindow::initializeGL()
     m_zoom_vao->release();
     m_program_zoom->release();
 
-    m_program_tex = new QOpenGLShaderProgram;
-    if (m_program_tex->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Texture.vsh") == false)
-        qDebug("Error compiling Texture Vertex Shader");
-    if (m_program_tex->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Texture.fsh") == false)
-        qDebug("Error compiling Texture Fragment Shader");
-    if (m_program_tex->link() == false)
-        qDebug("Texture shaders were not linked correctly\n");
+    //Persistence Program Declaration
+    m_persistence_program = glResourceManager::getProgram(":/shaders/Shaders/Density.vsh", "", ":/shaders/Shaders/Density.fsh");
+    if (m_persistence_program->bind() == false)
+        qDebug("Persistence shader not correctly bound\n");
+    m_persistence_transfMatrixLoc = m_persistence_program->uniformLocation("transfMatrix");
+    m_persistence_scaleLoc = m_persistence_program->uniformLocation("scale");
+    m_persistence_maxCountLoc = m_persistence_program->uniformLocation("maxCount");
+    m_persistence_program->setUniformValue("densityTex", 0);
+
+    m_persistence_vao = new QOpenGLVertexArrayObject;
+    if (m_persistence_vao->create() == false)
+        qDebug("Persistence VAO error!\n");
+    m_persistence_vao->bind();
+
+    m_persistenceVbo = new QOpenGLBuffer;
+    if (m_persistenceVbo->create() == false)
+        qDebug("Persistence VBO error!\n");
+    m_persistenceVbo->bind();
+    m_persistenceVbo->allocate(quad, 8 * static_cast<int>(sizeof(GLfloat)));
+    f->glEnableVertexAttribArray(0);
+    f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), reinterpret_cast<void*>(0));
+    m_persistenceVbo->release();
+
+    m_persistence_vao->release();
+    m_persistence_program->release();
+
+    glGenTextures(1, &persistenceTex);
+    glBindTexture(GL_TEXTURE_2D, persistenceTex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, DENSITY_BINS, DENSITY_BINS, 0, GL_RED, GL_FLOAT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (persistence != nullptr)
+        persistence->invalidate();  //the new texture is empty
+
+    m_program_tex = glResourceManager::getTextProgram(preferences->sdf_fonts);
     if (m_program_tex->bind() == false)
         qDebug("Texture shaders not corrently bound\n");
 
@@ -298,23 +370,49 @@ void GLWindow::initializeGL()
         qDebug("Texture VAO error!\n");
     m_tex_vao->bind();
 
-    m_texVbo = new QOpenGLBuffer;
-    if (m_texVbo->create() == false)
+    m_legendTextVbo = new QOpenGLBuffer;
+    if (m_legendTextVbo->create() == false)
+        qDebug("Texture VBO error!\n");
+    m_legendTextVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+
+    m_statTextVbo = new QOpenGLBuffer;
+    if (m_statTextVbo->create() == false)
+        qDebug("Texture VBO error!\n");
+    m_statTextVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+
+    m_toolTipTextVbo = new QOpenGLBuffer;
+    if (m_toolTipTextVbo->create() == false)
+        qDebug("Texture VBO error!\n");
+    m_toolTipTextVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+
+    legendRevision = 0;  //the buffers are empty
+    statRevision = 0;
+    toolTipRevision = 0;
+
+    m_gridTextVbo = new QOpenGLBuffer;
+    if (m_gridTextVbo->create() == false)
         qDebug("Texture VBO error!\n");
 
     m_tex_vao->release();
     m_program_tex->release();
 
-    gridTex = new QOpenGLTexture(grid->getFontTexture().mirrored());
-    legendTex = new QOpenGLTexture(legend->getLegendTexture().mirrored());  //creates the legend texture
-    statTex = new QOpenGLTexture(stats->getStatTexture().mirrored());
-    toolTipTex = new QOpenGLTexture(tooltip->getToolTipTexture().mirrored());
+    gridTex = glResourceManager::acquireTexture(grid->getFontTexture());
+    legendTex = glResourceManager::acquireTexture(legend->getLegendTexture());  //creates the legend texture
+    statTex = glResourceManager::acquireTexture(stats->getStatTexture());
+    toolTipTex = glResourceManager::acquireTexture(tooltip->getToolTipTexture());
     doneCurrent();
 }
 
 void GLWindow::paintGL()
 {
+#ifdef USE_VERTEX_ID
+    float step_x;
+    int first_vertex, capacity, region_size, n_vertices;
+    int renderer;
+    bool probing;
+#else
     int i;
+#endif
 
     if ((N_signals != sig_properties.count()) && (N_signals != indexes.count()))  //we check that the signals vector are coherent
         return;
@@ -333,15 +431,8 @@ void GLWindow::paintGL()
     glClearColor(static_cast<float>(backR), static_cast<float>(backG), static_cast<float>(backB), static_cast<float>(backA));
 
     //DRAW THE GRID
+    upload_Grid_Buffers();
     //First Axis
-    m_gridVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_gridVbo = new QOpenGLBuffer;
-    if (m_gridVbo->create() == false)
-        qDebug("VBO grid error!\n");
-    if (m_gridVbo->bind() == false)
-        qDebug("VBO grid not bounded!!\n");
-    m_gridVbo->allocate(grid->Data(), grid->count() * static_cast<int>(sizeof(GLfloat)));
-    m_gridVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
     m_program->bind();
     m_vao->bind();
     glEnable(GL_BLEND);
@@ -365,30 +456,55 @@ void GLWindow::paintGL()
 
 #ifdef USE_VERTEX_ID
     //DRAW SIGNALS
-    m_ver_program->bind();
-    m_ver_vao->bind();
-    m_signalVbo->bind();
-    f->glEnableVertexAttribArray(0);
-    f->glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(GLfloat), reinterpret_cast<void*>(0));
-    m_ver_program->setUniformValue(m_ver_transfMatrixLoc, transfMatrix);
-    m_ver_program->setUniformValue(m_ver_screenSizeLoc, QVector2D(static_cast<float>(this->width()), static_cast<float>(this->height())));
-    m_ver_program->setUniformValue(m_pastvaluegainLoc, pastValueGain);
-    for (i = 0; i < N_signals; i++)
+    step_x = grid->get_StepX();
+    if (x_step > 0.0f)
+        step_x = x_step;  //the vertices are the decimated points, not the samples
+    prepare_Draw_Lists(&first_vertex, &capacity, &region_size);
+    n_vertices = 0;
+    if (N_signals > 0)
+        n_vertices = first_vertex + ((N_signals - 1) * signal_stride) + region_size;
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sigStyleTex);
+
+    renderer = select_Line_Renderer(n_vertices, &probing);
+    if (probing == true)
     {
-        if (i < sig_properties.count())  //Makes sure that there is an element in sig_properties
-            if (sig_properties[i].lineRendering == true)
-            {
-                m_ver_program->setUniformValue(m_in_ver_colorLoc, sig_properties[i].color);
-                m_ver_program->setUniformValue(m_in_ver_paramsLoc, QVector4D(sig_properties[i].line_width, grid->get_ConvFact(), grid->get_X_Axis(), grid->get_StepX()));
-                m_ver_program->setUniformValue(m_n_points, Number_of_Points);
-                m_ver_program->setUniformValue(m_instance, i);
-                glDrawArrays(GL_LINE_STRIP, indexes[i], Number_of_Points);
-            }
+        glFinish();
+        probeTimer.start();
     }
 
-    m_signalVbo->release();
-    m_ver_vao->release();
-    m_ver_program->release();
+    if (renderer == LINE_RENDERER_QUAD)
+        draw_Lines_Quad(first_vertex, capacity, region_size, n_vertices, step_x);
+    else
+    {
+        m_ver_program->bind();
+        m_ver_vao->bind();
+        m_signalVbo->bind();
+        f->glEnableVertexAttribArray(0);
+        f->glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(GLfloat), reinterpret_cast<void*>(0));
+        m_ver_program->setUniformValue(m_ver_transfMatrixLoc, transfMatrix);
+        m_ver_program->setUniformValue(m_ver_screenSizeLoc, QVector2D(static_cast<float>(this->width()), static_cast<float>(this->height())));
+        m_ver_program->setUniformValue(m_pastvaluegainLoc, pastValueGain);
+        m_ver_program->setUniformValue(m_in_ver_paramsLoc, QVector4D(0.0f, grid->get_ConvFact(), grid->get_X_Axis(), step_x));  //the line width is in sig_style
+        m_ver_program->setUniformValue(m_n_points, Number_of_Points);
+        m_ver_program->setUniformValue(m_first_vertex, first_vertex);
+        m_ver_program->setUniformValue(m_stride, signal_stride);
+        m_ver_program->setUniformValue(m_capacity, capacity);
+        m_ver_program->setUniformValue(m_sig_style, 0);
+        if (equal_spacing == true)
+            multi_Draw(GL_LINE_STRIP, &line_first, &line_count);
+        else
+            draw_Signals_Separately(m_ver_program, m_first_vertex, m_stride, GL_LINE_STRIP, false);
+        m_signalVbo->release();
+        m_ver_vao->release();
+        m_ver_program->release();
+    }
+
+    if (probing == true)
+    {
+        glFinish();
+        update_Line_Probe(renderer, static_cast<double>(probeTimer.nsecsElapsed()) / 1e6);
+    }
 
     glEnable(GL_PROGRAM_POINT_SIZE);
     m_program_dot->bind();
@@ -398,21 +514,20 @@ void GLWindow::paintGL()
     f->glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(GLfloat), reinterpret_cast<void*>(0));
     m_program_dot->setUniformValue(m_transfMatrixLocDot, transfMatrix);
     m_program_dot->setUniformValue(m_pastvaluegainLocDot, pastValueGain);
-    for (i = 0; i < N_signals; i++)
-    {
-        if (i < sig_properties.count())
-            if (sig_properties[i].dotRendering == true)
-            {
-                m_program_dot->setUniformValue(m_in_colorLocDot, sig_properties[i].color);
-                m_program_dot->setUniformValue(m_in_paramsLocDot, QVector4D(sig_properties[i].line_width, grid->get_ConvFact(), grid->get_X_Axis(), grid->get_StepX()));
-                m_program_dot->setUniformValue(m_n_points_dot, Number_of_Points);
-                m_program_dot->setUniformValue(m_instance_dot, i);
-                glDrawArrays(GL_POINTS, indexes[i], Number_of_Points);
-            }
-    }
+    m_program_dot->setUniformValue(m_in_paramsLocDot, QVector4D(0.0f, grid->get_ConvFact(), grid->get_X_Axis(), step_x));
+    m_program_dot->setUniformValue(m_n_points_dot, Number_of_Points);
+    m_program_dot->setUniformValue(m_first_vertex_dot, first_vertex);
+    m_program_dot->setUniformValue(m_stride_dot, signal_stride);
+    m_program_dot->setUniformValue(m_capacity_dot, capacity);
+    m_program_dot->setUniformValue(m_sig_style_dot, 0);
+    if (equal_spacing == true)
+        multi_Draw(GL_POINTS, &dot_first, &dot_count);
+    else
+        draw_Signals_Separately(m_program_dot, m_first_vertex_dot, m_stride_dot, GL_POINTS, true);
     m_signalVbo->release();
     m_vao->release();
-    m_program->release();
+    m_program_dot->release();
+    glBindTexture(GL_TEXTURE_2D, 0);
 #else
     m_program->bind();
     m_vao->bind();
@@ -424,7 +539,7 @@ void GLWindow::paintGL()
     for (i = 0; i < N_signals; i++)
     {
         if (i < sig_properties.count())  //Makes sure that there is an element in sig_properties
-            if (sig_properties[i].lineRendering == true)
+            if ((sig_properties[i].lineRendering == true) && (persistence == nullptr))
             {
                 m_program->setUniformValue(m_in_colorLoc, sig_properties[i].color);
                 m_program->setUniformValue(m_in_paramsLoc, QVector3D(sig_properties[i].line_width, grid->get_ConvFact(), grid->get_X_Axis()));
@@ -446,7 +561,7 @@ void GLWindow::paintGL()
     for (i = 0; i < N_signals; i++)
     {
         if (i < sig_properties.count())
-            if (sig_properties[i].dotRendering == true)
+            if ((sig_properties[i].dotRendering == true) && (persistence == nullptr))
             {
                 m_program_dot->setUniformValue(m_in_colorLocDot, sig_properties[i].color);
                 m_program_dot->setUniformValue(m_in_paramsLocDot, QVector3D(sig_properties[i].line_width, grid->get_ConvFact(), grid->get_X_Axis()));
@@ -458,24 +573,13 @@ void GLWindow::paintGL()
     m_program->release();
 #endif
 
+    if (persistence != nullptr)
+        draw_Persistence();
+
     //DRAW GRID TEXT
-    grid->update_Text(this->width(), this->height());
-    m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_program_tex->bind();
-    m_tex_vao->bind();
-    m_texVbo = new QOpenGLBuffer;
-    if (m_texVbo->create() == false)
-        qDebug("Texture VBO signal error!\n");
-    if (m_texVbo->bind() == false)
-        qDebug("Texture VBO signal not bounded!!\n");
-    m_texVbo->allocate(grid->getTextData()->data(), grid->getTextData()->length() * static_cast<int>(sizeof(float)));
-    m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-    m_texVbo->release();
-    m_tex_vao->release();
-    m_program_tex->release();
     m_program_tex->bind();
     m_tex_vao->bind();
-    m_texVbo->bind();
+    m_gridTextVbo->bind();
     f->glEnableVertexAttribArray(0);
     f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
     f->glEnableVertexAttribArray(1);
@@ -484,7 +588,7 @@ void GLWindow::paintGL()
     f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
     gridTex->bind();
     glDrawArrays(GL_TRIANGLES, 0, grid->getTextData()->length() / 48 * 6);
-    m_texVbo->release();
+    m_gridTextVbo->release();
     m_tex_vao->release();
     m_program_tex->release();
 
@@ -538,23 +642,19 @@ void GLWindow::paintGL()
         m_program_zoom->release();
 
         //Now we paint the text
-        m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-        m_program_tex->bind();
-        m_tex_vao->bind();
-        m_texVbo = new QOpenGLBuffer;
-        if (m_texVbo->create() == false)
-            qDebug("Texture VBO signal error!\n");
-        if (m_texVbo->bind() == false)
-            qDebug("Texture VBO signal not bounded!!\n");
-        m_texVbo->allocate(legend->getLegendData()->data(), legend->getLegendData()->length() * static_cast<int>(sizeof(float)));
-        m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-        m_texVbo->release();
-        m_tex_vao->release();
-        m_program_tex->release();
+        //the text is uploaded only when it has been laid out again
+        if (legend->getLegendRevision() != legendRevision)
+        {
+            if (m_legendTextVbo->bind() == false)
+                qDebug("Texture VBO signal not bounded!!\n");
+            m_legendTextVbo->allocate(legend->getLegendData()->data(), legend->getLegendData()->length() * static_cast<int>(sizeof(float)));
+            m_legendTextVbo->release();
+            legendRevision = legend->getLegendRevision();
+        }
 
         m_program_tex->bind();
         m_tex_vao->bind();
-        m_texVbo->bind();
+        m_legendTextVbo->bind();
         f->glEnableVertexAttribArray(0);
         f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
         f->glEnableVertexAttribArray(1);
@@ -563,7 +663,7 @@ void GLWindow::paintGL()
         f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
         legendTex->bind();
         glDrawArrays(GL_TRIANGLES, 0, legend->getLegendData()->length() / 48 * 6);
-        m_texVbo->release();
+        m_legendTextVbo->release();
         m_tex_vao->release();
         m_program_tex->release();
     }
@@ -576,23 +676,18 @@ void GLWindow::paintGL()
         stats->setSignals(sig_properties);
         stats->createStat(0.95f, -0.95f);  //set by default at top left
 
-        m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-        m_program_tex->bind();
-        m_tex_vao->bind();
-        m_texVbo = new QOpenGLBuffer;
-        if (m_texVbo->create() == false)
-            qDebug("Texture VBO signal error!\n");
-        if (m_texVbo->bind() == false)
-            qDebug("Texture VBO signal not bounded!!\n");
-        m_texVbo->allocate(stats->getStatData()->data(), stats->getStatData()->length() * static_cast<int>(sizeof(float)));
-        m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-        m_texVbo->release();
-        m_tex_vao->release();
-        m_program_tex->release();
+        if (stats->getStatRevision() != statRevision)
+        {
+            if (m_statTextVbo->bind() == false)
+                qDebug("Texture VBO signal not bounded!!\n");
+            m_statTextVbo->allocate(stats->getStatData()->data(), stats->getStatData()->length() * static_cast<int>(sizeof(float)));
+            m_statTextVbo->release();
+            statRevision = stats->getStatRevision();
+        }
 
         m_program_tex->bind();
         m_tex_vao->bind();
-        m_texVbo->bind();
+        m_statTextVbo->bind();
         f->glEnableVertexAttribArray(0);
         f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
         f->glEnableVertexAttribArray(1);
@@ -601,7 +696,7 @@ void GLWindow::paintGL()
         f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
         statTex->bind();
         glDrawArrays(GL_TRIANGLES, 0, stats->getStatData()->length() / 48 * 6);
-        m_texVbo->release();
+        m_statTextVbo->release();
         m_tex_vao->release();
         m_program_tex->release();
     }
@@ -615,23 +710,18 @@ void GLWindow::paintGL()
         tooltip->setValues(coordX, coordY);
         tooltip->createToolTip(x_tooltip, y_tooltip, toolTipColor);  //set by default at top left
 
-        m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-        m_program_tex->bind();
-        m_tex_vao->bind();
-        m_texVbo = new QOpenGLBuffer;
-        if (m_texVbo->create() == false)
-            qDebug("Texture VBO signal error!\n");
-        if (m_texVbo->bind() == false)
-            qDebug("Texture VBO signal not bounded!!\n");
-        m_texVbo->allocate(tooltip->getToolTipData()->data(), tooltip->getToolTipData()->length() * static_cast<int>(sizeof(float)));
-        m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-        m_texVbo->release();
-        m_tex_vao->release();
-        m_program_tex->release();
+        if (tooltip->getToolTipRevision() != toolTipRevision)
+        {
+            if (m_toolTipTextVbo->bind() == false)
+                qDebug("Texture VBO signal not bounded!!\n");
+            m_toolTipTextVbo->allocate(tooltip->getToolTipData()->data(), tooltip->getToolTipData()->length() * static_cast<int>(sizeof(float)));
+            m_toolTipTextVbo->release();
+            toolTipRevision = tooltip->getToolTipRevision();
+        }
 
         m_program_tex->bind();
         m_tex_vao->bind();
-        m_texVbo->bind();
+        m_toolTipTextVbo->bind();
         f->glEnableVertexAttribArray(0);
         f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
         f->glEnableVertexAttribArray(1);
@@ -640,7 +730,7 @@ void GLWindow::paintGL()
         f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
         toolTipTex->bind();
         glDrawArrays(GL_TRIANGLES, 0, tooltip->getToolTipData()->length() / 48 * 6);
-        m_texVbo->release();
+        m_toolTipTextVbo->release();
         m_tex_vao->release();
         m_program_tex->release();
 
@@ -679,6 +769,8 @@ void GLWindow::paintGL()
         m_vao->release();
         m_program->release();
     }
+
+    thumbs->capture();
 }
 
 void GLWindow::resizeGL(int w, int h)
@@ -733,12 +825,33 @@ void GLWindow::cleanup()
         return;
     makeCurrent();
     m_gridVbo->destroy();
+    m_gridTextVbo->destroy();
+    m_legendTextVbo->destroy();
+    m_statTextVbo->destroy();
+    m_toolTipTextVbo->destroy();
     m_signalVbo->destroy();
+#ifdef USE_VERTEX_ID
+    glDeleteTextures(1, &sigStyleTex);
+    glDeleteTextures(1, &signalTbo);
+    sigStyleTex = 0;
+    signalTbo = 0;
+#endif
     m_zoomVbo->destroy();
     m_vao->destroy();
+    m_persistenceVbo->destroy();
+    m_persistence_vao->destroy();
+    glDeleteTextures(1, &persistenceTex);
+    persistenceTex = 0;
+    thumbs->release();
     m_zoom_vao->destroy();
-    legendTex->destroy();
-    statTex->destroy();
+    glResourceManager::releaseTexture(gridTex);
+    glResourceManager::releaseTexture(legendTex);
+    glResourceManager::releaseTexture(statTex);
+    glResourceManager::releaseTexture(toolTipTex);
+    gridTex = nullptr;
+    legendTex = nullptr;
+    statTex = nullptr;
+    toolTipTex = nullptr;
 //    m_program->release();
 //    delete m_program;
 //    delete m_program_zoom;
@@ -749,14 +862,10 @@ void GLWindow::cleanup()
 //    delete stats;
 }
 
-void GLWindow::parallel_prepare_Signal_Buffer(int n_signals, int n_points, QVector<GLfloat> *buffer, QVector<SigProperty> prop, QVector<int> idx)
+void GLWindow::copy_Sig_Properties(QVector<SigProperty> prop)
 {
-    int n_p;
-
-    if (n_signals < prop.count())
-        return;  //in this case we would have an error
-
     int i;
+
     sig_properties.clear();
     sig_properties.resize(prop.count());
     for (i = 0; i < prop.count(); i++)
@@ -770,6 +879,19 @@ void GLWindow::parallel_prepare_Signal_Buffer(int n_signals, int n_points, QVect
         sig_properties[i].dotRendering = prop[i].dotRendering;
         sig_properties[i].lineRendering = prop[i].lineRendering;
     }
+}
+
+void GLWindow::parallel_prepare_Signal_Buffer(int n_signals, int n_points, QVector<GLfloat> *buffer, QVector<SigProperty> prop, QVector<int> idx)
+{
+    int n_p;
+#ifdef USE_VERTEX_ID
+    int i;
+#endif
+
+    if (n_signals < prop.count())
+        return;  //in this case we would have an error
+
+    copy_Sig_Properties(prop);
 
     if (n_points <= grid->get_N_points()) //n_points tells us how many points are contained in the signal buffers
         n_p = n_points;
@@ -779,27 +901,398 @@ void GLWindow::parallel_prepare_Signal_Buffer(int n_signals, int n_points, QVect
     makeCurrent();
 
     //the buffer is now ready to plot
-    //we can prepare the vertex buffer object
-    m_signalVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_signalVbo = new QOpenGLBuffer;
-    if (m_signalVbo->create() == false)
-        qDebug("VBO signal error!\n");
+    //we can prepare the vertex buffer object, the buffer object is reused and only its storage is reallocated
     if (m_signalVbo->bind() == false)
         qDebug("VBO signal not bounded!!\n");
+    m_signalVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
 #ifdef USE_VERTEX_ID
     m_signalVbo->allocate(buffer->data(), n_signals * n_p * static_cast<int>(sizeof(GLfloat)));
 #else
     m_signalVbo->allocate(buffer->data(), n_signals * n_p * 2 * static_cast<int>(sizeof(GLfloat)));
 #endif
-    m_signalVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+    m_signalVbo->release();
 
     N_signals = n_signals;
     Number_of_Points = n_p;
     indexes = idx;
+#ifdef USE_VERTEX_ID
+    ring_mode = false;
+    ring_signals = 0;  //the next streaming call reallocates the circular buffer
+
+    //the shaders find the signal of a vertex from its position in the buffer, so the signals must be equally spaced to be drawn at once
+    signal_stride = n_p;
+    if (idx.count() > 1)
+        signal_stride = idx[1] - idx[0];
+    equal_spacing = true;
+    for (i = 1; i < idx.count(); i++)
+    {
+        if ((idx[i] - idx[i - 1] != signal_stride) || (signal_stride < n_p))
+        {
+            equal_spacing = false;
+            break;
+        }
+    }
+#endif
 
     doneCurrent();
 }
 
+#ifdef USE_VERTEX_ID
+void GLWindow::stream_Signal_Buffer(int n_signals, int n_points, float **buff_ptr, int start, QVector<uint64_t> abs_start, QVector<uint64_t> epoch, QVector<SigProperty> prop)
+{
+    int i, n_p, C;
+    uint64_t A, B, from;
+
+    if ((n_signals < prop.count()) || (abs_start.count() < n_signals) || (epoch.count() < n_signals))
+        return;  //in this case we would have an error
+
+    copy_Sig_Properties(prop);
+
+    C = grid->get_N_points();
+    if (n_points <= C)  //n_points tells us how many points are visible in the signal buffers
+        n_p = n_points;
+    else
+        n_p = C;
+
+    makeCurrent();
+
+    if (m_signalVbo->bind() == false)
+        qDebug("VBO signal not bounded!!\n");
+
+    //the storage is allocated again only when the number of signals or the number of points of the grid changes
+    if ((ring_mode == false) || (ring_capacity != C) || (ring_signals != n_signals))
+    {
+        m_signalVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+        m_signalVbo->allocate(n_signals * (C + 1) * static_cast<int>(sizeof(GLfloat)));
+        ring_mode = true;
+        ring_capacity = C;
+        ring_signals = n_signals;
+        ring_begin.fill(0, n_signals);
+        ring_end.fill(0, n_signals);
+        ring_epoch.fill(0, n_signals);
+        ring_offset.fill(0, n_signals);
+        for (i = 0; i < n_signals; i++)
+            ring_epoch[i] = epoch[i] + 1;  //forces the first upload
+    }
+
+    indexes.resize(n_signals);
+    for (i = 0; i < n_signals; i++)
+    {
+        A = abs_start[i];
+        B = A + static_cast<uint64_t>(n_p);
+        indexes[i] = i * (C + 1);
+
+        //if the visible window starts inside the samples already on the GPU only the new ones are sent
+        if ((ring_epoch[i] == epoch[i]) && (A >= ring_begin[i]) && (A <= ring_end[i]))
+        {
+            if (B > ring_end[i])
+            {
+                from = ring_end[i];
+                write_Ring(i, from, buff_ptr[i] + start + static_cast<int>(from - A), static_cast<int>(B - from));
+                ring_end[i] = B;
+            }
+        }
+        else
+        {
+            write_Ring(i, A, buff_ptr[i] + start, n_p);
+            ring_begin[i] = A;
+            ring_end[i] = B;
+            ring_epoch[i] = epoch[i];
+        }
+        if (ring_end[i] > static_cast<uint64_t>(C))
+            ring_begin[i] = qMax(ring_begin[i], ring_end[i] - static_cast<uint64_t>(C));
+        ring_offset[i] = static_cast<int>(A % static_cast<uint64_t>(C));
+    }
+
+    m_signalVbo->release();
+
+    N_signals = n_signals;
+    Number_of_Points = n_p;
+    signal_stride = C + 1;
+    equal_spacing = true;
+
+    doneCurrent();
+}
+
+void GLWindow::write_Ring(int i, uint64_t abs_pos, const float *data, int N)
+{
+    int region, slot, n;
+
+    region = i * (ring_capacity + 1);
+    while (N > 0)
+    {
+        slot = static_cast<int>(abs_pos % static_cast<uint64_t>(ring_capacity));
+        n = qMin(N, ring_capacity - slot);  //the write is split when it crosses the end of the ring
+        m_signalVbo->write((region + slot) * static_cast<int>(sizeof(GLfloat)), data, n * static_cast<int>(sizeof(GLfloat)));
+        if (slot == 0)  //the slot after the last one repeats the first sample
+            m_signalVbo->write((region + ring_capacity) * static_cast<int>(sizeof(GLfloat)), data, static_cast<int>(sizeof(GLfloat)));
+        data += n;
+        abs_pos += static_cast<uint64_t>(n);
+        N -= n;
+    }
+}
+
+void GLWindow::prepare_Draw_Lists(int *first_vertex, int *capacity, int *region_size)
+{
+    int i, region, start, count, count2;
+    float *style;
+
+    line_first.clear(); line_count.clear();
+    dot_first.clear(); dot_count.clear();
+    *first_vertex = 0;
+    *capacity = Number_of_Points;
+    *region_size = Number_of_Points;
+    if ((N_signals == 0) || (Number_of_Points == 0) || (indexes.count() < N_signals) || (sig_properties.count() < N_signals))
+        return;
+
+    if (ring_mode == true)
+    {
+        *capacity = ring_capacity;
+        *region_size = ring_capacity + 1;
+    }
+    else
+        *first_vertex = indexes[0];
+
+    //style of the signals, one row of two texels per signal
+    sigStyleData.resize(N_signals * 8);
+    style = sigStyleData.data();
+    for (i = 0; i < N_signals; i++)
+    {
+        style[0] = static_cast<float>(sig_properties[i].color.redF());
+        style[1] = static_cast<float>(sig_properties[i].color.greenF());
+        style[2] = static_cast<float>(sig_properties[i].color.blueF());
+        style[3] = static_cast<float>(sig_properties[i].color.alphaF());
+        style[4] = sig_properties[i].line_width;
+        style[5] = 0.0f;
+        if (ring_mode == true)
+            style[5] = static_cast<float>(ring_offset[i]);
+        style[6] = 0.0f;
+        if (sig_properties[i].lineRendering == true)
+            style[6] = 1.0f;
+        style[7] = 0.0f;
+        style += 8;
+    }
+    glBindTexture(GL_TEXTURE_2D, sigStyleTex);
+    if (sigStyleRows != N_signals)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 2, N_signals, 0, GL_RGBA, GL_FLOAT, sigStyleData.constData());
+        sigStyleRows = N_signals;
+    }
+    else
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 2, N_signals, GL_RGBA, GL_FLOAT, sigStyleData.constData());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    //ranges to be drawn, a signal wrapping around its circular region needs two of them
+    for (i = 0; i < N_signals; i++)
+    {
+        region = 0;
+        count2 = 0;
+        if (ring_mode == false)
+        {
+            start = indexes[i];
+            count = Number_of_Points;
+        }
+        else
+        {
+            //the visible window goes from ring_offset up to the repeated slot and then continues from the beginning of the region
+            region = i * signal_stride;
+            start = region + ring_offset[i];
+            count = qMin(Number_of_Points, ring_capacity - ring_offset[i] + 1);
+            if (count < Number_of_Points)
+                count2 = Number_of_Points - count + 1;
+        }
+        if ((sig_properties[i].lineRendering == true) && (persistence == nullptr))
+        {
+            line_first.append(start); line_count.append(count);
+            if (count2 > 0)
+            {
+                line_first.append(region); line_count.append(count2);
+            }
+        }
+        if ((sig_properties[i].dotRendering == true) && (persistence == nullptr))
+        {
+            dot_first.append(start); dot_count.append(count);
+            if (count2 > 0)
+            {
+                dot_first.append(region); dot_count.append(count2);
+            }
+        }
+    }
+}
+
+void GLWindow::multi_Draw(GLenum mode, QVector<GLint> *first, QVector<GLsizei> *count)
+{
+    int i;
+
+    if (first->count() == 0)
+        return;
+
+    if (gl32 != nullptr)
+    {
+        gl32->glMultiDrawArrays(mode, first->constData(), count->constData(), first->count());
+        return;
+    }
+    for (i = 0; i < first->count(); i++)
+        glDrawArrays(mode, (*first)[i], (*count)[i]);
+}
+
+void GLWindow::draw_Signals_Separately(QOpenGLShaderProgram *program, int firstLoc, int strideLoc, GLenum mode, bool dots)
+{
+    int i;
+    bool drawn;
+
+    if ((indexes.count() < N_signals) || (sig_properties.count() < N_signals) || (persistence != nullptr))
+        return;
+
+    //one call per signal: the first vertex is moved back by i strides of Number_of_Points, so that the shader still finds signal i
+    program->setUniformValue(strideLoc, Number_of_Points);
+    for (i = 0; i < N_signals; i++)
+    {
+        drawn = sig_properties[i].lineRendering;
+        if (dots == true)
+            drawn = sig_properties[i].dotRendering;
+        if (drawn == false)
+            continue;
+        program->setUniformValue(firstLoc, indexes[i] - (i * Number_of_Points));
+        glDrawArrays(mode, indexes[i], Number_of_Points);
+    }
+}
+
+bool GLWindow::quad_Capable(int n_vertices)
+{
+    if ((gl32 == nullptr) || (m_quad_program == nullptr))
+        return false;
+    if (m_quad_program->isLinked() == false)
+        return false;
+    return n_vertices <= maxTboTexels;  //the samples are read through a buffer texture
+}
+
+int GLWindow::select_Line_Renderer(int n_vertices, bool *probing)
+{
+    *probing = false;
+
+    if ((quad_Capable(n_vertices) == false) || (equal_spacing == false))
+        return LINE_RENDERER_GS;  //the quads are instanced over the whole buffer, which needs equally spaced signals
+    if (lineRenderer != LINE_RENDERER_AUTO)
+        return lineRenderer;
+    if (probedLineRenderer != LINE_RENDERER_AUTO)
+        return probedLineRenderer;
+    if ((n_vertices < LINE_PROBE_MIN_VERTICES) || (line_first.count() == 0))
+        return LINE_RENDERER_GS;  //too little work to be measured
+
+    //the two renderers are alternated until both of them have been measured LINE_PROBE_FRAMES times
+    *probing = true;
+    if (probeFrames[0] <= probeFrames[1])
+        return LINE_RENDERER_GS;
+    return LINE_RENDERER_QUAD;
+}
+
+void GLWindow::update_Line_Probe(int renderer, double ms)
+{
+    int idx;
+
+    idx = 0;
+    if (renderer == LINE_RENDERER_QUAD)
+        idx = 1;
+
+    //the best frame is kept, so that the first frame compiling the shaders does not count
+    if ((probeFrames[idx] == 0) || (ms < probeBest[idx]))
+        probeBest[idx] = ms;
+    probeFrames[idx]++;
+
+    if ((probeFrames[0] >= LINE_PROBE_FRAMES) && (probeFrames[1] >= LINE_PROBE_FRAMES))
+    {
+        probedLineRenderer = LINE_RENDERER_GS;
+        if (probeBest[1] < probeBest[0])
+            probedLineRenderer = LINE_RENDERER_QUAD;
+        qDebug() << "Line renderer:" << probeBest[0] << "ms with geometry shader," << probeBest[1] << "ms with instanced quads";
+    }
+}
+
+void GLWindow::draw_Lines_Quad(int first_vertex, int capacity, int region_size, int n_vertices, float step_x)
+{
+    m_quad_program->bind();
+    m_ver_vao->bind();  //no attributes are read, but a vertex array object must be bound with the core profile
+
+    //the signal buffer is read as buffer texture on unit 1, the style of the signals is already bound to unit 0
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, signalTbo);
+    gl32->glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, m_signalVbo->bufferId());
+    glActiveTexture(GL_TEXTURE0);
+
+    m_quad_program->setUniformValue(m_quad_samples, 1);
+    m_quad_program->setUniformValue(m_quad_sig_style, 0);
+    m_quad_program->setUniformValue(m_quad_transfMatrixLoc, transfMatrix);
+    m_quad_program->setUniformValue(m_quad_screenSizeLoc, QVector2D(static_cast<float>(this->width()), static_cast<float>(this->height())));
+    m_quad_program->setUniformValue(m_quad_paramsLoc, QVector4D(0.0f, grid->get_ConvFact(), grid->get_X_Axis(), step_x));
+    m_quad_program->setUniformValue(m_quad_pastvaluegainLoc, pastValueGain);
+    m_quad_program->setUniformValue(m_quad_n_points, Number_of_Points);
+    m_quad_program->setUniformValue(m_quad_first_vertex, first_vertex);
+    m_quad_program->setUniformValue(m_quad_stride, signal_stride);
+    m_quad_program->setUniformValue(m_quad_capacity, capacity);
+    m_quad_program->setUniformValue(m_quad_region_size, region_size);
+    m_quad_program->setUniformValue(m_quad_n_vertices, n_vertices);
+    m_quad_program->setUniformValue(m_quad_join, lineJoin);
+
+    //one instance per pair of consecutive vertices, the shader drops the pairs which are not a segment of a visible signal
+    if (n_vertices - first_vertex > 1)
+        gl32->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, n_vertices - first_vertex - 1);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    m_ver_vao->release();
+    m_quad_program->release();
+}
+#endif
+
+int GLWindow::get_Pixel_Columns()
+{
+    float columns;
+
+    //the grid goes from -0.95 to 0.95, the zoom along x scales it
+    columns = 0.95f * static_cast<float>(this->width()) * static_cast<float>(this->devicePixelRatioF()) * fabsf(transfMatrix(0, 0));
+
+    return static_cast<int>(columns);
+}
+
+void GLWindow::set_persistence(densityMap *map)
+{
+    if (persistence == map)
+        return;
+
+    persistence = map;
+    if (persistence != nullptr)
+        persistence->invalidate();  //the texture may hold another map
+}
+
+void GLWindow::draw_Persistence()
+{
+    int first, last, bins;
+
+    bins = persistence->getBins();
+    if (bins != DENSITY_BINS)  //the texture has been allocated for DENSITY_BINS
+        return;
+
+    //only the rows touched by the new sweeps are sent to the GPU
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, persistenceTex);
+    if (persistence->getDirtyRows(&first, &last) == true)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first, bins, last - first + 1, GL_RED, GL_FLOAT, persistence->getData() + (first * bins));
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_persistence_program->bind();
+    m_persistence_vao->bind();
+    m_persistence_program->setUniformValue(m_persistence_transfMatrixLoc, transfMatrix);
+    m_persistence_program->setUniformValue(m_persistence_scaleLoc, persistence->getScale());
+    m_persistence_program->setUniformValue(m_persistence_maxCountLoc, persistence->getMaxCount());
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_persistence_vao->release();
+    m_persistence_program->release();
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void GLWindow::enable_zoom(bool enable) {
     zoom_enabled = enable;
     pan_enabled = false;
@@ -861,10 +1354,10 @@ void GLWindow::updateFonts()
 {    
     makeCurrent();
 
-    delete gridTex;
-    delete legendTex;
-    delete statTex;
-    delete toolTipTex;
+    glResourceManager::releaseTexture(gridTex);
+    glResourceManager::releaseTexture(legendTex);
+    glResourceManager::releaseTexture(statTex);
+    glResourceManager::releaseTexture(toolTipTex);
 
     delete legend;
     delete stats;
@@ -874,11 +1367,15 @@ void GLWindow::updateFonts()
     stats = new statCreator(preferences->stats_font, fontMgr);
     tooltip = new toolTipCreator(preferences->toolTip_font, fontMgr);
     grid->updateFont();
+    m_program_tex = glResourceManager::getTextProgram(preferences->sdf_fonts);  //the font mode could have been changed as well
+    legendRevision = 0;  //the new creators start again from their first revision
+    statRevision = 0;
+    toolTipRevision = 0;
 
-    gridTex = new QOpenGLTexture(grid->getFontTexture().mirrored());
-    legendTex = new QOpenGLTexture(legend->getLegendTexture().mirrored());  //creates the legend texture
-    statTex = new QOpenGLTexture(stats->getStatTexture().mirrored());
-    toolTipTex = new QOpenGLTexture(tooltip->getToolTipTexture().mirrored());
+    gridTex = glResourceManager::acquireTexture(grid->getFontTexture());
+    legendTex = glResourceManager::acquireTexture(legend->getLegendTexture());  //creates the legend texture
+    statTex = glResourceManager::acquireTexture(stats->getStatTexture());
+    toolTipTex = glResourceManager::acquireTexture(tooltip->getToolTipTexture());
 
     doneCurrent();
 }
@@ -949,20 +1446,35 @@ void GLWindow::prepare_zoom_area()
 void GLWindow::prepare_grid_buffer()
 {
     makeCurrent();
-
-    //the buffer is now ready to plot
-    //we can prepare the vertex buffer object
-    m_gridVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_gridVbo = new QOpenGLBuffer;
-    if (m_gridVbo->create() == false)
-        qDebug("VBO grid error!\n");
-    if (m_gridVbo->bind() == false)
-        qDebug("VBO grid not bounded!!\n");
-    m_gridVbo->allocate(grid->Data(), grid->count() * static_cast<int>(sizeof(GLfloat)));
-    m_gridVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::StaticDraw);
+    upload_Grid_Buffers();
     doneCurrent();
 }
 
+void GLWindow::upload_Grid_Buffers()
+{
+    //the grid keeps its geometry and labels until the size, the zoom, the range or the fonts change
+    //the buffers are sent to the GPU only when the grid has been built again
+    grid->update_Text(this->width(), this->height());
+
+    if (grid->getGridRevision() != gridRevision)
+    {
+        if (m_gridVbo->bind() == false)
+            qDebug("VBO grid not bounded!!\n");
+        m_gridVbo->allocate(grid->Data(), grid->count() * static_cast<int>(sizeof(GLfloat)));
+        m_gridVbo->release();
+        gridRevision = grid->getGridRevision();
+    }
+
+    if (grid->getTextRevision() != gridTextRevision)
+    {
+        if (m_gridTextVbo->bind() == false)
+            qDebug("Texture VBO signal not bounded!!\n");
+        m_gridTextVbo->allocate(grid->getTextData()->data(), grid->getTextData()->length() * static_cast<int>(sizeof(float)));
+        m_gridTextVbo->release();
+        gridTextRevision = grid->getTextRevision();
+    }
+}
+
 void GLWindow::legendSignalToggle(int idx)
 {
     int condition;
@@ -38,6 +38,7 @@
 
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
+#include <QOpenGLFunctions_3_2_Core>
 #include <QOpenGLVertexArrayObject>
 #include <QOpenGLBuffer>
 #include <QOpenGLTexture>
@@ -54,12 +55,26 @@
 
 #include "FontManager/fontmanager.h"
 #include "Managers/prefmanager.h"
+#include "Managers/glresourcemanager.h"
+#include "Managers/thumbnailgrabber.h"
 #include "Creators/tooltipcreator.h"
 #include "Creators/textrenderer.h"
 #include "Creators/legendCreator.h"
 #include "Creators/statcreator.h"
+#include "Creators/densitymap.h"
 #include "definitions.h"
 
+#define LINE_RENDERER_AUTO 0  //chosen by measuring both renderers
+#define LINE_RENDERER_GS 1  //segments expanded by the geometry shader
+#define LINE_RENDERER_QUAD 2  //segments expanded into instanced quads by the vertex shader
+
+#define LINE_JOIN_NONE 0
+#define LINE_JOIN_MITER 1
+#define LINE_JOIN_ROUND 2
+
+#define LINE_PROBE_FRAMES 8  //frames measured for each renderer
+#define LINE_PROBE_MIN_VERTICES 20000  //smaller frames are not measured
+
 class GLWindow : public QOpenGLWidget, protected QOpenGLFunctions
 {
     Q_OBJECT
@@ -75,7 +90,18 @@ public:
     void setGridNSamples(int npoints);
     void setGridTimeBase(double TimeBase);
     void parallel_prepare_Signal_Buffer(int n_signals, int n_points, QVector<GLfloat> *buffer, QVector<SigProperty> prop, QVector<int> idx);
+#ifdef USE_VERTEX_ID
+    //uploads only the samples not yet in the circular buffer of each signal, the visible window of signal i starts at buff_ptr[i][start]
+    //abs_start is the absolute position of that sample and epoch tells when the absolute positions of the signal have been reassigned
+    void stream_Signal_Buffer(int n_signals, int n_points, float **buff_ptr, int start, QVector<uint64_t> abs_start, QVector<uint64_t> epoch, QVector<SigProperty> prop);
+#endif
     void thread_prepare_signal(int i, QVector<int> points, QVector<float> floats, QVector<void*> pointers);
+    void set_X_Step(float step) { x_step = step; }  //distance between two vertices along x when the signals are decimated, 0 uses the step of the grid
+    int get_Pixel_Columns(void);  //pixel columns covered by the whole grid with the actual zoom
+#ifdef USE_VERTEX_ID
+    void set_Line_Renderer(int renderer) { lineRenderer = renderer; }  //LINE_RENDERER_AUTO lets the probe choose
+    void set_Line_Join(int join) { lineJoin = join; }  //only used by the quad renderer
+#endif
     void set_zoom_mode(int mode) { if ((mode >= 0) && (mode <= 2)) zoom_mode = mode; }
     void enable_zoom(bool enable);
     void enable_pan(bool enable) { pan_enabled = enable; zoom_enabled = false; }
@@ -92,6 +118,8 @@ public:
     void set_past_value_gain(float value) { pastValueGain = value; }
     void set_trigger_pos(int pos);
     QImage getPlotFigure(void);
+    thumbnailGrabber *get_Thumbnail_Grabber(void) { return thumbs; }
+    void set_persistence(densityMap *map);  //the sweeps collected in map are drawn instead of the signals, nullptr goes back to the signals
     void updateFonts();
 
 protected:
@@ -134,7 +162,26 @@ private:
     QOpenGLTexture *toolTipTex;
     QOpenGLShaderProgram *m_program_tex;
     QOpenGLVertexArrayObject *m_tex_vao;
-    QOpenGLBuffer *m_texVbo;
+    QOpenGLBuffer *m_legendTextVbo;  //text of the overlays, uploaded again only when it has been laid out again
+    QOpenGLBuffer *m_statTextVbo;
+    QOpenGLBuffer *m_toolTipTextVbo;
+    uint64_t legendRevision;  //revisions of the overlays stored in the buffers above
+    uint64_t statRevision;
+    uint64_t toolTipRevision;
+    thumbnailGrabber *thumbs;  //copies the painted frames into the thumbnail of the plot
+
+    //persistence mode: the intensity map is owned by the plot window and drawn through a colormap
+    densityMap *persistence;
+    GLuint persistenceTex;
+    QOpenGLShaderProgram *m_persistence_program;
+    QOpenGLVertexArrayObject *m_persistence_vao;
+    QOpenGLBuffer *m_persistenceVbo;  //quad covering the plot area
+    int m_persistence_transfMatrixLoc;
+    int m_persistence_scaleLoc;
+    int m_persistence_maxCountLoc;
+    QOpenGLBuffer *m_gridTextVbo;  //labels of the grid, kept on the GPU until the grid text changes
+    uint64_t gridRevision;  //revisions of the grid stored in m_gridVbo and m_gridTextVbo
+    uint64_t gridTextRevision;
     bool dotRendering;
 
     Grid *grid;
@@ -149,8 +196,10 @@ private:
     QOpenGLVertexArrayObject *m_ver_vao;  //for VertexID
 
     int m_n_points;  //GL3.2 version
-    int m_instance;  //GL3.2 version
-    int m_in_ver_colorLoc;  //GL3.2 version
+    int m_first_vertex;  //GL3.2 version
+    int m_stride;  //GL3.2 version
+    int m_capacity;  //GL3.2 version
+    int m_sig_style;  //GL3.2 version
     int m_in_ver_paramsLoc;  //GL3.2 version
     int m_ver_transfMatrixLoc;  //GL3.2 version
     int m_ver_screenSizeLoc;  //GL3.2 version
@@ -165,8 +214,25 @@ private:
     int m_transfMatrixLocDot;
 #ifdef USE_VERTEX_ID
     int m_n_points_dot;  //GL3.2 version
-    int m_instance_dot;  //GL3.2 version
+    int m_first_vertex_dot;  //GL3.2 version
+    int m_stride_dot;  //GL3.2 version
+    int m_capacity_dot;  //GL3.2 version
+    int m_sig_style_dot;  //GL3.2 version
     int m_pastvaluegainLocDot;  //GL3.2 version
+    QOpenGLShaderProgram *m_quad_program;  //lines expanded into instanced quads
+    int m_quad_samples;
+    int m_quad_sig_style;
+    int m_quad_paramsLoc;
+    int m_quad_transfMatrixLoc;
+    int m_quad_screenSizeLoc;
+    int m_quad_n_points;
+    int m_quad_first_vertex;
+    int m_quad_stride;
+    int m_quad_capacity;
+    int m_quad_region_size;
+    int m_quad_n_vertices;
+    int m_quad_join;
+    int m_quad_pastvaluegainLoc;
 #endif
     int m_screenSizeLoc;
 
@@ -218,8 +284,53 @@ private:
 
     int N_signals;  //indicates the number of signals that need to be displayed
     int Number_of_Points;  //number of points for the signals to be plotted
+    float x_step;  //set when the signals are decimated, otherwise 0
     QVector<int> indexes;  //all the signals are contained into one single buffer. in this vector we store the location at which each signal starts
 
+#ifdef USE_VERTEX_ID
+    //circular buffer: each signal owns ring_capacity + 1 slots, the sample at absolute position k is stored in slot k % ring_capacity
+    //and the last slot repeats slot 0 so that a line strip can be drawn across the wrap
+    bool ring_mode;  //true when m_signalVbo is organized as circular buffer
+    int ring_capacity;
+    int ring_signals;
+    QVector<uint64_t> ring_begin;  //absolute positions of the samples available in the circular buffer per signal
+    QVector<uint64_t> ring_end;
+    QVector<uint64_t> ring_epoch;
+    QVector<int> ring_offset;  //slot of the first visible sample per signal
+
+    void write_Ring(int i, uint64_t abs_pos, const float *data, int N);
+
+    //all the line strips are drawn with one glMultiDrawArrays and the same for the dots
+    //the style of each signal is read by the shaders from sigStyleTex, the signal itself is found from gl_VertexID
+    QOpenGLFunctions_3_2_Core *gl32;  //nullptr if the functions are not available, the lists are then drawn one by one
+    GLuint sigStyleTex;  //row i: color of signal i, then line width and ring offset
+    int sigStyleRows;  //rows allocated in sigStyleTex
+    QVector<float> sigStyleData;
+    int signal_stride;  //vertices between the beginning of two consecutive signals in m_signalVbo
+    bool equal_spacing;  //false if the signals are not signal_stride apart, they are then drawn one by one
+    QVector<GLint> line_first, dot_first;
+    QVector<GLsizei> line_count, dot_count;
+
+    void prepare_Draw_Lists(int *first_vertex, int *capacity, int *region_size);  //fills the lists and the style texture, returns the uniforms of the shaders
+    void multi_Draw(GLenum mode, QVector<GLint> *first, QVector<GLsizei> *count);
+    void draw_Signals_Separately(QOpenGLShaderProgram *program, int firstLoc, int strideLoc, GLenum mode, bool dots);
+
+    //the lines are drawn by the geometry shader or as instanced quads, the faster one is measured on the first frames of the process
+    int lineRenderer;  //renderer requested for this plot
+    int lineJoin;
+    GLuint signalTbo;  //m_signalVbo seen as buffer texture by the quad renderer
+    GLint maxTboTexels;
+    QElapsedTimer probeTimer;
+    static int probedLineRenderer;  //LINE_RENDERER_AUTO until the probe has finished
+    static int probeFrames[2];  //frames measured for the geometry shader and for the quads
+    static double probeBest[2];
+
+    bool quad_Capable(int n_vertices);
+    int select_Line_Renderer(int n_vertices, bool *probing);
+    void update_Line_Probe(int renderer, double ms);
+    void draw_Lines_Quad(int first_vertex, int capacity, int region_size, int n_vertices, float step_x);
+#endif
+
     //Mouse Cursors during pan and zoom operation
     QCursor *zoomXYCursor;
     QCursor *zoomXCursor;
@@ -229,8 +340,11 @@ private:
     QVector<SigProperty> sig_properties;
 
     void calculate_visible_area(void);
+    void draw_Persistence(void);
     void prepare_zoom_area(void);
     void prepare_grid_buffer(void);  //used when in autoscale
+    void upload_Grid_Buffers(void);
+    void copy_Sig_Properties(QVector<SigProperty> prop);
     void legendSignalToggle(int idx);
     void calculateCoordinateFromCursor(int screen_x, int screen_y, float *coordX, float *coordY);
     void prepareToolTipCrossData();
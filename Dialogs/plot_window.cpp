@@ -33,6 +33,7 @@
 
 #include "plot_window.h"
 #include "glwindow.h"
+#include "Managers/floatkernels.h"
 
 #include <QDebug>
 
@@ -41,7 +42,10 @@ plot_Window::plot_Window(QString title, int index, double frequency, appPreferen
     plotIndex = index;
 
     Autoscale = false;
+    Decimation = true;
     StatsEnabled = false;
+    CumulativeStats = false;
+    resetCumulative = false;
     TriggerEnabled = false;
     trigger_position = 50;
     trigger_mode = 0;
@@ -54,6 +58,9 @@ plot_Window::plot_Window(QString title, int index, double frequency, appPreferen
     autoscaleType = 0;
     pastValueGain = 1.0f;  //no change in luminosity
 
+    sweepAcc = new sweepAccumulator;
+    job.pending = false;
+
     createActions();
 
     layout = new QVBoxLayout;
@@ -88,6 +95,7 @@ plot_Window::plot_Window(QString title, int index, double frequency, appPreferen
     connect(yGridSlider, SIGNAL(valueChanged(int)), this, SLOT (yGridRatioChanged(int)));
     connect(autoscaleSlider, SIGNAL(valueChanged(int)), this, SLOT(autoscaleCenterChanged(int)));
     connect(pastValueSlider, SIGNAL(valueChanged(int)), this, SLOT(pastValueGainChanged(int)));
+    connect(sweepCountSB, SIGNAL (editingFinished()), this, SLOT (sweepCountChanged()));
 
     QLabel *statusBarLbl = new QLabel("CTRL-D for expanding the plot and CTRL-F for fullscreen.");
     statusBar()->addPermanentWidget(statusBarLbl);
@@ -108,6 +116,7 @@ void plot_Window::createSpinBoxes()
     triggerLvlSB = new QDoubleSpinBox(this);
     pastValueSlider = new QSlider(this);
     nSamplesSlider = new QSlider(this);
+    sweepCountSB = new QSpinBox(this);
 
     float min, max;
     int N_Samples;
@@ -160,6 +169,13 @@ void plot_Window::createSpinBoxes()
     triggerLvlSB->setSingleStep(1.0);
     triggerLvlSB->resize(triggerLvlSB->sizeHint());
 
+    sweepCountSB->setMinimum(1);
+    sweepCountSB->setMaximum(10000);
+    sweepCountSB->setValue(sweepAcc->getSweepCount());
+    sweepCountSB->setSingleStep(1);
+    sweepCountSB->setToolTip("Sweeps averaged, or sweeps after which the persistence has faded");
+    sweepCountSB->resize(sweepCountSB->sizeHint());
+
     time = static_cast<double>(N_Samples) / windowFrequency;
     text = "Window time interval is " + locale.toString(time, 'g', 3) + " sec";
     statLabel = new QLabel(text);
@@ -172,6 +188,7 @@ void plot_Window::createSpinBoxes()
     QLabel *autoscaleLabel = new QLabel("Autoscale centering:");
     QLabel *triggerLabel = new QLabel("Trigger value:");
     QLabel *pastValueLabel = new QLabel("Past value brightness:");
+    QLabel *sweepCountLabel = new QLabel("Sweeps:");
 
     QVBoxLayout *vert1 = new QVBoxLayout;
     QVBoxLayout *vert2 = new QVBoxLayout;
@@ -187,7 +204,7 @@ void plot_Window::createSpinBoxes()
     vert3->addWidget(nsamplesLabel); vert3->addWidget(nSamplesSB); vert3->addWidget(nSamplesSlider);
     vert4->addWidget(gridyLabel); vert4->addWidget(yGridSlider);
     vert5->addWidget(gridxLabel); vert5->addWidget(xGridSlider);
-    vert6->addWidget(triggerLabel); vert6->addWidget(triggerLvlSB);
+    vert6->addWidget(triggerLabel); vert6->addWidget(triggerLvlSB); vert6->addWidget(sweepCountLabel); vert6->addWidget(sweepCountSB);
     vert7->addWidget(autoscaleLabel); vert7->addWidget(autoscaleSlider);
     vert8->addWidget(pastValueLabel); vert8->addWidget(pastValueSlider);
 
@@ -212,109 +229,87 @@ void plot_Window::thread_prepare_signal(int i, QVector<int> points, QVector<floa
 
     int start = points[0];
     int end = points[1];
-    int n_p;
+    int columns = points[2];  //0 when the samples are not decimated
     float** buff_ptr = static_cast<float**>(pointers[0]);
     float* line_widths = static_cast<float*>(pointers[2]);
-
-    int k;
+    Signal_Data** sources = static_cast<Signal_Data**>(pointers[3]);
+    signalSnapshot* snaps = static_cast<signalSnapshot*>(pointers[4]);
+    int averaged = points[3];  //1 when buff_ptr holds the average of the sweeps instead of the samples
+    statSummary st;
+#ifndef USE_VERTEX_ID
+    int j, k, n_p;
+    float index;
+    float step_x = floats[0];
+    std::vector<float> decimated;
+#endif
 
     if (i < sig_properties.count())
         sig_properties[i].line_width = line_widths[i];
 
-    //calculates statistics
-    try   //insert to catch out of buffer accesses and/or divisions by zero
-    {
-        if (StatsEnabled == true)
-        {
-            sig_properties[i].stats.n_samples = 0;
-            sig_properties[i].stats.mean = 0;
-            sig_properties[i].stats.max = buff_ptr[i][start];
-            sig_properties[i].stats.min = buff_ptr[i][start];
-
-            if (StatsEnabled == true)  //we can calculate statistics
-            {
-                for (k = start; k <= end; k++)
-                {
-                    if (buff_ptr[i][k] > sig_properties[i].stats.max)
-                        sig_properties[i].stats.max = buff_ptr[i][k];
-                    if (buff_ptr[i][k] < sig_properties[i].stats.min)
-                        sig_properties[i].stats.min = buff_ptr[i][k];
-                    sig_properties[i].stats.n_samples += 1;
-                    if (sig_properties[i].stats.n_samples != 0)
-                        sig_properties[i].stats.mean += ((buff_ptr[i][k] - sig_properties[i].stats.mean) / static_cast<float>(sig_properties[i].stats.n_samples));  //updates average
-                }
-            }
-        }
-    } catch (...)
+    //the statistics are kept by the signal while receiving the data, here we only read the ones of the visible window
+    if ((StatsEnabled == true) && (end >= start))
     {
-
+        if (CumulativeStats == true)
+            st = sources[i]->Get_Cumulative_Stats();
+        else if (averaged == 1)
+            st = runningStats::summarize(buff_ptr[i] + start, static_cast<uint32_t>(end - start + 1));
+        else
+            st = sources[i]->Get_Stats(&snaps[i], static_cast<uint32_t>(start), static_cast<uint32_t>(end));
+        sig_properties[i].stats.min = st.min;
+        sig_properties[i].stats.max = st.max;
+        sig_properties[i].stats.mean = static_cast<float>(st.mean);
+        sig_properties[i].stats.rms = static_cast<float>(runningStats::getRMS(&st));
+        sig_properties[i].stats.std = static_cast<float>(runningStats::getStd(&st));
+        sig_properties[i].stats.n_samples = static_cast<long>(st.n);
     }
 
 #ifdef USE_VERTEX_ID
-    n_p = end - start + 1;
-    memcpy(signal_buffer.data() + (i * n_p), buff_ptr[i] + start, n_p * sizeof(float));
+    if (columns > 0)
+        m4Decimator::decimate(buff_ptr[i] + start, end - start + 1, columns, signal_buffer.data() + (i * columns * M4_POINTS_PER_COLUMN));
 #else
     index = -0.95f;
-    k = 0;
-    n_p = end - start + 1;
-    for (j = start; j <= end; j++)
+    if (columns > 0)
     {
-        signal_buffer[(i * n_p * 2) + (k * 2)] = index; signal_buffer[(i * n_p * 2) + (k * 2)+1] = buff_ptr[i][j];
-        index += step_x;
-        k++;
+        n_p = columns * M4_POINTS_PER_COLUMN;
+        decimated.resize(static_cast<size_t>(n_p));
+        m4Decimator::decimate(buff_ptr[i] + start, end - start + 1, columns, decimated.data());
+        for (k = 0; k < n_p; k++)
+        {
+            signal_buffer[(i * n_p * 2) + (k * 2)] = index; signal_buffer[(i * n_p * 2) + (k * 2)+1] = decimated[static_cast<size_t>(k)];
+            index += step_x;
+        }
+    }
+    else
+    {
+        k = 0;
+        n_p = end - start + 1;
+        for (j = start; j <= end; j++)
+        {
+            signal_buffer[(i * n_p * 2) + (k * 2)] = index; signal_buffer[(i * n_p * 2) + (k * 2)+1] = buff_ptr[i][j];
+            index += step_x;
+            k++;
+        }
     }
-#endif
 
     signal_buffer_count = signal_buffer.count();
+#endif
 }
 
 void plot_Window::find_min_max_signals(int n_signals, int start, int end, float **buff_ptr, float *Min, float *Max)
 {
-    float min, max;
-    int i, j;
-    bool found;
-
-    min = 0;
-    max = 1;
-    found = false;
-    //we initialize min and max to the first valid value of the first signal
-    for (i = 0; i < n_signals; i++)
-        for (j = start; j <= end; j++)
-        {
-            if ((std::isnan(buff_ptr[i][j]) == false) && (std::isinf(buff_ptr[i][j]) == false))
-            {
-                found = true;
-                min = buff_ptr[i][j];
-                max = min;
-            }
-        }
-
-    if (found == true)
+    //min and max of the finite samples of all the signals, 0 - 1 if there are none
+    if (floatKernels::rangeOfSignals(n_signals, start, end, buff_ptr, Min, Max) == false)
     {
-        for (i = 0; i < n_signals; i++)
-            for (j = start; j <= end; j++)
-            {
-                if ((std::isnan(buff_ptr[i][j]) == false) && (std::isinf(buff_ptr[i][j]) == false))
-                {
-                    if (buff_ptr[i][j] < min)
-                        min = buff_ptr[i][j];
-                    if (buff_ptr[i][j] > max)
-                        max = buff_ptr[i][j];
-                }
-            }
+        *Min = 0;
+        *Max = 1;
     }
-    else {
-        min = 0;
-        max = 1;
-    }
-
-    *Min = static_cast<float>(min);
-    *Max = static_cast<float>(max);
 }
 
 plot_Window::~plot_Window()
 {
+    prepareTasks.wait();  //the tasks of a preparation not completed use the buffers of the window
     delete glPlot;
+    delete sweepAcc;
 }
 
 void plot_Window::addSignal(uint32_t index, QString name, QColor color)
@@ -331,6 +326,8 @@ void plot_Window::addSignal(uint32_t index, QString name, QColor color)
     p.stats.min = 0.0;
     p.stats.n_samples = 0;
     p.stats.mean = 0.0;
+    p.stats.rms = 0.0;
+    p.stats.std = 0.0;
     p.triggerAct = new QAction(this);
     p.triggerAct->setText(p.name);
     p.triggerAct->setCheckable(true);
@@ -403,16 +400,20 @@ void plot_Window::setGrid(bool en)
     xTicksAct->setEnabled(en);
 }
 
-int plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, float **buff_ptr, QColor *colors, float *line_widths)
+int plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, float **buff_ptr, QColor *colors, float *line_widths, Signal_Data **sources, signalSnapshot *snaps)
 {
     int i; int n_p;
+    int columns, n_out;  //pixel columns used by the decimation and points sent per signal
     float step_x;
     float x_axis;
-    bool finished;
     float min, max;  //used for autoscale
     int start, middle, end;
     bool trigger_found;
     float distance;
+    bool sweeping, averaging;  //the triggered sweeps are collected, the average is displayed instead of the samples
+
+    if (job.pending == true)  //the tasks of the previous preparation still use the buffers
+        complete_Signal_Data();
 
     if (n_signals != sig_properties.count())  //we have a mismatch between the number of signals passed and the number of signals declared in the plot => do not plot anything
         return -1;
@@ -422,6 +423,27 @@ int plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, float
     if (n_points < 2)
         return -1;
 
+    //the arguments are copied since the tasks use them after this function has returned, the snapshots keep the samples alive
+    job.buff.resize(n_signals); job.colors.resize(n_signals); job.widths.resize(n_signals);
+    job.sources.resize(n_signals); job.snaps.resize(n_signals);
+    for (i = 0; i < n_signals; i++)
+    {
+        job.buff[i] = buff_ptr[i];
+        job.colors[i] = colors[i];
+        job.widths[i] = line_widths[i];
+        job.sources[i] = sources[i];
+        job.snaps[i] = snaps[i];
+    }
+    buff_ptr = job.buff.data(); colors = job.colors.data(); line_widths = job.widths.data();
+    sources = job.sources.data(); snaps = job.snaps.data();
+
+    if (resetCumulative == true)
+    {
+        for (i = 0; i < n_signals; i++)
+            sources[i]->Reset_Cumulative_Stats();
+        resetCumulative = false;
+    }
+
     //we prepare the buffer by using resize (faster than using append)
     if (n_points <= glPlot->get_Grid()->get_N_points()) //n_points tells us how many points are contained in the signal buffers
     {
@@ -436,47 +458,38 @@ int plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, float
         end = n_points - 1;
     }
 
+    //the sweeps are collected by process_Sweeps while receiving the data, here they are only drawn
+    sweeping = false;
+    averaging = false;
+    if ((sweepAcc->getMode() != SWEEP_MODE_OFF) && (TriggerEnabled == true) && (triggerSourceIndex != -1))
+    {
+        sweeping = true;
+        if ((sweepAcc->getMode() == SWEEP_MODE_AVERAGE) && (sweepAcc->getSweeps() > 0))
+        {
+            averaging = true;
+            for (i = 0; i < n_signals; i++)
+                buff_ptr[i] = sweepAcc->getAverage(i);  //from here on the average is plotted as if it were the signals
+            n_points = sweepAcc->getLength();
+            n_p = n_points;
+            start = 0;
+            end = n_points - 1;
+        }
+    }
+    if ((sweeping == true) && (sweepAcc->getMode() == SWEEP_MODE_PERSISTENCE))
+        glPlot->set_persistence(sweepAcc->getPersistence());
+    else
+        glPlot->set_persistence(nullptr);
+
     //in this case, before we proceed we have to look for a trigger event and establish the start and end position of the buffer
-    if ((TriggerEnabled == true) && (triggerSourceIndex != -1) && (n_points > glPlot->get_Grid()->get_N_points()))  //trigger is enabled, a source has been selected, there are more points than the grid
+    if ((TriggerEnabled == true) && (triggerSourceIndex != -1) && (averaging == false) && (n_points > glPlot->get_Grid()->get_N_points()))  //trigger is enabled, a source has been selected, there are more points than the grid
     {
         //first we define the portion of the buffer we are going to scan
         middle = start + (n_p >> 1);  //we get the middle index. we will first look for trigger event moving left and if it is not found move right
-        trigger_found = false; i = middle;
-        while ((trigger_found == false) && (i >= (start + 1)))
-        {
-            if (trigger_mode == 0)  // we are looking for a rise event
-            {
-                if (((buff_ptr[triggerSourceIndex][i] - trigger_level) >= 0) && ((buff_ptr[triggerSourceIndex][i - 1] - trigger_level) < 0))  //trigger found
-                    trigger_found = true;
-            }
-            if (trigger_mode == 1)  // we are looking for a fall event
-            {
-                if (((buff_ptr[triggerSourceIndex][i] - trigger_level) <= 0) && ((buff_ptr[triggerSourceIndex][i - 1] - trigger_level) > 0))  //trigger found
-                    trigger_found = true;
-            }
-            i--;
-        }
-        if (trigger_found == true)
-            i = i + 1;
+        i = floatKernels::findLastCrossing(buff_ptr[triggerSourceIndex], start + 1, middle + 1, trigger_level, trigger_mode);
         //if we have not found the trigger, we try to move towards right
-        if (trigger_found == false)
-        {
-            i = middle;
-            while ((trigger_found == false) && (i < (n_points - 1)))
-            {
-                if (trigger_mode == 0)  // we are looking for a rise event
-                {
-                    if (((buff_ptr[triggerSourceIndex][i] - trigger_level) <= 0) && ((buff_ptr[triggerSourceIndex][i + 1] - trigger_level) > 0))  //trigger found
-                        trigger_found = true;
-                }
-                if (trigger_mode == 1)  // we are looking for a fall event
-                {
-                    if (((buff_ptr[triggerSourceIndex][i] - trigger_level) >= 0) && ((buff_ptr[triggerSourceIndex][i + 1] - trigger_level) < 0))  //trigger found
-                        trigger_found = true;
-                }
-                i++;
-            }
-        }
+        if (i == -1)
+            i = floatKernels::findCrossing(buff_ptr[triggerSourceIndex], middle + 1, n_points, trigger_level, trigger_mode);
+        trigger_found = (i != -1);
         //if we still have not found the trigger, we do not do anything and plot the last samples
         //otherwise we define the indexes around the found index and plot that window
         if (trigger_found == true)
@@ -509,53 +522,138 @@ int plot_Window::parallel_prepare_Signal_Data(int n_signals, int n_points, float
 
     x_axis = glPlot->get_Grid()->get_X_Axis();
 
+    Number_of_Points = end - start + 1;
+    n_p = Number_of_Points;
+    step_x = glPlot->get_Grid()->get_StepX();
+
+    //when many samples fall on the same pixel column only the first, min, max and last sample of each column are sent to the GPU
+    columns = 0;
+    if ((Decimation == true) && (glPlot->get_Grid()->get_N_points() > 1))
+    {
+        columns = static_cast<int>((static_cast<int64_t>(glPlot->get_Pixel_Columns()) * (n_p - 1)) / (glPlot->get_Grid()->get_N_points() - 1));
+        if (m4Decimator::isWorthwhile(n_p, columns) == false)
+            columns = 0;
+    }
+    n_out = n_p;
+    if (columns > 0)
+    {
+        n_out = columns * M4_POINTS_PER_COLUMN;
+        step_x = step_x * static_cast<float>(n_p - 1) / static_cast<float>(n_out - 1);  //the decimated points cover the same width of the samples
+    }
+
 #ifdef USE_VERTEX_ID
-    signal_buffer.resize(n_signals * (end - start + 1));  //not times 2, we save only Y values now
+    if (columns > 0)
+        signal_buffer.resize(n_signals * n_out);  //without decimation the samples are streamed directly from buff_ptr
 #else
-    signal_buffer.resize(n_signals * (end - start + 1) * 2);
+    signal_buffer.resize(n_signals * n_out * 2);
 #endif
 
-    Number_of_Points = end - start + 1;
-    n_p = Number_of_Points;
-
     indexes.clear();
     indexes.resize(n_signals);  //indexes to the locations of each signal in the buffer
 
-    QVector<QFuture<void>> res;
-
-    res.resize(n_signals);
-
     for (i = 0; i < n_signals; i++)
-        indexes[i] = i * (end - start + 1);
-
-    step_x = glPlot->get_Grid()->get_StepX();
+        indexes[i] = i * n_out;
 
     //Create arguments
     QVector<int> points;
     QVector<float> floats;
     QVector<void*> pointers;
 
-    points.push_back(start); points.push_back(end);
+    points.push_back(start); points.push_back(end); points.push_back(columns);
+    if (averaging == true)
+        points.push_back(1);
+    else
+        points.push_back(0);
     floats.push_back(step_x); floats.push_back(x_axis);
     pointers.push_back(static_cast<void*>(buff_ptr));
     pointers.push_back(static_cast<void*>(colors)); pointers.push_back(static_cast<void*>(line_widths));
+    pointers.push_back(static_cast<void*>(sources)); pointers.push_back(static_cast<void*>(snaps));
+
+    //I load the data in the right format from buff_ptr, the signals of this and of the other plots are prepared by the worker pool together
+    workerPool::parallelFor(&prepareTasks, n_signals, n_p, std::bind(&plot_Window::thread_prepare_signal, this, std::placeholders::_1, points, floats, pointers));
+
+    job.pending = true;
+    job.n_signals = n_signals;
+    job.n_p = n_p;
+    job.n_out = n_out;
+    job.columns = columns;
+    job.start = start;
+    job.step_x = step_x;
+    job.averaging = averaging;
+
+    return 0;
+}
+
+int plot_Window::process_Sweeps(int n_signals, int n_points, float **buff_ptr, const signalSnapshot *snaps)
+{
+    int i;
+    QVector<bool> visible;
+
+    if ((sweepAcc->getMode() == SWEEP_MODE_OFF) || (TriggerEnabled == false) || (triggerSourceIndex == -1))
+        return 0;
+
+    if (n_signals != sig_properties.count())  //we have a mismatch between the number of signals passed and the number of signals declared in the plot
+        return 0;
 
-    //I load the data in the right format from buff_ptr
-    for (i = 0; i < n_signals; i++)  //Launches the parallel threads
+    visible.resize(n_signals);
+    for (i = 0; i < n_signals; i++)
+        visible[i] = (sig_properties[i].lineRendering == true) || (sig_properties[i].dotRendering == true);
+
+    sweepAcc->setTrigger(triggerSourceIndex, trigger_mode, trigger_level, trigger_position);
+    sweepAcc->setMapping(glPlot->get_Grid()->get_N_points(), -0.95f, glPlot->get_Grid()->get_StepX(), glPlot->get_Grid()->get_ConvFact(), glPlot->get_Grid()->get_X_Axis());
+
+    return sweepAcc->process(n_signals, n_points, buff_ptr, snaps, visible);
+}
+
+int plot_Window::complete_Signal_Data()
+{
+#ifdef USE_VERTEX_ID
+    int i;
+    QVector<uint64_t> abs_start;
+    QVector<uint64_t> epochs;
+#endif
+
+    if (job.pending == false)
+        return -1;
+
+    //blocks till the signals are prepared, this thread executes the queued tasks meanwhile
+    prepareTasks.wait();
+    job.pending = false;
+
+#ifdef USE_VERTEX_ID
+    if (job.columns > 0)
     {
-        res[i] = QtConcurrent::run(this, &plot_Window::thread_prepare_signal, i, points, floats, pointers);
+        glPlot->set_X_Step(job.step_x);
+        glPlot->parallel_prepare_Signal_Buffer(job.n_signals, job.n_out, &signal_buffer, sig_properties, indexes);
     }
-
-    //waits for threads to finish
-    finished = false;
-    while (finished == false)
+    else
     {
-        finished = true;
-        for (i = 0; i < n_signals; i++)
-            finished = finished && res[i].isFinished();
+        //only the samples which are not yet on the GPU are sent, the absolute positions tell which ones they are
+        abs_start.resize(job.n_signals);
+        epochs.resize(job.n_signals);
+        for (i = 0; i < job.n_signals; i++)
+        {
+            abs_start[i] = job.snaps[i].first + static_cast<uint64_t>(job.start);
+            epochs[i] = job.snaps[i].stats_epoch;
+            if (epochs[i] == SNAPSHOT_NO_EPOCH)  //part of the window comes from the history without absolute positions, the version tells when it changes
+            {
+                abs_start[i] = 0;
+                epochs[i] = (static_cast<uint64_t>(1) << 62) | job.snaps[i].version;
+            }
+            if (job.averaging == true)  //the whole average changes at every sweep, the revision forces its upload
+            {
+                abs_start[i] = 0;
+                epochs[i] = (static_cast<uint64_t>(1) << 63) | sweepAcc->getRevision();
+            }
+        }
+        glPlot->set_X_Step(0.0f);
+        glPlot->stream_Signal_Buffer(job.n_signals, job.n_p, job.buff.data(), job.start, abs_start, epochs, sig_properties);
     }
+#else
+    glPlot->parallel_prepare_Signal_Buffer(job.n_signals, job.n_out, &signal_buffer, sig_properties, indexes);
+#endif
 
-    glPlot->parallel_prepare_Signal_Buffer(n_signals, n_p, &signal_buffer, sig_properties, indexes);
+    job.snaps.clear();  //releases the samples
 
     return 0;
 }
@@ -629,6 +727,15 @@ void plot_Window::closeWindow()
     close();
 }
 
+void plot_Window::triggerDecimation()
+{
+    if (decimationAct->isChecked() == true)
+        Decimation = true;
+    else
+        Decimation = false;
+    emit replot(plotIndex);
+}
+
 void plot_Window::triggerAutoscale()
 {
     if (autoscaleAct->isChecked() == true)
@@ -722,6 +829,11 @@ void plot_Window::triggerStats()
     }
 }
 
+void plot_Window::triggerCumulativeStats()
+{
+    CumulativeStats = cumulativeStatAct->isChecked();
+}
+
 void plot_Window::triggerRise()
 {
     if (triggerRiseAct->isChecked() == true)
@@ -765,7 +877,10 @@ void plot_Window::triggerResetStats()
         sig_properties[i].stats.mean = 0.0;
         sig_properties[i].stats.min = 0.0;
         sig_properties[i].stats.max = 0.0;
+        sig_properties[i].stats.rms = 0.0;
+        sig_properties[i].stats.std = 0.0;
     }
+    resetCumulative = true;
 }
 
 void plot_Window::triggerPosRight()
@@ -851,6 +966,35 @@ void plot_Window::triggerSourceChanged()
         triggerSourceIndex = idx;
 }
 
+void plot_Window::triggerPersistence()
+{
+    if (persistenceAct->isChecked() == true)
+    {
+        averageAct->setChecked(false);
+        sweepAcc->setMode(SWEEP_MODE_PERSISTENCE);
+    }
+    else
+        sweepAcc->setMode(SWEEP_MODE_OFF);
+    emit replot(plotIndex);
+}
+
+void plot_Window::triggerAverage()
+{
+    if (averageAct->isChecked() == true)
+    {
+        persistenceAct->setChecked(false);
+        sweepAcc->setMode(SWEEP_MODE_AVERAGE);
+    }
+    else
+        sweepAcc->setMode(SWEEP_MODE_OFF);
+    emit replot(plotIndex);
+}
+
+void plot_Window::sweepCountChanged()
+{
+    sweepAcc->setSweepCount(sweepCountSB->value());
+}
+
 void plot_Window::minYSBchanged()
 {
     if (minYSB->isEnabled() == true)
@@ -1088,6 +1232,27 @@ void plot_Window::createActions()
     triggerPosCenterAct->setText("Reset to center");
     connect(triggerPosCenterAct, &QAction::triggered, this, &plot_Window::triggerPosCenter);
 
+    persistenceAct = new QAction(this);
+    persistenceAct->setCheckable(true);
+    persistenceAct->setChecked(false);
+    persistenceAct->setToolTip("Accumulate every triggered sweep in a fading intensity map (trigger needed)");
+    persistenceAct->setText("&Persistence");
+    connect(persistenceAct, &QAction::triggered, this, &plot_Window::triggerPersistence);
+
+    averageAct = new QAction(this);
+    averageAct->setCheckable(true);
+    averageAct->setChecked(false);
+    averageAct->setToolTip("Show the average of the last triggered sweeps (trigger needed)");
+    averageAct->setText("Sweep &Average");
+    connect(averageAct, &QAction::triggered, this, &plot_Window::triggerAverage);
+
+    decimationAct = new QAction(this);
+    decimationAct->setCheckable(true);
+    decimationAct->setChecked(true);
+    decimationAct->setToolTip("Draw only first, min, max and last sample of each pixel column when there are more than " + QString::number(M4_AUTO_THRESHOLD) + " samples per column");
+    decimationAct->setText("&Decimation");
+    connect(decimationAct, &QAction::triggered, this, &plot_Window::triggerDecimation);
+
     zoomXYAct = new QAction(this);
     zoomXYAct->setIcon(QIcon(":/Icons/Icons/zoomXY.ico"));
     zoomXYAct->setCheckable(true);
@@ -1136,6 +1301,13 @@ void plot_Window::createActions()
     statAct->setText("&Statistics");
     connect(statAct, &QAction::triggered, this, &plot_Window::triggerStats);
 
+    cumulativeStatAct = new QAction(this);
+    cumulativeStatAct->setCheckable(true);
+    cumulativeStatAct->setChecked(false);  //statistics of the visible window by default
+    cumulativeStatAct->setToolTip("Statistics of all the samples received since the last reset");
+    cumulativeStatAct->setText("&Cumulative statistics");
+    connect(cumulativeStatAct, &QAction::triggered, this, &plot_Window::triggerCumulativeStats);
+
     resetStatAct = new QAction(this);
     resetStatAct->setIcon(QIcon(":/Icons/Icons/resetStats.ico"));
     resetStatAct->setCheckable(false);
@@ -1185,6 +1357,7 @@ void plot_Window::createActions()
     fileMenu->addAction(closeAct);
 
     viewMenu->addAction(autoscaleAct);
+    viewMenu->addAction(decimationAct);
     viewMenu->addSeparator();
     viewMenu->addAction(zoomXYAct);
     viewMenu->addAction(zoomXAct);
@@ -1198,6 +1371,8 @@ void plot_Window::createActions()
     toolMenu->addAction(triggerPosLeftAct);
     toolMenu->addAction(triggerPosRightAct);
     toolMenu->addAction(triggerPosCenterAct);
+    toolMenu->addAction(persistenceAct);
+    toolMenu->addAction(averageAct);
     toolMenu->addSeparator();
     toolMenu->addAction(gridAct);
     toolMenu->addAction(yTicksAct);
@@ -1206,5 +1381,6 @@ void plot_Window::createActions()
     toolMenu->addSeparator();
     toolMenu->addAction(legendAct);
     toolMenu->addAction(statAct);
+    toolMenu->addAction(cumulativeStatAct);
     toolMenu->addAction(resetStatAct);
 }
@@ -62,16 +62,31 @@
 #include <QKeyEvent>
 #include <QDockWidget>
 #include <QStatusBar>
-#include <QFuture>
-#include <QtConcurrent/QtConcurrent>
 
 #include "definitions.h"
 #include "Creators/statcreator.h"
 #include "FontManager/fontmanager.h"
 #include "Managers/prefmanager.h"
+#include "Managers/signal_data.h"
+#include "Managers/decimator.h"
+#include "Managers/sweepaccumulator.h"
+#include "Managers/workerpool.h"
 #include "Dialogs/glwindow.h"
 #include "Creators/legendCreator.h"
 
+typedef struct _prepareJob
+{
+    bool pending;  //the tasks have been launched and the buffers not sent to the GPU yet
+    int n_signals, n_p, n_out, columns, start;
+    float step_x;
+    bool averaging;
+    //copies of the arguments of parallel_prepare_Signal_Data, used by the tasks after it has returned
+    QVector<float*> buff;
+    QVector<QColor> colors;
+    QVector<float> widths;
+    QVector<Signal_Data*> sources;
+    QVector<signalSnapshot> snaps;  //keep the samples alive
+} prepareJob;
 
 class plot_Window : public QMainWindow
 {
@@ -87,12 +102,18 @@ public:
     void clearAllSignal();
     void setWindowFrequency(double freq) { if (freq > 0) windowFrequency = freq; }
     void setNPoints(int N);
+    int getNPoints() { return glPlot->get_Grid()->get_N_points(); }  //samples displayed, read from the history as well when the signal buffer is shorter
     void setTitle(QString title);
 
     bool isGridEnabled() { return glPlot->get_Grid()->getDrawGrid(); }
     void setGrid(bool en);
 
-    int parallel_prepare_Signal_Data(int n_signals, int n_points, float** buff_ptr, QColor* colors, float *line_widths);  //points to n_signals buffers and indicates how many points to be prepared
+    int parallel_prepare_Signal_Data(int n_signals, int n_points, float** buff_ptr, QColor* colors, float *line_widths, Signal_Data **sources, signalSnapshot *snaps);  //points to n_signals buffers and indicates how many points to be prepared, the statistics are read from the sources
+    //the preparation started by parallel_prepare_Signal_Data runs on the worker pool, this waits for it and sends the buffers to the GPU
+    //-1 if no preparation has been started
+    int complete_Signal_Data(void);
+    int process_Sweeps(int n_signals, int n_points, float **buff_ptr, const signalSnapshot *snaps);  //collects the triggered sweeps of the received samples, the signals are aligned by index, returns the sweeps found
+    qint64 getStagingMemory() { return static_cast<qint64>(signal_buffer.capacity()) * static_cast<qint64>(sizeof(GLfloat)); }  //bytes allocated for the buffer sent to the GPU
 
     void update(void);
     void updateFonts() { glPlot->updateFonts(); }
@@ -105,12 +126,14 @@ private slots:
     void exportFigure(void);
     void closeWindow(void);
     void triggerAutoscale(void);
+    void triggerDecimation(void);
     void triggerZoomXY(void);
     void triggerZoomX(void);
     void triggerZoomY(void);
     void triggerPan(void);
     void triggerLegend(void);
     void triggerStats(void);
+    void triggerCumulativeStats(void);
     void triggerRise(void);
     void triggerFall(void);
     void triggerResetStats(void);
@@ -122,6 +145,8 @@ private slots:
     void triggerXTicks(void);
     void triggerTitle(void);
     void triggerSourceChanged(void);
+    void triggerPersistence(void);
+    void triggerAverage(void);
     void minYSBchanged();
     void maxYSBchanged();
     void nsamplesSBchanged();
@@ -132,6 +157,7 @@ private slots:
     void yGridRatioChanged(int);
     void autoscaleCenterChanged(int);
     void pastValueGainChanged(int);
+    void sweepCountChanged();
     void updateSigProperties(QVector<SigProperty> properties);
 
 signals:
@@ -164,6 +190,7 @@ private:
     QAction *xTicksAct;
     QAction *titleAct;
     QAction *autoscaleAct;
+    QAction *decimationAct;
     QAction *triggerRiseAct;
     QAction *triggerFallAct;
     QAction *triggerPosRightAct;
@@ -172,12 +199,15 @@ private:
     QVector<QAction*> triggerSignals;
     QActionGroup *triggerGroup;
     QAction *triggerSourceSignal;
+    QAction *persistenceAct;
+    QAction *averageAct;
     QAction *zoomXYAct;
     QAction *zoomXAct;
     QAction *zoomYAct;
     QAction *panAct;
     QAction *legendAct;
     QAction *statAct;
+    QAction *cumulativeStatAct;
     QAction *resetStatAct;    
 
     QWidget *centralWidget;
@@ -192,6 +222,7 @@ private:
     QSlider *pastValueSlider;
     QSlider *nSamplesSlider;
     QDoubleSpinBox *triggerLvlSB;
+    QSpinBox *sweepCountSB;
     QSpinBox *nSamplesSB;
     QGroupBox *groupSB;
     QVBoxLayout *layoutSB;
@@ -203,12 +234,16 @@ private:
     int Number_of_Points;
 
     bool Autoscale;
+    bool Decimation;  //M4 decimation when there are many more samples than pixel columns
     int autoscaleType;  //from 0 to 100% (0 exact positioning)
     bool StatsEnabled;
+    bool CumulativeStats;  //statistics of all the received samples instead of the visible window
+    bool resetCumulative;  //the cumulative statistics of the signals are reset at the next preparation
     bool TriggerEnabled;
     float trigger_level;
     int trigger_mode;  //0 => rising; 1 => falling
     int trigger_position;  //horizontal offset of display => the trigger point will be represented at this position. it can take values from 0 to 100 in percentage with the number of points of the grid
+    sweepAccumulator *sweepAcc;  //persistence and averaging of all the triggered sweeps
 
     double windowFrequency;
 
@@ -218,6 +253,8 @@ private:
     QVector<int> indexes;  //all the signals are contained into one single buffer. in this vector we store the location at which each signal starts
     QVector<GLfloat> signal_buffer;  //contains the buffer of the signals to be displayed => a multiple of N_signals and N_points
     int signal_buffer_count;
+    taskGroup prepareTasks;  //tasks preparing the signals
+    prepareJob job;
     void thread_prepare_signal(int i, QVector<int> points, QVector<float> floats, QVector<void*> pointers);
     void find_min_max_signals(int n_signals, int start, int end, float** buff_ptr, float* Min, float *Max);
 };
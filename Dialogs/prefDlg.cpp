@@ -190,6 +190,12 @@ void prefDlg::changefontResolution()
     preferences.font_resolution = fontresSB->value();
 }
 
+void prefDlg::changeSdfFonts()
+{
+    preferences.sdf_fonts = sdfFontsCB->isChecked();
+    fontresSB->setEnabled(preferences.sdf_fonts == false);  //a distance field is sharp at every size
+}
+
 void prefDlg::changeNPoints()
 {
     preferences.N_points = npointsSB->value();
@@ -432,6 +438,10 @@ void prefDlg::createGridWidget()
     fontresSB->setMinimum(4); fontresSB->setMaximum(64);
     connect(fontresSB, &QSpinBox::editingFinished, this, &prefDlg::changefontResolution);
 
+    sdfFontsCB = new QCheckBox(this);
+    sdfFontsCB->setText("Resolution independent fonts"); sdfFontsCB->setCheckable(true);
+    connect(sdfFontsCB, &QCheckBox::toggled, this, &prefDlg::changeSdfFonts);
+
     addFontSB = new QPushButton(this);
     addFontSB->setText("Add fonts..:");
     connect(addFontSB, &QPushButton::clicked, this, &prefDlg::addFonts);
@@ -443,7 +453,7 @@ void prefDlg::createGridWidget()
     v2->addWidget(plotheightlabel); v2->addWidget(plotheightSB);
     QHBoxLayout *hwdw1 = new QHBoxLayout; hwdw1->addLayout(v1); hwdw1->addLayout(v2);
     layoutWindow->addLayout(hwdw1);
-    QVBoxLayout *v3 = new QVBoxLayout; v3->addWidget(fontreslabel); v3->addWidget(fontresSB);
+    QVBoxLayout *v3 = new QVBoxLayout; v3->addWidget(fontreslabel); v3->addWidget(fontresSB); v3->addWidget(sdfFontsCB);
     QVBoxLayout *v4 = new QVBoxLayout; v4->addStretch(); v4->addWidget(addFontSB);
     QHBoxLayout *hwdw2 = new QHBoxLayout; hwdw2->addLayout(v3); hwdw2->addLayout(v4);
     layoutWindow->addLayout(hwdw2);
@@ -726,6 +736,8 @@ void prefDlg::updateValues()
     plotwidthSB->setValue(preferences.plot_width_size);
     plotheightSB->setValue(preferences.plot_height_size);
     fontresSB->setValue(preferences.font_resolution);
+    sdfFontsCB->setChecked(preferences.sdf_fonts);
+    fontresSB->setEnabled(preferences.sdf_fonts == false);
 
     npointsSB->setValue(preferences.N_points);
     maxYSB->setValue(static_cast<double>(preferences.max_Y));
@@ -89,6 +89,7 @@ public slots:
     void changeWindowWidth(void);
     void changeWindowHeight(void);
     void changefontResolution(void);
+    void changeSdfFonts(void);
 
     void changeNPoints(void);
     void changeMaxY(void);
@@ -171,6 +172,7 @@ private:
     QSpinBox *gridLWSB;
     QSpinBox *axisLWSB;
     QCheckBox *smoothCB;
+    QCheckBox *sdfFontsCB;
     QPushButton *zoomColorPB;
     //title
     QSpinBox *titleSizeSB;
@@ -53,6 +53,14 @@ XY_GLWindow::XY_GLWindow(QWidget *parent, QString title, appPreferencesStruct *p
     plotTitle = title;
 
     N_signals = 0;
+    gridRevision = 0;
+    gridTextRevision = 0;
+
+    m_program = nullptr;  //the resources are created in initializeGL
+    gridTex = nullptr;
+    legendTex = nullptr;
+    toolTipTex = nullptr;
+
     Number_of_Points = 0;
 
     pastValueGain = 1.0f;
@@ -87,12 +95,20 @@ XY_GLWindow::XY_GLWindow(QWidget *parent, QString title, appPreferencesStruct *p
 
     tooltip = new toolTipCreator(preferences->toolTip_font, fontMgr);
 
+    thumbs = new thumbnailGrabber(this);  //deleted with the window
+
+    density = new densityMap(DENSITY_BINS);
+    densityMode = false;
+    densityTex = 0;
+    m_density_program = nullptr;
+
     this->setCursor(Qt::ArrowCursor);
 }
 
 XY_GLWindow::~XY_GLWindow()
 {
     cleanup();
+    delete density;
 }
 
 void XY_GLWindow::setGridMinY(double minY)
@@ -122,6 +138,8 @@ void XY_GLWindow::setGridTimeBase(double TimeBase)
 
 void XY_GLWindow::initializeGL()
 {
+    GLfloat quad[8] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};  //plot area covered by the density histogram
+
     makeCurrent();
     QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
 
@@ -136,15 +154,7 @@ void XY_GLWindow::initializeGL()
     connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &XY_GLWindow::cleanup);
 
     //Line Program Declaration
-    m_program = new QOpenGLShaderProgram;
-    if (m_program->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Line.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_program->addShaderFromSourceFile(QOpenGLShader::Geometry, ":/shaders/Shaders/Line.gsh") == false)
-        qDebug("Error compiling Geometry Shader");
-    if (m_program->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Line.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_program->link() == false)
-        qDebug("Shaders were not linked correctly\n");
+    m_program = glResourceManager::getProgram(":/shaders/Shaders/Line.vsh", ":/shaders/Shaders/Line.gsh", ":/shaders/Shaders/Line.fsh");
     if (m_program->bind() == false)
         qDebug("Shader not correctly bound\n");
 
@@ -177,15 +187,7 @@ void XY_GLWindow::initializeGL()
     m_program->release();
 
     //XY-Line Program Declaration
-    m_xy_program = new QOpenGLShaderProgram;
-    if (m_xy_program->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/XYLine.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_xy_program->addShaderFromSourceFile(QOpenGLShader::Geometry, ":/shaders/Shaders/Line.gsh") == false)
-        qDebug("Error compiling Geometry Shader");
-    if (m_xy_program->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Line.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_xy_program->link() == false)
-        qDebug("Shaders were not linked correctly\n");
+    m_xy_program = glResourceManager::getProgram(":/shaders/Shaders/XYLine.vsh", ":/shaders/Shaders/Line.gsh", ":/shaders/Shaders/Line.fsh");
     if (m_xy_program->bind() == false)
         qDebug("Shader not correctly bound\n");
 
@@ -220,13 +222,7 @@ void XY_GLWindow::initializeGL()
     m_xy_vao->release();
     m_xy_program->release();
 
-    m_program_dot = new QOpenGLShaderProgram;
-    if (m_program_dot->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/XYDot.vsh") == false)
-        qDebug("Error compiling Vertex Shader");
-    if (m_program_dot->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Dot.fsh") == false)
-        qDebug("Error compiling Fragment Shader");
-    if (m_program_dot->link() == false)
-        qDebug("Shaders were not linked correctly\n");
+    m_program_dot = glResourceManager::getProgram(":/shaders/Shaders/XYDot.vsh", "", ":/shaders/Shaders/Dot.fsh");
     if (m_program_dot->bind() == false)
         qDebug("Shader not correctly bound\n");
     m_in_convFactDotLoc = m_program_dot->uniformLocation("conv_fact");
@@ -239,13 +235,7 @@ void XY_GLWindow::initializeGL()
 
     m_program_dot->release();
 
-    m_program_zoom = new QOpenGLShaderProgram;
-    if (m_program_zoom->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Zoom.vsh") == false)
-        qDebug("Error compiling Zoom Vertex Shader");
-    if (m_program_zoom->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Zoom.fsh") == false)
-        qDebug("Error compiling Zoom Geometry Shader");
-    if (m_program_zoom->link() == false)
-        qDebug("Zoom shaders were not linked correctly\n");
+    m_program_zoom = glResourceManager::getProgram(":/shaders/Shaders/Zoom.vsh", "", ":/shaders/Shaders/Zoom.fsh");
     if (m_program_zoom->bind() == false)
         qDebug("Zoom shader not correctly bound\n");
 
@@ -261,13 +251,43 @@ void XY_GLWindow::initializeGL()
     m_zoom_vao->release();
     m_program_zoom->release();
 
-    m_program_tex = new QOpenGLShaderProgram;
-    if (m_program_tex->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Texture.vsh") == false)
-        qDebug("Error compiling Texture Vertex Shader");
-    if (m_program_tex->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Texture.fsh") == false)
-        qDebug("Error compiling Texture Fragment Shader");
-    if (m_program_tex->link() == false)
-        qDebug("Texture shaders were not linked correctly\n");
+    //Density Program Declaration
+    m_density_program = glResourceManager::getProgram(":/shaders/Shaders/Density.vsh", "", ":/shaders/Shaders/Density.fsh");
+    if (m_density_program->bind() == false)
+        qDebug("Density shader not correctly bound\n");
+    m_density_transfMatrixLoc = m_density_program->uniformLocation("transfMatrix");
+    m_density_scaleLoc = m_density_program->uniformLocation("scale");
+    m_density_maxCountLoc = m_density_program->uniformLocation("maxCount");
+    m_density_program->setUniformValue("densityTex", 0);
+
+    m_density_vao = new QOpenGLVertexArrayObject;
+    if (m_density_vao->create() == false)
+        qDebug("Density VAO error!\n");
+    m_density_vao->bind();
+
+    m_densityVbo = new QOpenGLBuffer;
+    if (m_densityVbo->create() == false)
+        qDebug("Density VBO error!\n");
+    m_densityVbo->bind();
+    m_densityVbo->allocate(quad, 8 * static_cast<int>(sizeof(GLfloat)));
+    f->glEnableVertexAttribArray(0);
+    f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), reinterpret_cast<void*>(0));
+    m_densityVbo->release();
+
+    m_density_vao->release();
+    m_density_program->release();
+
+    glGenTextures(1, &densityTex);
+    glBindTexture(GL_TEXTURE_2D, densityTex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, density->getBins(), density->getBins(), 0, GL_RED, GL_FLOAT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    density->invalidate();  //the new texture is empty
+
+    m_program_tex = glResourceManager::getTextProgram(preferences->sdf_fonts);
     if (m_program_tex->bind() == false)
         qDebug("Texture shaders not corrently bound\n");
 
@@ -276,16 +296,29 @@ void XY_GLWindow::initializeGL()
         qDebug("Texture VAO error!\n");
     m_tex_vao->bind();
 
-    m_texVbo = new QOpenGLBuffer;
-    if (m_texVbo->create() == false)
+    m_legendTextVbo = new QOpenGLBuffer;
+    if (m_legendTextVbo->create() == false)
+        qDebug("Texture VBO error!\n");
+    m_legendTextVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+
+    m_toolTipTextVbo = new QOpenGLBuffer;
+    if (m_toolTipTextVbo->create() == false)
+        qDebug("Texture VBO error!\n");
+    m_toolTipTextVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+
+    legendRevision = 0;  //the buffers are empty
+    toolTipRevision = 0;
+
+    m_gridTextVbo = new QOpenGLBuffer;
+    if (m_gridTextVbo->create() == false)
         qDebug("Texture VBO error!\n");
 
     m_tex_vao->release();
     m_program_tex->release();
 
-    gridTex = new QOpenGLTexture(grid->getFontTexture().mirrored());
-    legendTex = new QOpenGLTexture(legend->getLegendTexture().mirrored());  //creates the legend texture
-    toolTipTex = new QOpenGLTexture(tooltip->getToolTipTexture().mirrored());
+    gridTex = glResourceManager::acquireTexture(grid->getFontTexture());
+    legendTex = glResourceManager::acquireTexture(legend->getLegendTexture());  //creates the legend texture
+    toolTipTex = glResourceManager::acquireTexture(tooltip->getToolTipTexture());
     doneCurrent();
 }
 
@@ -310,15 +343,8 @@ void XY_GLWindow::paintGL()
     glClearColor(static_cast<float>(backR), static_cast<float>(backG), static_cast<float>(backB), static_cast<float>(backA));
 
     //DRAW THE GRID
+    upload_Grid_Buffers();
     //First Axis
-    m_gridVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_gridVbo = new QOpenGLBuffer;
-    if (m_gridVbo->create() == false)
-        qDebug("VBO grid error!\n");
-    if (m_gridVbo->bind() == false)
-        qDebug("VBO grid not bounded!!\n");
-    m_gridVbo->allocate(grid->Data(), grid->count() * static_cast<int>(sizeof(GLfloat)));
-    m_gridVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
     m_program->bind();
     m_vao->bind();
     glEnable(GL_BLEND);
@@ -354,7 +380,7 @@ void XY_GLWindow::paintGL()
     for (i = 0; i < N_signals; i++)
     {
         if (i < sig_properties.count())  //Makes sure that there is an element in sig_properties
-            if (sig_properties[i].lineRendering == true)
+            if ((sig_properties[i].lineRendering == true) && (densityMode == false))
             {
                 m_xy_program->setUniformValue(m_xy_conv_factLoc, QVector2D(grid->get_ConvFact_X(), grid->get_ConvFact_Y()));
                 m_xy_program->setUniformValue(m_xy_in_colorLoc, sig_properties[i].color);
@@ -384,7 +410,7 @@ void XY_GLWindow::paintGL()
     for (i = 0; i < N_signals; i++)
     {
         if (i < sig_properties.count())
-            if (sig_properties[i].dotRendering == true)
+            if ((sig_properties[i].dotRendering == true) && (densityMode == false))
             {
                 m_program_dot->setUniformValue(m_in_convFactDotLoc, QVector2D(grid->get_ConvFact_X(), grid->get_ConvFact_Y()));
                 m_program_dot->setUniformValue(m_in_colorLocDot, sig_properties[i].color);
@@ -400,24 +426,13 @@ void XY_GLWindow::paintGL()
     m_vao->release();
     m_program->release();
 
+    if (densityMode == true)
+        draw_Density();
+
     //DRAW GRID TEXT
-    grid->update_Text(this->width(), this->height());
-    m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_program_tex->bind();
-    m_tex_vao->bind();
-    m_texVbo = new QOpenGLBuffer;
-    if (m_texVbo->create() == false)
-        qDebug("Texture VBO signal error!\n");
-    if (m_texVbo->bind() == false)
-        qDebug("Texture VBO signal not bounded!!\n");
-    m_texVbo->allocate(grid->getTextData()->data(), grid->getTextData()->length() * static_cast<int>(sizeof(float)));
-    m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-    m_texVbo->release();
-    m_tex_vao->release();
-    m_program_tex->release();
     m_program_tex->bind();
     m_tex_vao->bind();
-    m_texVbo->bind();
+    m_gridTextVbo->bind();
     f->glEnableVertexAttribArray(0);
     f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
     f->glEnableVertexAttribArray(1);
@@ -426,7 +441,7 @@ void XY_GLWindow::paintGL()
     f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
     gridTex->bind();
     glDrawArrays(GL_TRIANGLES, 0, grid->getTextData()->length() / 48 * 6);
-    m_texVbo->release();
+    m_gridTextVbo->release();
     m_tex_vao->release();
     m_program_tex->release();
 
@@ -480,23 +495,19 @@ void XY_GLWindow::paintGL()
         m_program_zoom->release();
 
         //Now we paint the text
-        m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-        m_program_tex->bind();
-        m_tex_vao->bind();
-        m_texVbo = new QOpenGLBuffer;
-        if (m_texVbo->create() == false)
-            qDebug("Texture VBO signal error!\n");
-        if (m_texVbo->bind() == false)
-            qDebug("Texture VBO signal not bounded!!\n");
-        m_texVbo->allocate(legend->getLegendData()->data(), legend->getLegendData()->length() * static_cast<int>(sizeof(float)));
-        m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-        m_texVbo->release();
-        m_tex_vao->release();
-        m_program_tex->release();
+        //the text is uploaded only when it has been laid out again
+        if (legend->getLegendRevision() != legendRevision)
+        {
+            if (m_legendTextVbo->bind() == false)
+                qDebug("Texture VBO signal not bounded!!\n");
+            m_legendTextVbo->allocate(legend->getLegendData()->data(), legend->getLegendData()->length() * static_cast<int>(sizeof(float)));
+            m_legendTextVbo->release();
+            legendRevision = legend->getLegendRevision();
+        }
 
         m_program_tex->bind();
         m_tex_vao->bind();
-        m_texVbo->bind();
+        m_legendTextVbo->bind();
         f->glEnableVertexAttribArray(0);
         f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
         f->glEnableVertexAttribArray(1);
@@ -505,7 +516,7 @@ void XY_GLWindow::paintGL()
         f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
         legendTex->bind();
         glDrawArrays(GL_TRIANGLES, 0, legend->getLegendData()->length() / 48 * 6);
-        m_texVbo->release();
+        m_legendTextVbo->release();
         m_tex_vao->release();
         m_program_tex->release();
     }
@@ -519,23 +530,18 @@ void XY_GLWindow::paintGL()
         tooltip->setValues(coordX, coordY);
         tooltip->createToolTip(x_tooltip, y_tooltip, toolTipColor);  //set by default at top left
 
-        m_texVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-        m_program_tex->bind();
-        m_tex_vao->bind();
-        m_texVbo = new QOpenGLBuffer;
-        if (m_texVbo->create() == false)
-            qDebug("Texture VBO signal error!\n");
-        if (m_texVbo->bind() == false)
-            qDebug("Texture VBO signal not bounded!!\n");
-        m_texVbo->allocate(tooltip->getToolTipData()->data(), tooltip->getToolTipData()->length() * static_cast<int>(sizeof(float)));
-        m_texVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
-        m_texVbo->release();
-        m_tex_vao->release();
-        m_program_tex->release();
+        if (tooltip->getToolTipRevision() != toolTipRevision)
+        {
+            if (m_toolTipTextVbo->bind() == false)
+                qDebug("Texture VBO signal not bounded!!\n");
+            m_toolTipTextVbo->allocate(tooltip->getToolTipData()->data(), tooltip->getToolTipData()->length() * static_cast<int>(sizeof(float)));
+            m_toolTipTextVbo->release();
+            toolTipRevision = tooltip->getToolTipRevision();
+        }
 
         m_program_tex->bind();
         m_tex_vao->bind();
-        m_texVbo->bind();
+        m_toolTipTextVbo->bind();
         f->glEnableVertexAttribArray(0);
         f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(0));
         f->glEnableVertexAttribArray(1);
@@ -544,7 +550,7 @@ void XY_GLWindow::paintGL()
         f->glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), reinterpret_cast<void*>(4 * sizeof(GLfloat)));
         toolTipTex->bind();
         glDrawArrays(GL_TRIANGLES, 0, tooltip->getToolTipData()->length() / 48 * 6);
-        m_texVbo->release();
+        m_toolTipTextVbo->release();
         m_tex_vao->release();
         m_program_tex->release();
 
@@ -564,6 +570,8 @@ void XY_GLWindow::paintGL()
         m_vao->release();
         m_program->release();
     }
+
+    thumbs->capture();
 }
 
 void XY_GLWindow::resizeGL(int w, int h)
@@ -618,12 +626,25 @@ void XY_GLWindow::cleanup()
         return;
     makeCurrent();
     m_gridVbo->destroy();
+    m_gridTextVbo->destroy();
+    m_legendTextVbo->destroy();
+    m_toolTipTextVbo->destroy();
     m_x_signalVbo->destroy();
     m_y_signalVbo->destroy();
     m_zoomVbo->destroy();
     m_vao->destroy();
+    m_densityVbo->destroy();
+    m_density_vao->destroy();
+    glDeleteTextures(1, &densityTex);
+    densityTex = 0;
+    thumbs->release();
     m_zoom_vao->destroy();
-    legendTex->destroy();
+    glResourceManager::releaseTexture(gridTex);
+    glResourceManager::releaseTexture(legendTex);
+    glResourceManager::releaseTexture(toolTipTex);
+    gridTex = nullptr;
+    legendTex = nullptr;
+    toolTipTex = nullptr;
     doneCurrent();
 }
 
@@ -649,26 +670,18 @@ void XY_GLWindow::prepare_Signal_Buffer(int n_signals, int n_points, QVector<GLf
     makeCurrent();
 
     //the buffer is now ready to plot
-    //we can prepare the x vertex buffer object
-    m_x_signalVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_x_signalVbo = new QOpenGLBuffer;
-    if (m_x_signalVbo->create() == false)
-        qDebug("VBO signal error!\n");
+    //we can prepare the x vertex buffer object, the buffer objects are reused and only their storage is reallocated
     if (m_x_signalVbo->bind() == false)
         qDebug("VBO signal not bounded!!\n");
-    m_x_signalVbo->allocate(x_buffer->data(), n_signals * n_points * static_cast<int>(sizeof(GLfloat)));
     m_x_signalVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+    m_x_signalVbo->allocate(x_buffer->data(), n_signals * n_points * static_cast<int>(sizeof(GLfloat)));
     m_x_signalVbo->release();
 
     //we can prepare the y vertex buffer object
-    m_y_signalVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_y_signalVbo = new QOpenGLBuffer;
-    if (m_y_signalVbo->create() == false)
-        qDebug("VBO signal error!\n");
     if (m_y_signalVbo->bind() == false)
         qDebug("VBO signal not bounded!!\n");
-    m_y_signalVbo->allocate(y_buffer->data(), n_signals * n_points * static_cast<int>(sizeof(GLfloat)));
     m_y_signalVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::DynamicDraw);
+    m_y_signalVbo->allocate(y_buffer->data(), n_signals * n_points * static_cast<int>(sizeof(GLfloat)));
     m_y_signalVbo->release();
 
     N_signals = n_signals;
@@ -678,6 +691,88 @@ void XY_GLWindow::prepare_Signal_Buffer(int n_signals, int n_points, QVector<GLf
     doneCurrent();
 }
 
+void XY_GLWindow::accumulate_Density(int n_signals, float **x_buff_ptr, float **y_buff_ptr, int start, int end, QVector<int> newPoints, QVector<XY_SigProperty> prop, int NSamples)
+{
+    int i, first, maxNew;
+    bool cleared;
+    QVector4D mapping;
+
+    if ((n_signals < prop.count()) || (newPoints.count() < n_signals) || (end < start))
+        return;
+
+    sig_properties.clear();
+    sig_properties.resize(prop.count());
+    for (i = 0; i < prop.count(); i++)
+    {
+        sig_properties[i].name = prop[i].name;
+        sig_properties[i].color = prop[i].color;
+        sig_properties[i].line_width = prop[i].line_width;
+        sig_properties[i].dotRendering = prop[i].dotRendering;
+        sig_properties[i].lineRendering = prop[i].lineRendering;
+    }
+
+    N_signals = n_signals;
+    Number_of_Points = end - start + 1;
+    indexes.clear();
+    indexes.resize(n_signals);
+
+    //the bins are placed like the vertices in XYLine.vsh, a different grid moves every bin => the histogram starts again
+    mapping = QVector4D(grid->get_ConvFact_X(), grid->get_ConvFact_Y(), grid->get_Y_Axis(), grid->get_X_Axis());
+    cleared = false;
+    if (mapping != densityMapping)
+    {
+        density->clear();
+        densityMapping = mapping;
+        cleared = true;
+    }
+
+    //pastValueGain is the weight left to a point after NSamples newer points, as for the alpha of the lines
+    maxNew = 0;
+    for (i = 0; i < n_signals; i++)
+        if (newPoints[i] > maxNew)
+            maxNew = newPoints[i];
+    if ((cleared == false) && (NSamples > 0))
+        density->decay(std::pow(pastValueGain, static_cast<float>(maxNew) / static_cast<float>(NSamples)));
+
+    for (i = 0; i < n_signals; i++)
+    {
+        if (i < sig_properties.count())
+            if ((sig_properties[i].lineRendering == false) && (sig_properties[i].dotRendering == false))
+                continue;
+
+        //the new points can start before the visible window, the buffers hold the samples from 0 up to end
+        first = start;
+        if (cleared == false)
+            first = qMax(end + 1 - newPoints[i], 0);
+        density->addPoints(x_buff_ptr[i] + first, y_buff_ptr[i] + first, end + 1 - first, mapping);
+    }
+}
+
+void XY_GLWindow::draw_Density()
+{
+    int first, last, bins;
+
+    bins = density->getBins();
+
+    //only the rows touched by the new points are sent to the GPU
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, densityTex);
+    if (density->getDirtyRows(&first, &last) == true)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first, bins, last - first + 1, GL_RED, GL_FLOAT, density->getData() + (first * bins));
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_density_program->bind();
+    m_density_vao->bind();
+    m_density_program->setUniformValue(m_density_transfMatrixLoc, transfMatrix);
+    m_density_program->setUniformValue(m_density_scaleLoc, density->getScale());
+    m_density_program->setUniformValue(m_density_maxCountLoc, density->getMaxCount());
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_density_vao->release();
+    m_density_program->release();
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void XY_GLWindow::enable_zoom(bool enable) {
     zoom_enabled = enable;
     pan_enabled = false;
@@ -703,9 +798,9 @@ void XY_GLWindow::updateFonts()
 {
     makeCurrent();
 
-    delete gridTex;
-    delete legendTex;
-    delete toolTipTex;
+    glResourceManager::releaseTexture(gridTex);
+    glResourceManager::releaseTexture(legendTex);
+    glResourceManager::releaseTexture(toolTipTex);
 
     delete legend;
     delete tooltip;
@@ -713,10 +808,13 @@ void XY_GLWindow::updateFonts()
     legend = new legendCreator(preferences->legend_font, fontMgr);
     tooltip = new toolTipCreator(preferences->toolTip_font, fontMgr);
     grid->updateFont();
+    m_program_tex = glResourceManager::getTextProgram(preferences->sdf_fonts);  //the font mode could have been changed as well
+    legendRevision = 0;  //the new creators start again from their first revision
+    toolTipRevision = 0;
 
-    gridTex = new QOpenGLTexture(grid->getFontTexture().mirrored());
-    legendTex = new QOpenGLTexture(legend->getLegendTexture().mirrored());  //creates the legend texture
-    toolTipTex = new QOpenGLTexture(tooltip->getToolTipTexture().mirrored());
+    gridTex = glResourceManager::acquireTexture(grid->getFontTexture());
+    legendTex = glResourceManager::acquireTexture(legend->getLegendTexture());  //creates the legend texture
+    toolTipTex = glResourceManager::acquireTexture(tooltip->getToolTipTexture());
 
     doneCurrent();
 }
@@ -787,20 +885,35 @@ void XY_GLWindow::prepare_zoom_area()
 void XY_GLWindow::prepare_grid_buffer()
 {
     makeCurrent();
-
-    //the buffer is now ready to plot
-    //we can prepare the vertex buffer object
-    m_gridVbo->destroy();  //it destroys the previous buffer object and then it creates the new one
-    m_gridVbo = new QOpenGLBuffer;
-    if (m_gridVbo->create() == false)
-        qDebug("VBO grid error!\n");
-    if (m_gridVbo->bind() == false)
-        qDebug("VBO grid not bounded!!\n");
-    m_gridVbo->allocate(grid->Data(), grid->count() * static_cast<int>(sizeof(GLfloat)));
-    m_gridVbo->setUsagePattern(QOpenGLBuffer::UsagePattern::StaticDraw);
+    upload_Grid_Buffers();
     doneCurrent();
 }
 
+void XY_GLWindow::upload_Grid_Buffers()
+{
+    //the grid keeps its geometry and labels until the size, the zoom, the range or the fonts change
+    //the buffers are sent to the GPU only when the grid has been built again
+    grid->update_Text(this->width(), this->height());
+
+    if (grid->getGridRevision() != gridRevision)
+    {
+        if (m_gridVbo->bind() == false)
+            qDebug("VBO grid not bounded!!\n");
+        m_gridVbo->allocate(grid->Data(), grid->count() * static_cast<int>(sizeof(GLfloat)));
+        m_gridVbo->release();
+        gridRevision = grid->getGridRevision();
+    }
+
+    if (grid->getTextRevision() != gridTextRevision)
+    {
+        if (m_gridTextVbo->bind() == false)
+            qDebug("Texture VBO signal not bounded!!\n");
+        m_gridTextVbo->allocate(grid->getTextData()->data(), grid->getTextData()->length() * static_cast<int>(sizeof(float)));
+        m_gridTextVbo->release();
+        gridTextRevision = grid->getTextRevision();
+    }
+}
+
 void XY_GLWindow::legendSignalToggle(int idx)
 {
     int condition;
@@ -53,10 +53,13 @@
 
 #include "FontManager/fontmanager.h"
 #include "Managers/prefmanager.h"
+#include "Managers/glresourcemanager.h"
+#include "Managers/thumbnailgrabber.h"
 #include "Creators/tooltipcreator.h"
 #include "Creators/textrenderer.h"
 #include "Creators/legendCreator.h"
 #include "Creators/statcreator.h"
+#include "Creators/densitymap.h"
 #include "definitions.h"
 
 class XY_GLWindow : public QOpenGLWidget, protected QOpenGLFunctions
@@ -75,6 +78,11 @@ public:
     void setGridMaxX(double maxX);
     void setGridTimeBase(double TimeBase);
     void prepare_Signal_Buffer(int n_signals, int n_points, QVector<GLfloat> *x_buffer, QVector<GLfloat> *y_buffer, QVector<XY_SigProperty> prop, QVector<int> idx, int NSamples);
+    //bins the last newPoints[i] samples up to end of each signal in the density histogram, they can start before start; only start - end if the histogram had to be cleared
+    void accumulate_Density(int n_signals, float **x_buff_ptr, float **y_buff_ptr, int start, int end, QVector<int> newPoints, QVector<XY_SigProperty> prop, int NSamples);
+    void set_density_mode(bool enable) { densityMode = enable; }
+    bool get_density_mode() { return densityMode; }
+    void clear_density() { density->clear(); }
     void set_zoom_mode(int mode) { if ((mode >= 0) && (mode <= 2)) zoom_mode = mode; }
     void enable_zoom(bool enable);
     void enable_pan(bool enable) { pan_enabled = enable; zoom_enabled = false; }
@@ -87,6 +95,7 @@ public:
     void set_past_value_gain(float value) { pastValueGain = value; }
     void set_autoscale_mode(bool enable);
     QImage getPlotFigure(void);
+    thumbnailGrabber *get_Thumbnail_Grabber(void) { return thumbs; }
     void updateFonts();
 
 protected:
@@ -131,7 +140,26 @@ private:
     QOpenGLTexture *toolTipTex;
     QOpenGLShaderProgram *m_program_tex;
     QOpenGLVertexArrayObject *m_tex_vao;
-    QOpenGLBuffer *m_texVbo;
+    QOpenGLBuffer *m_legendTextVbo;  //text of the overlays, uploaded again only when it has been laid out again
+    QOpenGLBuffer *m_toolTipTextVbo;
+    uint64_t legendRevision;  //revisions of the overlays stored in the buffers above
+    uint64_t toolTipRevision;
+    thumbnailGrabber *thumbs;  //copies the painted frames into the thumbnail of the plot
+
+    //density mode: the points are accumulated in a histogram drawn through a colormap instead of being drawn one by one
+    densityMap *density;
+    bool densityMode;
+    QVector4D densityMapping;  //mapping of the points in the histogram, the histogram is cleared when it changes
+    GLuint densityTex;
+    QOpenGLShaderProgram *m_density_program;
+    QOpenGLVertexArrayObject *m_density_vao;
+    QOpenGLBuffer *m_densityVbo;  //quad covering the plot area
+    int m_density_transfMatrixLoc;
+    int m_density_scaleLoc;
+    int m_density_maxCountLoc;
+    QOpenGLBuffer *m_gridTextVbo;  //labels of the grid, kept on the GPU until the grid text changes
+    uint64_t gridRevision;  //revisions of the grid stored in m_gridVbo and m_gridTextVbo
+    uint64_t gridTextRevision;
     bool dotRendering;
 
     Grid_XY *grid;
@@ -212,6 +240,8 @@ private:
     void calculate_visible_area(void);
     void prepare_zoom_area(void);
     void prepare_grid_buffer(void);  //used when in autoscale
+    void upload_Grid_Buffers(void);
+    void draw_Density(void);
     void legendSignalToggle(int idx);
     void calculateCoordinateFromCursor(int screen_x, int screen_y, float *coordX, float *coordY);
     void prepareToolTipCrossData();
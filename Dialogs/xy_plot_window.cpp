@@ -33,6 +33,7 @@
 
 #include "xy_plot_window.h"
 #include "glwindow.h"
+#include "Managers/floatkernels.h"
 
 xy_plot_Window::xy_plot_Window(QString title, int index, double frequency, appPreferencesStruct *pref, fontManager *font)
 {
@@ -216,46 +217,12 @@ void xy_plot_Window::createSpinBoxes()
 
 void xy_plot_Window::find_min_max_signals(int n_signals, int start, int end, float **buff_ptr, float *Min, float *Max)
 {
-    float min, max;
-    int i, j;
-    bool found;
-
-    min = 0;
-    max = 1;
-    found = false;
-    //we initialize min and max to the first valid value of the first signal
-    for (i = 0; i < n_signals; i++)
-        for (j = start; j <= end; j++)
-        {
-            if ((std::isnan(buff_ptr[i][j]) == false) && (std::isinf(buff_ptr[i][j]) == false))
-            {
-                found = true;
-                min = buff_ptr[i][j];
-                max = min;
-            }
-        }
-
-    if (found == true)
+    //min and max of the finite samples of all the signals, 0 - 1 if there are none
+    if (floatKernels::rangeOfSignals(n_signals, start, end, buff_ptr, Min, Max) == false)
     {
-        for (i = 0; i < n_signals; i++)
-            for (j = start; j <= end; j++)
-            {
-                if ((std::isnan(buff_ptr[i][j]) == false) && (std::isinf(buff_ptr[i][j]) == false))
-                {
-                    if (buff_ptr[i][j] < min)
-                        min = buff_ptr[i][j];
-                    if (buff_ptr[i][j] > max)
-                        max = buff_ptr[i][j];
-                }
-            }
-    }
-    else {
-        min = 0;
-        max = 1;
+        *Min = 0;
+        *Max = 1;
     }
-
-    *Min = static_cast<float>(min);
-    *Max = static_cast<float>(max);
 }
 
 xy_plot_Window::~xy_plot_Window()
@@ -274,6 +241,7 @@ void xy_plot_Window::addSignal(uint32_t x_index, uint32_t y_index, QString x_nam
     p.dotRendering = false;
     p.lineRendering = true;
     sig_properties.append(p);
+    binnedEnd.clear();  //the density histogram starts again with the new signal
 
     glPlot->setSigProperties(sig_properties);
 }
@@ -292,6 +260,7 @@ void xy_plot_Window::removeSignal(uint32_t x_index, uint32_t y_index)
 
     //Remove the trigger action
     sig_properties.remove(idx);
+    binnedEnd.clear();
     glPlot->setSigProperties(sig_properties);
 }
 
@@ -311,7 +280,7 @@ void xy_plot_Window::setTitle(QString title)
     this->setWindowTitle(title);
 }
 
-int xy_plot_Window::prepare_Signal_Data(int n_signals, int n_points, float** x_buff_ptr, float** y_buff_ptr, QColor* colors, float *line_widths)
+int xy_plot_Window::prepare_Signal_Data(int n_signals, int n_points, float** x_buff_ptr, float** y_buff_ptr, QColor* colors, float *line_widths, const signalSnapshot *snaps)
 {
     (void) colors;
 
@@ -319,6 +288,9 @@ int xy_plot_Window::prepare_Signal_Data(int n_signals, int n_points, float** x_b
     float xmin, xmax, ymin, ymax;  //used for autoscale
     int start, end;
     float distance;
+    uint64_t absEnd;
+    bool restart;
+    QVector<int> newPoints;
 
     if (n_signals != sig_properties.count())  //we have a mismatch between the number of signals passed and the number of signals declared in the plot => do not plot anything
         return -1;
@@ -366,12 +338,49 @@ int xy_plot_Window::prepare_Signal_Data(int n_signals, int n_points, float** x_b
         glPlot->get_Grid()->recreate_Grid();
     }    
 
-    x_signal_buffer.resize(n_signals * (end - start + 1));
-    y_signal_buffer.resize(n_signals * (end - start + 1));
-
     Number_of_Points = end - start + 1;
     n_p = Number_of_Points;
 
+    if (glPlot->get_density_mode() == true)
+    {
+        //the samples received since the last binned absolute position are added to the histogram, also the ones which are not visible
+        //anymore when the frames were skipped, as long as they are still in the snapshot
+        restart = (binnedEnd.count() != n_signals);
+        for (i = 0; (i < n_signals) && (restart == false); i++)
+        {
+            absEnd = snaps[2 * i].first + static_cast<uint64_t>(end) + 1;
+            if ((binnedEpoch[i] != snaps[2 * i].stats_epoch) || (absEnd < binnedEnd[i]))  //the signal has been cleaned
+                restart = true;
+        }
+        if (restart == true)
+            glPlot->clear_density();
+
+        binnedEnd.resize(n_signals);
+        binnedEpoch.resize(n_signals);
+        newPoints.resize(n_signals);
+        for (i = 0; i < n_signals; i++)
+        {
+            sig_properties[i].line_width = line_widths[i];
+            absEnd = snaps[2 * i].first + static_cast<uint64_t>(end) + 1;
+            newPoints[i] = n_p;
+            if (restart == false)
+            {
+                newPoints[i] = end + 1;  //the whole snapshot
+                if (absEnd - binnedEnd[i] < static_cast<uint64_t>(end + 1))
+                    newPoints[i] = static_cast<int>(absEnd - binnedEnd[i]);
+            }
+            binnedEnd[i] = absEnd;
+            binnedEpoch[i] = snaps[2 * i].stats_epoch;
+        }
+
+        glPlot->accumulate_Density(n_signals, x_buff_ptr, y_buff_ptr, start, end, newPoints, sig_properties, N_Samples);
+
+        return 0;
+    }
+
+    x_signal_buffer.resize(n_signals * n_p);
+    y_signal_buffer.resize(n_signals * n_p);
+
     indexes.clear();
     indexes.resize(n_signals);  //indexes to the locations of each signal in the buffer
 
@@ -553,6 +562,16 @@ void xy_plot_Window::triggerLegend()
         glPlot->enable_legend(false);
 }
 
+void xy_plot_Window::triggerDensity()
+{
+    //the histogram is built again from the samples in the window
+    binnedEnd.clear();
+    glPlot->clear_density();
+    glPlot->set_density_mode(densityAct->isChecked());
+
+    emit replot(plotIndex);
+}
+
 void xy_plot_Window::triggerGrid()
 {
     if (gridAct->isChecked() == true)
@@ -840,6 +859,13 @@ void xy_plot_Window::createActions()
     legendAct->setText("&Legend");
     connect(legendAct, &QAction::triggered, this, &xy_plot_Window::triggerLegend);
 
+    densityAct = new QAction(this);
+    densityAct->setCheckable(true);
+    densityAct->setChecked(false);
+    densityAct->setToolTip("Density view: the points are accumulated in a histogram, the past value brightness sets their persistence");
+    densityAct->setText("&Density");
+    connect(densityAct, &QAction::triggered, this, &xy_plot_Window::triggerDensity);
+
     fileMenu = menuBar()->addMenu("&File");
     viewMenu = menuBar()->addMenu("&View");
     toolMenu = menuBar()->addMenu("&Tool");
@@ -865,6 +891,7 @@ void xy_plot_Window::createActions()
     toolBar->addAction(panAct);
     toolBar->addSeparator();
     toolBar->addAction(legendAct);
+    toolBar->addAction(densityAct);
     toolBar->addSeparator();
     toolBar->addAction(closeAct);
 
@@ -880,6 +907,8 @@ void xy_plot_Window::createActions()
     viewMenu->addAction(zoomYAct);
     viewMenu->addSeparator();
     viewMenu->addAction(panAct);
+    viewMenu->addSeparator();
+    viewMenu->addAction(densityAct);
 
     toolMenu->addSeparator();
     toolMenu->addAction(gridAct);
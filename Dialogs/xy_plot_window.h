@@ -69,6 +69,7 @@
 #include "Creators/statcreator.h"
 #include "FontManager/fontmanager.h"
 #include "Managers/prefmanager.h"
+#include "Managers/signal_data.h"
 #include "xy_glwindow.h"
 #include "Creators/legendCreator.h"
 
@@ -88,7 +89,8 @@ public:
     void setWindowFrequency(double freq) { if (freq > 0) windowFrequency = freq; }
     void setTitle(QString title);
 
-    int prepare_Signal_Data(int n_signals, int n_points, float** x_buff_ptr, float** y_buff_ptr, QColor* colors, float *line_widths);  //points to n_signals buffers and indicates how many points to be prepared
+    int prepare_Signal_Data(int n_signals, int n_points, float** x_buff_ptr, float** y_buff_ptr, QColor* colors, float *line_widths, const signalSnapshot *snaps);  //points to n_signals buffers and indicates how many points to be prepared, snaps holds the x and y snapshot of each signal
+    qint64 getStagingMemory() { return static_cast<qint64>(x_signal_buffer.capacity() + y_signal_buffer.capacity()) * static_cast<qint64>(sizeof(GLfloat)); }  //bytes allocated for the buffers sent to the GPU
 
     void update(void);
     void updateFonts() { glPlot->updateFonts(); }
@@ -109,6 +111,7 @@ private slots:
     void triggerZoomY(void);
     void triggerPan(void);
     void triggerLegend(void);
+    void triggerDensity(void);
     void triggerGrid(void);
     void triggerYTicks(void);
     void triggerXTicks(void);
@@ -163,6 +166,7 @@ private:
     QAction *zoomYAct;
     QAction *panAct;
     QAction *legendAct;
+    QAction *densityAct;
 
     QWidget *centralWidget;
 
@@ -197,6 +201,8 @@ private:
     QVector<int> indexes;  //all the signals are contained into one single buffer. in this vector we store the location at which each signal starts
     QVector<GLfloat> x_signal_buffer;  //contains the buffer of the x_signals to be displayed => a multiple of N_signals and N_points
     QVector<GLfloat> y_signal_buffer;  //contains the buffer of the y_signals to be displayed
+    QVector<uint64_t> binnedEnd;  //absolute position following the last x sample of each signal in the density histogram
+    QVector<uint64_t> binnedEpoch;  //epoch of the absolute positions above
     int x_signal_buffer_count, y_signal_buffer_count;
     void find_min_max_signals(int n_signals, int start, int end, float** buff_ptr, float* Min, float *Max);
 };
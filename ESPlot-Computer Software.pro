@@ -82,12 +82,28 @@ SOURCES += \
     Dialogs/sigassdlg.cpp \
     Dialogs/xy_plot_window.cpp \
     Dialogs/connectdlg.cpp \
+    Managers/chunkcodec.cpp \
+    Managers/commandtrack.cpp \
+    Managers/decimator.cpp \
+    Managers/glresourcemanager.cpp \
+    Managers/renderscheduler.cpp \
+    Managers/thumbnailgrabber.cpp \
+    Managers/sweepaccumulator.cpp \
+    Managers/triggerengine.cpp \
+    Managers/floatkernels.cpp \
+    Managers/workerpool.cpp \
+    Managers/derivedsignal.cpp \
     Managers/fftmanager.cpp \
     Managers/matlabfilesaver.cpp \
+    Managers/memorymanager.cpp \
     Managers/prefmanager.cpp \
+    Managers/runningstats.cpp \
     Managers/sgnalplottermanager.cpp \
     Managers/signal_data.cpp \
+    Managers/streamfilter.cpp \
+    Managers/timeindex.cpp \
     Creators/grid_xy.cpp \
+    Creators/densitymap.cpp \
     Dialogs/xy_glwindow.cpp
 
 # Additional import path used to resolve QML modules in Qt Creator's code model
@@ -117,6 +133,7 @@ HEADERS += \
     Dialogs/prefDlg.h \
     Managers/preferences.h \
     Managers/prefmanager.h \
+    Managers/runningstats.h \
     Managers/sgnalplottermanager.h \
     Dialogs/sigassdlg.h \
     Managers/signal_data.h \
@@ -141,12 +158,27 @@ HEADERS += \
     Dialogs/plot_window.h \
     Dialogs/xy_plot_window.h \
     Dialogs/connectdlg.h \
+    Managers/chunkcodec.h \
+    Managers/commandtrack.h \
+    Managers/decimator.h \
+    Managers/glresourcemanager.h \
+    Managers/renderscheduler.h \
+    Managers/thumbnailgrabber.h \
+    Managers/sweepaccumulator.h \
+    Managers/triggerengine.h \
+    Managers/floatkernels.h \
+    Managers/workerpool.h \
+    Managers/derivedsignal.h \
     Managers/fftmanager.h \
     Managers/matlabfilesaver.h \
+    Managers/memorymanager.h \
     Managers/preferences.h \
     Managers/prefmanager.h \
     Managers/signal_data.h \
+    Managers/streamfilter.h \
+    Managers/timeindex.h \
     Creators/grid_xy.h \
+    Creators/densitymap.h \
     Dialogs/xy_glwindow.h
 
 #CONFIG += \
@@ -156,64 +188,7 @@ HEADERS += \
 
 MODULE_INCLUDEPATH += $$PWD/include
 
-INCLUDEPATH += 3rdparty/FreeType/include
-INCLUDEPATH += 3rdparty/FreeType/include/freetype/config
-
-SOURCES += \
-    3rdparty/FreeType/src/autofit/afangles.c \
-    3rdparty/FreeType/src/autofit/afdummy.c \
-    3rdparty/FreeType/src/autofit/afglobal.c \
-    3rdparty/FreeType/src/autofit/afhints.c \
-    3rdparty/FreeType/src/autofit/aflatin.c \
-    3rdparty/FreeType/src/autofit/afloader.c \
-    3rdparty/FreeType/src/autofit/afmodule.c \
-    3rdparty/FreeType/src/autofit/autofit.c \
-    3rdparty/FreeType/src/base/ftbase.c \
-    3rdparty/FreeType/src/base/ftbitmap.c \
-    3rdparty/FreeType/src/base/ftbbox.c \
-    3rdparty/FreeType/src/base/ftdebug.c \
-    3rdparty/FreeType/src/base/ftglyph.c \
-    3rdparty/FreeType/src/base/ftfntfmt.c \
-    3rdparty/FreeType/src/base/ftinit.c \
-    3rdparty/FreeType/src/base/ftlcdfil.c \
-    3rdparty/FreeType/src/base/ftmm.c \
-    3rdparty/FreeType/src/base/ftsynth.c \
-    3rdparty/FreeType/src/base/fttype1.c \
-    3rdparty/FreeType/src/bdf/bdf.c \
-    3rdparty/FreeType/src/cache/ftcache.c \
-    3rdparty/FreeType/src/cff/cff.c \
-    3rdparty/FreeType/src/cid/type1cid.c \
-    3rdparty/FreeType/src/gzip/ftgzip.c \
-    3rdparty/FreeType/src/lzw/ftlzw.c \
-    3rdparty/FreeType/src/otvalid/otvalid.c \
-    3rdparty/FreeType/src/otvalid/otvbase.c \
-    3rdparty/FreeType/src/otvalid/otvcommn.c \
-    3rdparty/FreeType/src/otvalid/otvgdef.c \
-    3rdparty/FreeType/src/otvalid/otvgpos.c \
-    3rdparty/FreeType/src/otvalid/otvgsub.c \
-    3rdparty/FreeType/src/otvalid/otvjstf.c \
-    3rdparty/FreeType/src/otvalid/otvmod.c \
-    3rdparty/FreeType/src/pcf/pcf.c \
-    3rdparty/FreeType/src/pfr/pfr.c \
-    3rdparty/FreeType/src/psaux/psaux.c \
-    3rdparty/FreeType/src/pshinter/pshinter.c \
-    3rdparty/FreeType/src/psnames/psmodule.c \
-    3rdparty/FreeType/src/raster/raster.c \
-    3rdparty/FreeType/src/sfnt/sfnt.c \
-    3rdparty/FreeType/src/smooth/smooth.c \
-    3rdparty/FreeType/src/truetype/truetype.c \
-    3rdparty/FreeType/src/type1/type1.c \
-    3rdparty/FreeType/src/type42/type42.c \
-    3rdparty/FreeType/src/winfonts/winfnt.c
-
-win32 {
-    SOURCES += 3rdparty/FreeType/src/base/ftsystem.c
-} else {
-   INCLUDEPATH += 3rdparty/FreeType/builds/unix
-   SOURCES += 3rdparty/FreeType/builds/unix/ftsystem.c
-}
-
-DEFINES += FT2_BUILD_LIBRARY
+include(freetype.pri)
 
 win32 {
 
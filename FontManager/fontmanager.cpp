@@ -37,29 +37,188 @@ fontManager::fontManager(appPreferencesStruct *pref)
 {
     preferences = pref;
     loaded = true;
+    diskCache = true;
+    librarySize = 0;
 }
 
 int fontManager::getGlyph(QString font, QImage *glyph, QVector<Character> *ctr, int *mWidth, int *mHeight, int *nC)
 {
-    QImage img;  //empty pictures
-    int idx;
+    std::shared_ptr<const glyphAtlas> atlas = getAtlas(font);
+
+    if (atlas == nullptr)
+        return -1;
+
+    //QImage and QVector are implicitly shared => no pixel is copied
+    *glyph = atlas->glyph;
+    *ctr = atlas->metrics;
+    *mWidth = atlas->cellWidth;
+    *mHeight = atlas->cellHeight;
+    *nC = atlas->nColumns;
+
+    return 0;
+}
+
+std::shared_ptr<const glyphAtlas> fontManager::getAtlas(QString font)
+{
+    int idx, resolution;
+    bool sdf;
+    QString key, variant, cacheFile;
+    QByteArray fontFile;
+    glyphAtlas *atlas;
+    std::shared_ptr<const glyphAtlas> shared;
 
     idx = findFont(font);
     if (idx == -1)
         idx = findFont(defaultFont);
+    if (idx == -1)
+        return nullptr;
+
+    //a distance field does not depend on the resolution
+    resolution = preferences->font_resolution;
+    sdf = preferences->sdf_fonts;
+    if (sdf == true)
+        variant = "sdf";
+    else
+        variant = QString::number(resolution);
+    key = fontNameFileList[idx].filename + "@" + variant;
+
+    QMutexLocker locker(&atlasLock);  //two plots asking for the same font rasterize it once
+
+    if (atlasCache.contains(key) == true)
+        return atlasCache.value(key);
+
+    QFile f(fontNameFileList[idx].filename);
+    if (f.open(QIODevice::ReadOnly) == false)
+    {
+        qDebug() << "Error: Could not read font " << fontNameFileList[idx].filename;
+        return nullptr;
+    }
+    fontFile = f.readAll();
+    f.close();
+
+    atlas = new glyphAtlas;
+
+    //the file of the disk cache is named after the content of the font, a modified font is rasterized again
+    if (diskCache == true)
+        cacheFile = getAtlasFileName(fontFile, variant);
+
+    if ((cacheFile.isEmpty() == true) || (loadAtlas(cacheFile, atlas) != 0))
+    {
+        glyphLoader gl(fontFile, resolution, sdf);
+
+        atlas->glyph = gl.getGlyphMap();
+        atlas->metrics = gl.getMetrics();
+        gl.getCellWidthHeight(&atlas->cellWidth, &atlas->cellHeight);
+        atlas->nColumns = gl.getNColumns();
+        atlas->sdf = gl.isSDF();
+        atlas->padding = gl.getPadding();
+
+        if (cacheFile.isEmpty() == false)
+            if (saveAtlas(cacheFile, atlas) != 0)
+                qDebug() << "Font atlas not stored in " << cacheFile;
+    }
+
+    shared = std::shared_ptr<const glyphAtlas>(atlas);
+    atlasCache.insert(key, shared);
+    librarySize += atlas->glyph.sizeInBytes();
+
+    return shared;
+}
+
+QString fontManager::getAtlasFileName(const QByteArray &fontFile, QString variant)
+{
+    QString folder;
+
+    folder = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (folder.isEmpty() == true)
+        return QString();
+
+    folder += "/fonts";
+    if (QDir().mkpath(folder) == false)
+        return QString();
 
-    if (idx != -1)  //if it has been found, we load the glyph and output the data
+    return folder + "/" + QString(QCryptographicHash::hash(fontFile, QCryptographicHash::Sha1).toHex()) + "_" + variant + ".atlas";
+}
+
+int fontManager::loadAtlas(QString filename, glyphAtlas *atlas)
+{
+    quint32 magic, version;
+    qint32 width, height, columns, N, pad;
+    bool sdf;
+    int i;
+
+    QFile file(filename);
+    if (file.open(QIODevice::ReadOnly) == false)
+        return -1;  //not cached yet
+
+    QDataStream stream(&file);  //ready to read
+
+    stream >> magic >> version;
+    if ((magic != ATLAS_FILE_MAGIC) || (version != ATLAS_FILE_VERSION))
+        return -1;
+
+    stream >> atlas->glyph >> width >> height >> columns >> sdf >> pad >> N;
+    if ((stream.status() != QDataStream::Ok) || (N < 0) || (N > 256))
+        return -1;
+
+    atlas->metrics.resize(N);
+    for (i = 0; i < N; i++)
     {
-        glyphLoader *gl = new glyphLoader(fontNameFileList[idx].filename, preferences->font_resolution);
-        *glyph = gl->getGlyphMap();
-        *ctr = gl->getMetrics();
-        gl->getCellWidthHeight(mWidth, mHeight);
-        *nC =  gl->getNColumns();
-        delete gl;
-        return 0;
+        stream >> atlas->metrics[i].TextureID >> atlas->metrics[i].Width >> atlas->metrics[i].Rows;
+        stream >> atlas->metrics[i].Left >> atlas->metrics[i].Top >> atlas->metrics[i].AdvanceX;
     }
-    return -1;
+
+    if ((stream.status() != QDataStream::Ok) || (atlas->glyph.isNull() == true))
+        return -1;  //damaged file, the font is rasterized again
+
+    atlas->glyph = atlas->glyph.convertToFormat(QImage::Format_RGBA8888);  //same format as the rasterized atlas
+    atlas->cellWidth = width;
+    atlas->cellHeight = height;
+    atlas->nColumns = columns;
+    atlas->sdf = sdf;
+    atlas->padding = pad;
+
+    file.close();
+
+    return 0;
 }
+
+int fontManager::saveAtlas(QString filename, const glyphAtlas *atlas)
+{
+    int i;
+
+    //written aside and renamed, so that a running instance never reads a partial file
+    QFile file(filename + ".tmp");
+    if (file.open(QIODevice::WriteOnly) == false)
+        return -1;
+
+    QDataStream stream(&file);  //ready to write
+
+    stream << static_cast<quint32>(ATLAS_FILE_MAGIC) << static_cast<quint32>(ATLAS_FILE_VERSION);
+    stream << atlas->glyph << static_cast<qint32>(atlas->cellWidth) << static_cast<qint32>(atlas->cellHeight) << static_cast<qint32>(atlas->nColumns);
+    stream << atlas->sdf << static_cast<qint32>(atlas->padding);
+    stream << static_cast<qint32>(atlas->metrics.count());
+    for (i = 0; i < atlas->metrics.count(); i++)
+    {
+        stream << atlas->metrics[i].TextureID << atlas->metrics[i].Width << atlas->metrics[i].Rows;
+        stream << atlas->metrics[i].Left << atlas->metrics[i].Top << atlas->metrics[i].AdvanceX;
+    }
+
+    file.close();
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        QFile::remove(filename + ".tmp");
+        return -1;
+    }
+
+    QFile::remove(filename);
+    if (QFile::rename(filename + ".tmp", filename) == false)
+        return -1;
+
+    return 0;
+}
+
 /*
 QVector<Character> fontManager::getMetrics(QString font)
 {
@@ -39,6 +39,15 @@
 #include <QDebug>
 #include <QColor>
 #include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QFile>
+#include <QDir>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+
+#include <memory>
 
 #include "Managers/prefmanager.h"
 #include "glyphloader.h"
@@ -46,18 +55,34 @@
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
+#define ATLAS_FILE_MAGIC    0x45534741  //"ESGA"
+#define ATLAS_FILE_VERSION  2
+
 typedef struct _fontNameFile
 {
     QString name;
     QString filename;
 } fontNameFile;
 
+typedef struct _glyphAtlas
+{
+    QImage glyph;  //all the characters, one per cell
+    QVector<Character> metrics;
+    int cellWidth;
+    int cellHeight;
+    int nColumns;
+    bool sdf;  //the alpha is a distance field, to be drawn with TextureSDF.fsh
+    int padding;  //pixels added around each glyph by the distance field
+} glyphAtlas;
+
 //This classes loads all the fonts declared in the system
+//Each font is rasterized once per resolution and the atlas is shared by all the plots
 class fontManager
 {
 public:
     fontManager(appPreferencesStruct *pref);
-    int getGlyph(QString font, QImage *glyph, QVector<Character> *ctr, int *mWidth, int *mHeight, int *nC);
+    int getGlyph(QString font, QImage *glyph, QVector<Character> *ctr, int *mWidth, int *mHeight, int *nC);  //the outputs share the data of the cached atlas
+    std::shared_ptr<const glyphAtlas> getAtlas(QString font);  //nullptr if neither the font nor the default font exist
 //    QVector<Character> getMetrics(QString font);
 //    void getCellWidthHeight(QString font, int* mWidth, int* mHeight);
 //    int getColumns(QString font);
@@ -73,6 +98,8 @@ public:
 
     int findFont(QString font);
 
+    void setDiskCache(bool en) { diskCache = en; }  //the atlases are also stored in the cache folder of the user for the next start
+
 private:
     QVector<fontNameFile> fontNameFileList;
     QVector<glyphLoader*> fontData;
@@ -85,7 +112,15 @@ private:
 
     long long librarySize;
 
+    QHash<QString, std::shared_ptr<const glyphAtlas>> atlasCache;  //key: font file and resolution
+    QMutex atlasLock;
+    bool diskCache;
+
     void createFontNameFileList();
+
+    QString getAtlasFileName(const QByteArray &fontFile, QString variant);
+    int loadAtlas(QString filename, glyphAtlas *atlas);
+    int saveAtlas(QString filename, const glyphAtlas *atlas);
 };
 
 #endif // FONTMANAGER_H
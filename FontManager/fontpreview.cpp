@@ -52,7 +52,7 @@ fontPreview::~fontPreview()
 {
     delete m_tex_vao;
     delete m_texVbo;
-    delete m_program_tex;
+    //m_program_tex belongs to the glResourceManager
 }
 
 void fontPreview::loadFont(QString fontname, QColor fontcolor, int fontsize)
@@ -81,13 +81,7 @@ void fontPreview::initializeGL()
     backgroundCol.getRgbF(&backR, &backG, &backB, &backA);
     f->glClearColor(static_cast<float>(backR), static_cast<float>(backG), static_cast<float>(backB), static_cast<float>(backA));
 
-    m_program_tex = new QOpenGLShaderProgram;
-    if (m_program_tex->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/Shaders/Texture.vsh") == false)
-        qDebug("Error compiling Texture Vertex Shader");
-    if (m_program_tex->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/Shaders/Texture.fsh") == false)
-        qDebug("Error compiling Texture Fragment Shader");
-    if (m_program_tex->link() == false)
-        qDebug("Texture shaders were not linked correctly\n");
+    m_program_tex = glResourceManager::getProgram(":/shaders/Shaders/Texture.vsh", "", ":/shaders/Shaders/Texture.fsh");
     if (m_program_tex->bind() == false)
         qDebug("Texture shaders not corrently bound\n");
 
@@ -123,6 +117,7 @@ void fontPreview::paintGL()
         m_texVbo->allocate(text_data.data(), text_data.length() * static_cast<int>(sizeof(float)));
 
         fontTex = new QOpenGLTexture(txtRnd->getTexture().mirrored());
+        m_program_tex = glResourceManager::getTextProgram(txtRnd->isSDF());
         m_program_tex->bind();
         m_tex_vao->bind();
         fontTex->bind(0);
@@ -46,6 +46,7 @@
 
 #include "fontmanager.h"
 #include "Creators/textrenderer.h"
+#include "Managers/glresourcemanager.h"
 
 class fontPreview : public QOpenGLWidget, protected QOpenGLFunctions
 {
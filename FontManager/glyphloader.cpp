@@ -33,12 +33,27 @@
 
 #include "glyphloader.h"
 #include <QIODevice>
+#include <cmath>
 
 glyphLoader::glyphLoader(QString filename, int resolution)
 {
+    QFile f(filename);
+    QByteArray fontFile;
+
     N_Chars = 0;
+    distanceField = false;
+    padding = 0;
+
+    //freetype cannot access resource files, but qfile can => the font is read in memory
+    if (f.open(QIODevice::ReadOnly) == true)
+    {
+        fontFile = f.readAll();
+        f.close();
+    }
+    else
+        qDebug() << "Error: Could not read font " << filename;
 
-    loadGlyph(filename, resolution, 128);
+    loadGlyph(fontFile, resolution, 128);
 
     //We can now create the Image
     CreateQImage();
@@ -46,6 +61,21 @@ glyphLoader::glyphLoader(QString filename, int resolution)
     glyphSizeBytes = glyphMap->sizeInBytes();
 }
 
+glyphLoader::glyphLoader(const QByteArray &fontFile, int resolution, bool sdf)
+{
+    N_Chars = 0;
+    distanceField = sdf;
+    padding = 0;
+    if (sdf == true)
+        padding = SDF_SPREAD;
+
+    loadGlyph(fontFile, resolution, 128);
+
+    //We can now create the Image
+    CreateQImage();
+
+    glyphSizeBytes = glyphMap->sizeInBytes();
+}
 
 glyphLoader::~glyphLoader()
 {
@@ -108,23 +138,15 @@ void glyphLoader::getMaxWidthHeight(int *width, int *height)
     CellHeight = mH;
 }
 
-void glyphLoader::loadGlyph(QString filename, int pixelSize, int NChars)
+void glyphLoader::loadGlyph(const QByteArray &fontFile, int pixelSize, int NChars)
 {   
     int i, j, k, counter, pitch;
 
-       QByteArray ba;
        FT_Library ft;
        char c;
 
-       //first, we dump a copy of the font file in the temp directory as freetype cannot access resource files, but qfile can
-       if (QFile::exists(QDir::tempPath() + "/temp.ttf"))
-       {
-           QFile::remove(QDir::tempPath() + "/temp.ttf");
-       }
-       QFile::copy(filename, QDir::tempPath() + "/temp.ttf");
-       QFile f(QDir::tempPath() + "/temp.ttf");
-       f.setPermissions(QFile::ReadUser|QFile::WriteUser);
-       f.close();
+       if (fontFile.isEmpty() == true)
+           return;
 
        if (FT_Init_FreeType(&ft))
        {
@@ -132,25 +154,21 @@ void glyphLoader::loadGlyph(QString filename, int pixelSize, int NChars)
            return;
        }
 
+       //the face reads directly from fontFile, which stays valid till FT_Done_Face
+       //no temporary file is needed anymore, so several fonts can be loaded at the same time
        FT_Face face;
-       QString temp = QDir::tempPath() + "/temp.ttf";
-       ba = temp.toLocal8Bit();
-       char* file_name = ba.data();
-
-       if (FT_New_Face(ft, file_name, 0, &face))
+       if (FT_New_Memory_Face(ft, reinterpret_cast<const FT_Byte*>(fontFile.constData()), static_cast<FT_Long>(fontFile.size()), 0, &face))
        {
-           qDebug() << "Error: Could not load font " << filename;
-           //Before we exit, we delete the temp file
-           QFile file(temp);
-           file.remove();
+           qDebug() << "Error: Could not load font from memory";
+           FT_Done_FreeType(ft);
            return;
        }
 
-       //Now that the font has been loaded, we delete the temp file
-       QFile file(temp);
-       file.remove();
-
-       FT_Set_Char_Size(face, 0, pixelSize * 64, 300, 300);
+       //the distance field is scaled by the GPU => one small atlas is enough for every size
+       if (distanceField == true)
+           FT_Set_Char_Size(face, 0, SDF_PIXEL_SIZE * 64, 72, 72);
+       else
+           FT_Set_Char_Size(face, 0, pixelSize * 64, 300, 300);
        if ((NChars <= 0) || (NChars > 255))
            return;
 
@@ -210,9 +228,131 @@ void glyphLoader::loadGlyph(QString filename, int pixelSize, int NChars)
 
            glyphsData.append(*array);
 
+           if (distanceField == true)
+               makeDistanceField(&glyphsData.last(), &charMetrics.last());
+
            delete array;
        }
 
        FT_Done_Face(face);
        FT_Done_FreeType(ft);
 }
+
+void glyphLoader::makeDistanceField(QVector<unsigned char> *bitmap, Character *ctr)
+{
+    //The glyph is enlarged by SDF_SPREAD pixels per side and every pixel gets its signed distance from the outline:
+    //0.5 on the outline, growing inside, 0 beyond SDF_SPREAD pixels outside
+    int x, y, i, w, h, W, H;
+    bool in;
+    float d, value;
+    QVector<int> in_dx, in_dy;  //offset to the nearest pixel inside the glyph
+    QVector<int> out_dx, out_dy;  //offset to the nearest pixel outside the glyph
+    QVector<unsigned char> field;
+
+    w = ctr->Width;
+    h = ctr->Rows;
+    W = w + (2 * SDF_SPREAD);
+    H = h + (2 * SDF_SPREAD);
+
+    in_dx.fill(SDF_FAR, W * H); in_dy.fill(SDF_FAR, W * H);
+    out_dx.fill(SDF_FAR, W * H); out_dy.fill(SDF_FAR, W * H);
+    field.resize(W * H);
+
+    for (y = 0; y < H; y++)
+        for (x = 0; x < W; x++)
+        {
+            in = false;
+            if ((x >= SDF_SPREAD) && (x < SDF_SPREAD + w) && (y >= SDF_SPREAD) && (y < SDF_SPREAD + h))
+                in = (bitmap->at(((y - SDF_SPREAD) * w) + (x - SDF_SPREAD)) >= 128);
+
+            i = (y * W) + x;
+            if (in == true)
+            {
+                in_dx[i] = 0; in_dy[i] = 0;
+            }
+            else
+            {
+                out_dx[i] = 0; out_dy[i] = 0;
+            }
+        }
+
+    sweepDistance(in_dx.data(), in_dy.data(), W, H);
+    sweepDistance(out_dx.data(), out_dy.data(), W, H);
+
+    for (i = 0; i < W * H; i++)
+    {
+        //the outline lies half a pixel away from the centers of the pixels at its sides
+        if ((in_dx[i] == 0) && (in_dy[i] == 0))  //inside
+            d = -(std::sqrt(static_cast<float>((out_dx[i] * out_dx[i]) + (out_dy[i] * out_dy[i]))) - 0.5f);
+        else
+            d = std::sqrt(static_cast<float>((in_dx[i] * in_dx[i]) + (in_dy[i] * in_dy[i]))) - 0.5f;
+
+        value = 0.5f - (d / (2.0f * static_cast<float>(SDF_SPREAD)));
+        if (value < 0.0f)
+            value = 0.0f;
+        if (value > 1.0f)
+            value = 1.0f;
+        field[i] = static_cast<unsigned char>((value * 255.0f) + 0.5f);
+    }
+
+    *bitmap = field;
+
+    //the quad grows with the glyph
+    ctr->Width = W;
+    ctr->Rows = H;
+    ctr->Left -= SDF_SPREAD;
+    ctr->Top += SDF_SPREAD;
+}
+
+void glyphLoader::sweepDistance(int *dx, int *dy, int W, int H)
+{
+    //8SSEDT: two raster scans propagate to every pixel the offset of the nearest pixel with offset 0
+    int x, y;
+
+    for (y = 0; y < H; y++)
+    {
+        for (x = 0; x < W; x++)
+        {
+            compareOffset(dx, dy, W, H, x, y, -1, 0);
+            compareOffset(dx, dy, W, H, x, y, 0, -1);
+            compareOffset(dx, dy, W, H, x, y, -1, -1);
+            compareOffset(dx, dy, W, H, x, y, 1, -1);
+        }
+        for (x = W - 1; x >= 0; x--)
+            compareOffset(dx, dy, W, H, x, y, 1, 0);
+    }
+
+    for (y = H - 1; y >= 0; y--)
+    {
+        for (x = W - 1; x >= 0; x--)
+        {
+            compareOffset(dx, dy, W, H, x, y, 1, 0);
+            compareOffset(dx, dy, W, H, x, y, 0, 1);
+            compareOffset(dx, dy, W, H, x, y, -1, 1);
+            compareOffset(dx, dy, W, H, x, y, 1, 1);
+        }
+        for (x = 0; x < W; x++)
+            compareOffset(dx, dy, W, H, x, y, -1, 0);
+    }
+}
+
+void glyphLoader::compareOffset(int *dx, int *dy, int W, int H, int x, int y, int ox, int oy)
+{
+    int i, n, cx, cy;
+
+    if ((x + ox < 0) || (x + ox >= W) || (y + oy < 0) || (y + oy >= H))
+        return;
+
+    i = (y * W) + x;
+    n = ((y + oy) * W) + (x + ox);
+
+    //the neighbour's nearest pixel seen from here
+    cx = dx[n] + ox;
+    cy = dy[n] + oy;
+
+    if (((cx * cx) + (cy * cy)) < ((dx[i] * dx[i]) + (dy[i] * dy[i])))
+    {
+        dx[i] = cx;
+        dy[i] = cy;
+    }
+}
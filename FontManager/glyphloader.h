@@ -35,6 +35,7 @@
 #define GLYPHLOADER_H
 
 #include <QFile>
+#include <QByteArray>
 #include <QDataStream>
 #include <QImage>
 #include <QString>
@@ -46,6 +47,10 @@
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
+#define SDF_PIXEL_SIZE  48  //size in pixels of the em square of the distance field atlas
+#define SDF_SPREAD      6  //pixels of distance stored around each glyph
+#define SDF_FAR         10000  //offset of the pixels whose nearest edge has not been found yet
+
 typedef struct _Character {
     qint32 TextureID;
     qint32 Width;
@@ -59,6 +64,7 @@ class glyphLoader
 {
 public:
     glyphLoader(QString filename, int resolution);
+    glyphLoader(const QByteArray &fontFile, int resolution, bool sdf);  //the font has already been read in memory, sdf => distance field atlas
     ~glyphLoader();
 
     QImage getGlyphMap() { return *glyphMap; }
@@ -67,6 +73,8 @@ public:
     int getNColumns() { return maxColumns; }
 
     long long getSizeBytes() { return glyphSizeBytes; }
+    bool isSDF() { return distanceField; }
+    int getPadding() { return padding; }  //pixels added around each glyph, included in the metrics
 
 private:
     QFile *file;
@@ -81,12 +89,19 @@ private:
 
     long long glyphSizeBytes;
 
+    bool distanceField;  //the alpha stores the distance from the outline instead of the coverage
+    int padding;
+
     const int maxColumns = 16;
 
     void CreateQImage(void);
     void getMaxWidthHeight(int *width, int *height);
 
-    void loadGlyph(QString filename, int pixelSize, int NChars);
+    void loadGlyph(const QByteArray &fontFile, int pixelSize, int NChars);
+
+    void makeDistanceField(QVector<unsigned char> *bitmap, Character *ctr);
+    void sweepDistance(int *dx, int *dy, int W, int H);
+    void compareOffset(int *dx, int *dy, int W, int H, int x, int y, int ox, int oy);
 };
 
 #endif // GLYPHLOADER_H
@@ -0,0 +1,396 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :chunkcodec.cpp
+  @brief    :Functions of the Chunk Codec Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "chunkcodec.h"
+
+#include <string.h>
+#include <vector>
+
+//Writes values of up to 32 bits (MSB first) into a byte array
+//the bits are collected in a 64-bit accumulator and only the complete bytes are moved to the array
+class bitWriter
+{
+public:
+    bitWriter(QByteArray *buffer) { out = buffer; acc = 0; n_acc = 0; }
+
+    void write(uint32_t value, int n_bits)
+    {
+        if (n_bits == 0)
+            return;
+
+        acc = (acc << n_bits) | (static_cast<uint64_t>(value) & ((static_cast<uint64_t>(1) << n_bits) - 1));
+        n_acc += n_bits;
+        while (n_acc >= 8)
+        {
+            n_acc -= 8;
+            out->append(static_cast<char>(acc >> n_acc));
+        }
+        acc &= (static_cast<uint64_t>(1) << n_acc) - 1;  //less than 8 bits are left
+    }
+
+    void flush() { if (n_acc > 0) { out->append(static_cast<char>(acc << (8 - n_acc))); acc = 0; n_acc = 0; } }
+
+private:
+    QByteArray *out;
+    uint64_t acc;
+    int n_acc;  //bits waiting in the accumulator
+};
+
+//Reads back the values written by bitWriter
+//the accumulator is refilled 32 bits at a time from the raw data and each value is taken with a shift and a mask
+class bitReader
+{
+public:
+    bitReader(const QByteArray *buffer)
+    {
+        in = reinterpret_cast<const uint8_t*>(buffer->constData());
+        size = buffer->size();
+        pos = 0; acc = 0; n_acc = 0;
+    }
+
+    uint32_t read(int n_bits)
+    {
+        if (n_bits == 0)
+            return 0;
+
+        while (n_acc < n_bits)
+        {
+            if ((n_acc <= 32) && (pos + 4 <= size))
+            {
+                acc = (acc << 32) | (static_cast<uint64_t>(in[pos]) << 24) | (static_cast<uint64_t>(in[pos + 1]) << 16) |
+                      (static_cast<uint64_t>(in[pos + 2]) << 8) | static_cast<uint64_t>(in[pos + 3]);
+                pos += 4;
+                n_acc += 32;
+            }
+            else
+            {
+                acc <<= 8;
+                if (pos < size)  //the last byte is padded with zeros by the writer, past it there is nothing to read
+                    acc |= static_cast<uint64_t>(in[pos]);
+                pos++;
+                n_acc += 8;
+            }
+        }
+
+        n_acc -= n_bits;
+        return static_cast<uint32_t>((acc >> n_acc) & ((static_cast<uint64_t>(1) << n_bits) - 1));
+    }
+
+private:
+    const uint8_t *in;
+    int size;
+    int pos;  //next byte to load
+    uint64_t acc;
+    int n_acc;  //bits still unread in the accumulator
+};
+
+void chunkCodec::encodeChunk(const float *data, uint32_t N, compressedChunk *chunk)
+{
+    uint32_t i, runs;
+    bool integer;
+    QByteArray candidate;
+    std::vector<uint32_t> bits(N);
+    std::vector<int32_t> values(N);
+
+    memcpy(bits.data(), data, N * sizeof(float));
+
+    //the raw encoding is the reference
+    chunk->n_samples = N;
+    chunk->encoding = CHUNK_RAW;
+    chunk->data = QByteArray(reinterpret_cast<const char*>(data), static_cast<int>(N * sizeof(float)));
+
+    if (N == 0)
+        return;
+
+    //we check if run-length is worth it and if the values are all integers
+    runs = 1;
+    integer = true;
+    for (i = 0; i < N; i++)
+    {
+        if ((i > 0) && (bits[i] != bits[i - 1]))
+            runs++;
+        if ((data[i] != data[i]) || (data[i] > 16777216.0f) || (data[i] < -16777216.0f))  //NaN or outside the exact integer range of a float
+            integer = false;
+        else
+        {
+            uint32_t back_bits;
+            float back;
+
+            values[i] = static_cast<int32_t>(data[i]);
+            back = static_cast<float>(values[i]);
+            memcpy(&back_bits, &back, sizeof(float));
+            if (back_bits != bits[i])  //compares the bits so that also -0.0 is excluded
+                integer = false;
+        }
+    }
+
+    if (runs <= (N / 4))
+    {
+        candidate.clear();
+        encodeRLE(bits.data(), N, &candidate);
+        if (candidate.size() < chunk->data.size())
+        {
+            chunk->encoding = CHUNK_RLE;
+            chunk->data = candidate;
+        }
+    }
+
+    if (integer == true)
+    {
+        candidate.clear();
+        encodeDelta(values.data(), N, &candidate);
+        if (candidate.size() < chunk->data.size())
+        {
+            chunk->encoding = CHUNK_DELTA;
+            chunk->data = candidate;
+        }
+    }
+
+    if (chunk->encoding == CHUNK_RAW)  //if nothing better has been found we try the float compression
+    {
+        candidate.clear();
+        encodeXOR(bits.data(), N, &candidate);
+        if (candidate.size() < chunk->data.size())
+        {
+            chunk->encoding = CHUNK_XOR;
+            chunk->data = candidate;
+        }
+    }
+
+    chunk->data.squeeze();
+}
+
+void chunkCodec::decodeChunk(const compressedChunk *chunk, float *out)
+{
+    switch (chunk->encoding)
+    {
+    case CHUNK_RLE:
+        decodeRLE(&chunk->data, chunk->n_samples, reinterpret_cast<uint32_t*>(out));
+        break;
+
+    case CHUNK_DELTA:
+        decodeDelta(&chunk->data, chunk->n_samples, out);
+        break;
+
+    case CHUNK_XOR:
+        decodeXOR(&chunk->data, chunk->n_samples, reinterpret_cast<uint32_t*>(out));
+        break;
+
+    default:
+        memcpy(out, chunk->data.constData(), chunk->n_samples * sizeof(float));
+    }
+}
+
+void chunkCodec::encodeRLE(const uint32_t *bits, uint32_t N, QByteArray *out)
+{
+    uint32_t i, length;
+    bitWriter wr(out);
+
+    //each run is stored as value (32 bits) and length (32 bits)
+    length = 1;
+    for (i = 1; i <= N; i++)
+    {
+        if ((i == N) || (bits[i] != bits[i - 1]))
+        {
+            wr.write(bits[i - 1], 32);
+            wr.write(length, 32);
+            length = 1;
+        }
+        else
+            length++;
+    }
+    wr.flush();
+}
+
+void chunkCodec::encodeDelta(const int32_t *values, uint32_t N, QByteArray *out)
+{
+    uint32_t i, zz, maxZZ;
+    int width;
+    int32_t delta;
+    bitWriter wr(out);
+
+    //finds the number of bits needed for the largest zigzag encoded delta
+    maxZZ = 0;
+    for (i = 1; i < N; i++)
+    {
+        delta = values[i] - values[i - 1];
+        zz = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+        if (zz > maxZZ)
+            maxZZ = zz;
+    }
+    width = 32 - leadingZeros(maxZZ);
+
+    //first value, bit width, then all the deltas
+    wr.write(static_cast<uint32_t>(values[0]), 32);
+    wr.write(static_cast<uint32_t>(width), 6);
+    for (i = 1; i < N; i++)
+    {
+        delta = values[i] - values[i - 1];
+        zz = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+        wr.write(zz, width);
+    }
+    wr.flush();
+}
+
+void chunkCodec::encodeXOR(const uint32_t *bits, uint32_t N, QByteArray *out)
+{
+    uint32_t i, x;
+    int lead, trail, prevLead, prevTrail, length;
+    bitWriter wr(out);
+
+    wr.write(bits[0], 32);
+    prevLead = -1; prevTrail = 0;  //no window yet
+
+    for (i = 1; i < N; i++)
+    {
+        x = bits[i] ^ bits[i - 1];
+        if (x == 0)  //same value as before
+        {
+            wr.write(0, 1);
+            continue;
+        }
+        wr.write(1, 1);
+
+        lead = leadingZeros(x);
+        trail = trailingZeros(x);
+        if (lead > 31)
+            lead = 31;  //5 bits available
+
+        if ((prevLead != -1) && (lead >= prevLead) && (trail >= prevTrail))  //the meaningful bits fit into the previous window
+        {
+            wr.write(0, 1);
+            wr.write(x >> prevTrail, 32 - prevLead - prevTrail);
+        }
+        else
+        {
+            length = 32 - lead - trail;
+            wr.write(1, 1);
+            wr.write(static_cast<uint32_t>(lead), 5);
+            wr.write(static_cast<uint32_t>(length - 1), 5);
+            wr.write(x >> trail, length);
+            prevLead = lead; prevTrail = trail;
+        }
+    }
+    wr.flush();
+}
+
+void chunkCodec::decodeRLE(const QByteArray *in, uint32_t N, uint32_t *bits)
+{
+    uint32_t i, value, length;
+    bitReader rd(in);
+
+    i = 0;
+    while (i < N)
+    {
+        value = rd.read(32);
+        length = rd.read(32);
+        while ((length > 0) && (i < N))
+        {
+            bits[i++] = value;
+            length--;
+        }
+    }
+}
+
+void chunkCodec::decodeDelta(const QByteArray *in, uint32_t N, float *out)
+{
+    uint32_t i, zz;
+    int width;
+    int32_t value;
+    bitReader rd(in);
+
+    value = static_cast<int32_t>(rd.read(32));
+    width = static_cast<int>(rd.read(6));
+    out[0] = static_cast<float>(value);
+
+    for (i = 1; i < N; i++)
+    {
+        zz = rd.read(width);
+        value += static_cast<int32_t>(zz >> 1) ^ -static_cast<int32_t>(zz & 1u);
+        out[i] = static_cast<float>(value);
+    }
+}
+
+void chunkCodec::decodeXOR(const QByteArray *in, uint32_t N, uint32_t *bits)
+{
+    uint32_t i;
+    int lead, trail, length;
+    bitReader rd(in);
+
+    bits[0] = rd.read(32);
+    lead = 0; trail = 0;
+
+    for (i = 1; i < N; i++)
+    {
+        if (rd.read(1) == 0)  //same value as before
+        {
+            bits[i] = bits[i - 1];
+            continue;
+        }
+        if (rd.read(1) == 1)  //new window
+        {
+            lead = static_cast<int>(rd.read(5));
+            length = static_cast<int>(rd.read(5)) + 1;
+            trail = 32 - lead - length;
+        }
+        bits[i] = bits[i - 1] ^ (rd.read(32 - lead - trail) << trail);
+    }
+}
+
+int chunkCodec::leadingZeros(uint32_t x)
+{
+    int n = 0;
+
+    if (x == 0)
+        return 32;
+    while ((x & 0x80000000u) == 0)
+    {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+
+int chunkCodec::trailingZeros(uint32_t x)
+{
+    int n = 0;
+
+    if (x == 0)
+        return 32;
+    while ((x & 1u) == 0)
+    {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,74 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :chunkcodec.h
+  @brief    :Header of the Chunk Codec Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef CHUNKCODEC_H
+#define CHUNKCODEC_H
+
+#include <QByteArray>
+#include <stdint.h>
+
+#define CHUNK_SAMPLES   4096  //number of samples in a sealed chunk
+
+#define CHUNK_RAW       0  //samples stored as they are
+#define CHUNK_RLE       1  //run-length encoding, used for constant stretches
+#define CHUNK_DELTA     2  //delta encoding with bit-packing, used for integer values
+#define CHUNK_XOR       3  //XOR float compression as in Gorilla, used for generic floats
+
+typedef struct _compressedChunk
+{
+    uint8_t encoding;  //one of the CHUNK_ defines
+    uint32_t n_samples;  //number of samples contained in the chunk
+    QByteArray data;  //encoded samples
+} compressedChunk;
+
+//This class compresses a block of samples choosing the encoding that gives the smallest result
+class chunkCodec
+{
+public:
+    static void encodeChunk(const float *data, uint32_t N, compressedChunk *chunk);
+    static void decodeChunk(const compressedChunk *chunk, float *out);  //out must contain chunk->n_samples elements
+
+private:
+    static void encodeRLE(const uint32_t *bits, uint32_t N, QByteArray *out);
+    static void encodeDelta(const int32_t *values, uint32_t N, QByteArray *out);
+    static void encodeXOR(const uint32_t *bits, uint32_t N, QByteArray *out);
+
+    static void decodeRLE(const QByteArray *in, uint32_t N, uint32_t *bits);
+    static void decodeDelta(const QByteArray *in, uint32_t N, float *out);
+    static void decodeXOR(const QByteArray *in, uint32_t N, uint32_t *bits);
+
+    static int leadingZeros(uint32_t x);
+    static int trailingZeros(uint32_t x);
+};
+
+#endif // CHUNKCODEC_H
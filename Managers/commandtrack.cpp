@@ -0,0 +1,186 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :commandtrack.cpp
+  @brief    :Functions of the Command Track Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "commandtrack.h"
+
+commandTrack::commandTrack()
+{
+    first = 0;
+    total = 0;
+    reduced = 0;
+}
+
+void commandTrack::append(const uint8_t *cmd, int N)
+{
+    int i;
+    cmdTransition tr;
+
+    //if N is <= 0 we exit
+    if (N <= 0)
+        return;
+
+    for (i = 0; i < N; i++)
+    {
+        //only the changes of command are stored
+        if ((transitions.empty() == true) || (transitions.back().cmd != cmd[i]))
+        {
+            tr.index = total + static_cast<uint64_t>(i);
+            tr.cmd = cmd[i];
+            transitions.push_back(tr);
+        }
+    }
+
+    total += static_cast<uint64_t>(N);
+}
+
+void commandTrack::trim(uint64_t maxData)
+{
+    size_t k;
+
+    if (count() <= maxData)
+        return;
+
+    first = toAbsolute(count() - maxData);
+    if (reduced < first)
+        reduced = first;
+
+    //the transitions before first are not needed anymore, except the one still valid at first
+    k = find(first);
+    if (k > 0)
+        transitions.erase(transitions.begin(), transitions.begin() + static_cast<long>(k));
+    transitions[0].index = first;
+}
+
+void commandTrack::downsample(uint64_t keep)
+{
+    //if the full resolution part is not longer than keep we exit
+    if (countFull() <= keep + 1)
+        return;
+
+    //the transitions keep their absolute index, only the mapping of the stored samples changes
+    reduced += (countFull() - keep) & ~static_cast<uint64_t>(1);
+}
+
+void commandTrack::clear()
+{
+    transitions.clear();
+    first = total;
+    reduced = total;
+}
+
+uint8_t commandTrack::at(uint64_t idx)
+{
+    if ((transitions.empty() == true) || (idx >= count()))
+        return 0;
+
+    return transitions[find(toAbsolute(idx))].cmd;
+}
+
+QVector<cmdSegment> commandTrack::getSegments(uint8_t cmd, uint8_t end_cmd, uint64_t from, uint64_t to)
+{
+    size_t k;
+    uint64_t abs_from, abs_to, idx;
+    bool open;
+    cmdSegment seg;
+    QVector<cmdSegment> segments;
+
+    if ((transitions.empty() == true) || (from >= to))
+        return segments;
+
+    abs_from = toAbsolute(from);
+    abs_to = toAbsolute(to);
+    if (abs_to > total)
+        abs_to = total;
+
+    //we start from the transition active at from and visit only the following transitions
+    open = false;
+    seg.start = 0;
+    for (k = find(abs_from); (k < transitions.size()) && (transitions[k].index < abs_to); k++)
+    {
+        idx = transitions[k].index;
+        if (idx < abs_from)
+            idx = abs_from;
+
+        if ((open == false) && (transitions[k].cmd == cmd))
+        {
+            seg.start = toStored(idx);
+            open = true;
+        }
+        else if ((open == true) && (transitions[k].cmd == end_cmd))
+        {
+            seg.end = toStored(idx);
+            segments.append(seg);
+            open = false;
+        }
+    }
+
+    return segments;
+}
+
+size_t commandTrack::find(uint64_t abs_idx)
+{
+    size_t low, high, mid;
+
+    //binary search of the last transition with index <= abs_idx
+    low = 0;
+    high = transitions.size();
+    while (high - low > 1)
+    {
+        mid = (low + high) / 2;
+        if (transitions[mid].index <= abs_idx)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+uint64_t commandTrack::toAbsolute(uint64_t idx)
+{
+    uint64_t n_reduced;
+
+    n_reduced = (reduced - first) / 2;
+    if (idx < n_reduced)
+        return first + 2 * idx;
+
+    return reduced + (idx - n_reduced);
+}
+
+uint64_t commandTrack::toStored(uint64_t abs_idx)
+{
+    if (abs_idx < reduced)
+        return (abs_idx - first) / 2;
+
+    return (reduced - first) / 2 + (abs_idx - reduced);
+}
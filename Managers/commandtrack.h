@@ -0,0 +1,84 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :commandtrack.h
+  @brief    :Header of the Command Track Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef COMMANDTRACK_H
+#define COMMANDTRACK_H
+
+#include <QVector>
+#include <stdint.h>
+#include <vector>
+
+typedef struct _cmdTransition
+{
+    uint64_t index;  //absolute sample index at which the command starts
+    uint8_t cmd;  //command valid from index till the next transition
+} cmdTransition;
+
+typedef struct _cmdSegment
+{
+    uint64_t start;  //first sample of the segment
+    uint64_t end;  //first sample after the segment
+} cmdSegment;
+
+//This class stores the command stream as a list of transitions instead of one byte per sample
+//Sample indexes used in the interface are relative to the oldest sample still stored, as for the signals
+class commandTrack
+{
+public:
+    commandTrack();
+
+    void append(const uint8_t *cmd, int N);  //adds N samples of commands
+    void trim(uint64_t maxData);  //keeps only the last maxData samples
+    void downsample(uint64_t keep);  //halves the resolution of the samples older than the last keep full resolution samples, as done for the signals
+    void clear();
+
+    uint64_t count() { return (reduced - first) / 2 + (total - reduced); }  //number of samples stored
+    uint64_t countFull() { return total - reduced; }  //number of samples stored at full resolution
+    uint8_t at(uint64_t idx);  //command of a sample, O(log n)
+    QVector<cmdSegment> getSegments(uint8_t cmd, uint8_t end_cmd, uint64_t from, uint64_t to);  //segments starting with cmd and closed by end_cmd within [from, to)
+
+    qint64 memoryData() { return static_cast<qint64>(transitions.capacity() * sizeof(cmdTransition)); }
+
+    uint64_t toAbsolute(uint64_t idx);  //absolute index of a stored sample, i.e. its acquisition sample since the last clear
+
+private:
+    std::vector<cmdTransition> transitions;  //the first transition always starts at or before first
+    uint64_t first;  //absolute index of the oldest sample stored
+    uint64_t total;  //absolute index following the last sample stored
+    uint64_t reduced;  //absolute index of the first sample stored at full resolution, one sample every two is stored before it
+
+    size_t find(uint64_t abs_idx);  //position of the transition the sample belongs to
+    uint64_t toStored(uint64_t abs_idx);  //stored sample at or before an absolute index
+};
+
+#endif // COMMANDTRACK_H
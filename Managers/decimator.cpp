@@ -0,0 +1,81 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :decimator.cpp
+  @brief    :M4 decimation of the signals per pixel column
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "decimator.h"
+
+int m4Decimator::decimate(const float *data, int N, int columns, float *out)
+{
+    int c, j, a, b;
+    int i_min, i_max;
+    float min, max;
+
+    if ((columns <= 0) || (N < columns))
+        return 0;
+
+    for (c = 0; c < columns; c++)
+    {
+        //borders of the column, every column has at least one sample since N >= columns
+        a = static_cast<int>((static_cast<int64_t>(c) * N) / columns);
+        b = static_cast<int>((static_cast<int64_t>(c + 1) * N) / columns);
+
+        min = data[a]; max = data[a];
+        i_min = a; i_max = a;
+        for (j = a + 1; j < b; j++)
+        {
+            if (data[j] < min)
+            {
+                min = data[j];
+                i_min = j;
+            }
+            if (data[j] > max)
+            {
+                max = data[j];
+                i_max = j;
+            }
+        }
+
+        out[0] = data[a];
+        if (i_min <= i_max)
+        {
+            out[1] = min; out[2] = max;
+        }
+        else
+        {
+            out[1] = max; out[2] = min;
+        }
+        out[3] = data[b - 1];
+        out += M4_POINTS_PER_COLUMN;
+    }
+
+    return columns * M4_POINTS_PER_COLUMN;
+}
@@ -0,0 +1,52 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :decimator.h
+  @brief    :M4 decimation of the signals per pixel column
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stdint.h>
+
+#define M4_POINTS_PER_COLUMN 4  //first, min, max and last sample of each pixel column
+#define M4_AUTO_THRESHOLD 8  //points per pixel column above which the plots decimate automatically
+
+class m4Decimator
+{
+public:
+    //the N samples are divided in columns groups, each group is replaced by its first, min, max and last sample
+    //min and max are written in the order in which they occur, so the line drawn through them is the same at pixel level
+    //out must hold columns * M4_POINTS_PER_COLUMN values, the function returns the number of values written
+    static int decimate(const float *data, int N, int columns, float *out);
+    static bool isWorthwhile(int N, int columns) { return (columns > 0) && (N > (M4_AUTO_THRESHOLD * columns)); }
+};
+
+#endif // DECIMATOR_H
@@ -0,0 +1,390 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :derivedsignal.cpp
+  @brief    :Functions of the Derived Signal Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "derivedsignal.h"
+
+#include <string.h>
+
+derivedSignal::derivedSignal(QString name, QString expression)
+{
+    this->name = name;
+    this->expression = expression;
+    sig_index = 0;
+    stack_size = 0;
+    pos = 0;
+}
+
+int derivedSignal::compile(QStringList available, QString *error)
+{
+    int i, depth;
+
+    names = available;
+    inputs.clear();
+    program.clear();
+    parse_error.clear();
+    pos = 0;
+
+    if ((parseExpr() == false) || (parse_error.isEmpty() == false))
+    {
+        *error = parse_error.isEmpty() ? "Invalid expression" : parse_error;
+        return -1;
+    }
+    skipSpaces();
+    if (pos < expression.length())
+    {
+        *error = "Unexpected character '" + QString(expression.at(pos)) + "' at position " + QString::number(pos + 1);
+        return -1;
+    }
+
+    //calculates how many batch registers are needed
+    depth = 0; stack_size = 0;
+    for (i = 0; i < program.count(); i++)
+    {
+        switch (program[i].code)
+        {
+        case OP_CONST: case OP_SIGNAL:
+            depth++;
+            break;
+        case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_POW: case OP_ATAN2: case OP_MIN: case OP_MAX:
+            depth--;
+            break;
+        default:  //unary operations leave the depth unchanged
+            break;
+        }
+        if (depth > stack_size)
+            stack_size = depth;
+    }
+    registers.resize(static_cast<size_t>(stack_size));
+
+    return 0;
+}
+
+void derivedSignal::evaluate(const float **in, int N, float *out)
+{
+    int i, k, sp;
+    float *a, *b;
+    const float *src;
+
+    if ((N <= 0) || (program.count() == 0))
+        return;
+
+    for (k = 0; k < stack_size; k++)
+        if (static_cast<int>(registers[static_cast<size_t>(k)].size()) < N)
+            registers[static_cast<size_t>(k)].resize(static_cast<size_t>(N));
+
+    //each operation runs on the whole batch so that the loops can be vectorized by the compiler
+    sp = 0;
+    for (i = 0; i < program.count(); i++)
+    {
+        a = (sp >= 2) ? registers[static_cast<size_t>(sp - 2)].data() : nullptr;
+        b = (sp >= 1) ? registers[static_cast<size_t>(sp - 1)].data() : nullptr;
+
+        switch (program[i].code)
+        {
+        case OP_CONST:
+            a = registers[static_cast<size_t>(sp)].data();
+            for (k = 0; k < N; k++) a[k] = program[i].value;
+            sp++;
+            break;
+        case OP_SIGNAL:
+            a = registers[static_cast<size_t>(sp)].data();
+            src = in[program[i].arg];
+            for (k = 0; k < N; k++) a[k] = src[k];
+            sp++;
+            break;
+        case OP_ADD: for (k = 0; k < N; k++) a[k] = a[k] + b[k]; sp--; break;
+        case OP_SUB: for (k = 0; k < N; k++) a[k] = a[k] - b[k]; sp--; break;
+        case OP_MUL: for (k = 0; k < N; k++) a[k] = a[k] * b[k]; sp--; break;
+        case OP_DIV: for (k = 0; k < N; k++) a[k] = a[k] / b[k]; sp--; break;
+        case OP_POW: for (k = 0; k < N; k++) a[k] = powf(a[k], b[k]); sp--; break;
+        case OP_ATAN2: for (k = 0; k < N; k++) a[k] = atan2f(a[k], b[k]); sp--; break;
+        case OP_MIN: for (k = 0; k < N; k++) a[k] = (b[k] < a[k]) ? b[k] : a[k]; sp--; break;
+        case OP_MAX: for (k = 0; k < N; k++) a[k] = (b[k] > a[k]) ? b[k] : a[k]; sp--; break;
+        case OP_NEG: for (k = 0; k < N; k++) b[k] = -b[k]; break;
+        case OP_SIN: for (k = 0; k < N; k++) b[k] = sinf(b[k]); break;
+        case OP_COS: for (k = 0; k < N; k++) b[k] = cosf(b[k]); break;
+        case OP_TAN: for (k = 0; k < N; k++) b[k] = tanf(b[k]); break;
+        case OP_SQRT: for (k = 0; k < N; k++) b[k] = sqrtf(b[k]); break;
+        case OP_ABS: for (k = 0; k < N; k++) b[k] = fabsf(b[k]); break;
+        case OP_EXP: for (k = 0; k < N; k++) b[k] = expf(b[k]); break;
+        case OP_LOG: for (k = 0; k < N; k++) b[k] = logf(b[k]); break;
+        }
+    }
+
+    memcpy(out, registers[0].data(), static_cast<size_t>(N) * sizeof(float));
+}
+
+bool derivedSignal::parseExpr()
+{
+    QChar c;
+
+    if (parseTerm() == false)
+        return false;
+
+    skipSpaces();
+    while (pos < expression.length())
+    {
+        c = expression.at(pos);
+        if ((c != '+') && (c != '-'))
+            break;
+        pos++;
+        if (parseTerm() == false)
+            return false;
+        emit_op((c == '+') ? OP_ADD : OP_SUB, 0, 0.0f);
+        skipSpaces();
+    }
+    return true;
+}
+
+bool derivedSignal::parseTerm()
+{
+    QChar c;
+
+    if (parseUnary() == false)
+        return false;
+
+    skipSpaces();
+    while (pos < expression.length())
+    {
+        c = expression.at(pos);
+        if ((c != '*') && (c != '/'))
+            break;
+        pos++;
+        if (parseUnary() == false)
+            return false;
+        emit_op((c == '*') ? OP_MUL : OP_DIV, 0, 0.0f);
+        skipSpaces();
+    }
+    return true;
+}
+
+bool derivedSignal::parseUnary()
+{
+    skipSpaces();
+    if ((pos < expression.length()) && (expression.at(pos) == '-'))
+    {
+        pos++;
+        if (parseUnary() == false)
+            return false;
+        emit_op(OP_NEG, 0, 0.0f);
+        return true;
+    }
+    if ((pos < expression.length()) && (expression.at(pos) == '+'))
+    {
+        pos++;
+        return parseUnary();
+    }
+    return parsePower();
+}
+
+bool derivedSignal::parsePower()
+{
+    if (parsePrimary() == false)
+        return false;
+
+    skipSpaces();
+    if ((pos < expression.length()) && (expression.at(pos) == '^'))
+    {
+        pos++;
+        if (parseUnary() == false)  //right associative
+            return false;
+        emit_op(OP_POW, 0, 0.0f);
+    }
+    return true;
+}
+
+bool derivedSignal::parsePrimary()
+{
+    int start, n_args, slot;
+    QString id;
+    bool ok;
+    float value;
+
+    skipSpaces();
+    if (pos >= expression.length())
+    {
+        parse_error = "Unexpected end of the expression";
+        return false;
+    }
+
+    //parenthesis
+    if (expression.at(pos) == '(')
+    {
+        pos++;
+        if (parseExpr() == false)
+            return false;
+        skipSpaces();
+        if ((pos >= expression.length()) || (expression.at(pos) != ')'))
+        {
+            parse_error = "Missing ')' at position " + QString::number(pos + 1);
+            return false;
+        }
+        pos++;
+        return true;
+    }
+
+    //number
+    if ((expression.at(pos).isDigit() == true) || (expression.at(pos) == '.'))
+    {
+        start = pos;
+        while ((pos < expression.length()) && ((expression.at(pos).isDigit() == true) || (expression.at(pos) == '.')))
+            pos++;
+        if ((pos < expression.length()) && ((expression.at(pos) == 'e') || (expression.at(pos) == 'E')))  //exponent
+        {
+            pos++;
+            if ((pos < expression.length()) && ((expression.at(pos) == '+') || (expression.at(pos) == '-')))
+                pos++;
+            while ((pos < expression.length()) && (expression.at(pos).isDigit() == true))
+                pos++;
+        }
+        value = expression.mid(start, pos - start).toFloat(&ok);
+        if (ok == false)
+        {
+            parse_error = "Invalid number at position " + QString::number(start + 1);
+            return false;
+        }
+        emit_op(OP_CONST, 0, value);
+        return true;
+    }
+
+    //signal name between braces
+    if (expression.at(pos) == '{')
+    {
+        start = pos + 1;
+        while ((pos < expression.length()) && (expression.at(pos) != '}'))
+            pos++;
+        if (pos >= expression.length())
+        {
+            parse_error = "Missing '}' after the signal name";
+            return false;
+        }
+        id = expression.mid(start, pos - start);
+        pos++;
+    }
+    else if ((expression.at(pos).isLetter() == true) || (expression.at(pos) == '_'))  //identifier
+    {
+        start = pos;
+        while ((pos < expression.length()) && ((expression.at(pos).isLetterOrNumber() == true) || (expression.at(pos) == '_') || (expression.at(pos) == '.')))
+            pos++;
+        id = expression.mid(start, pos - start);
+
+        //function call
+        skipSpaces();
+        if ((pos < expression.length()) && (expression.at(pos) == '(') && (names.contains(id) == false))
+        {
+            pos++;
+            n_args = 0;
+            skipSpaces();
+            if ((pos < expression.length()) && (expression.at(pos) != ')'))
+            {
+                while (true)
+                {
+                    if (parseExpr() == false)
+                        return false;
+                    n_args++;
+                    skipSpaces();
+                    if ((pos >= expression.length()) || (expression.at(pos) != ','))
+                        break;
+                    pos++;
+                }
+            }
+            if ((pos >= expression.length()) || (expression.at(pos) != ')'))
+            {
+                parse_error = "Missing ')' after the arguments of " + id;
+                return false;
+            }
+            pos++;
+
+            if ((n_args == 1) && (id == "sin")) emit_op(OP_SIN, 0, 0.0f);
+            else if ((n_args == 1) && (id == "cos")) emit_op(OP_COS, 0, 0.0f);
+            else if ((n_args == 1) && (id == "tan")) emit_op(OP_TAN, 0, 0.0f);
+            else if ((n_args == 1) && (id == "sqrt")) emit_op(OP_SQRT, 0, 0.0f);
+            else if ((n_args == 1) && (id == "abs")) emit_op(OP_ABS, 0, 0.0f);
+            else if ((n_args == 1) && (id == "exp")) emit_op(OP_EXP, 0, 0.0f);
+            else if ((n_args == 1) && (id == "log")) emit_op(OP_LOG, 0, 0.0f);
+            else if ((n_args == 2) && (id == "atan2")) emit_op(OP_ATAN2, 0, 0.0f);
+            else if ((n_args == 2) && (id == "min")) emit_op(OP_MIN, 0, 0.0f);
+            else if ((n_args == 2) && (id == "max")) emit_op(OP_MAX, 0, 0.0f);
+            else if ((n_args == 2) && (id == "pow")) emit_op(OP_POW, 0, 0.0f);
+            else
+            {
+                parse_error = "Unknown function " + id + " with " + QString::number(n_args) + " arguments";
+                return false;
+            }
+            return true;
+        }
+
+        if ((id == "pi") && (names.contains(id) == false))
+        {
+            emit_op(OP_CONST, 0, static_cast<float>(M_PI));
+            return true;
+        }
+    }
+    else
+    {
+        parse_error = "Unexpected character '" + QString(expression.at(pos)) + "' at position " + QString::number(pos + 1);
+        return false;
+    }
+
+    //at this point id is a signal name
+    if (names.contains(id) == false)
+    {
+        parse_error = "Unknown signal " + id;
+        return false;
+    }
+    slot = inputs.indexOf(id);
+    if (slot == -1)
+    {
+        inputs.append(id);
+        slot = inputs.count() - 1;
+    }
+    emit_op(OP_SIGNAL, slot, 0.0f);
+
+    return true;
+}
+
+void derivedSignal::skipSpaces()
+{
+    while ((pos < expression.length()) && (expression.at(pos).isSpace() == true))
+        pos++;
+}
+
+void derivedSignal::emit_op(math_op_t code, int arg, float value)
+{
+    mathOp op;
+
+    op.code = code;
+    op.arg = arg;
+    op.value = value;
+    program.append(op);
+}
@@ -0,0 +1,104 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :derivedsignal.h
+  @brief    :Header of the Derived Signal Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef DERIVEDSIGNAL_H
+#define DERIVEDSIGNAL_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <vector>
+
+#include <math.h>
+
+#define DERIVED_SIG_TYPE    7  //signal type used for the derived signals in the signal pool
+
+typedef enum {OP_CONST, OP_SIGNAL, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_NEG,
+              OP_SIN, OP_COS, OP_TAN, OP_SQRT, OP_ABS, OP_EXP, OP_LOG, OP_ATAN2, OP_MIN, OP_MAX} math_op_t;
+
+typedef struct _mathOp
+{
+    math_op_t code;
+    int arg;  //input slot for OP_SIGNAL
+    float value;  //constant for OP_CONST
+} mathOp;
+
+//This class describes a signal calculated on the host from other signals
+//The expression is compiled once into a list of operations, each one working on a whole batch of samples
+//Syntax: + - * / ^, parentheses, numbers, pi, signal names (names with spaces or symbols between braces, e.g. {i phase a})
+//Functions: sin cos tan sqrt abs exp log atan2(y,x) min(a,b) max(a,b)
+class derivedSignal
+{
+public:
+    derivedSignal(QString name, QString expression);
+
+    int compile(QStringList available, QString *error);  //returns 0 if the expression is valid, -1 otherwise
+    void evaluate(const float **inputs, int N, float *out);  //inputs follow the order of getInputs()
+
+    QString getName() { return name; }
+    QString getExpression() { return expression; }
+    QStringList getInputs() { return inputs; }
+
+    void setSignalIndex(uint32_t idx) { sig_index = idx; }
+    uint32_t getSignalIndex() { return sig_index; }
+    void setInputIndexes(QVector<uint32_t> idx) { input_indexes = idx; }
+    QVector<uint32_t> getInputIndexes() { return input_indexes; }
+    void setInputPositions(QVector<uint64_t> pos) { input_positions = pos; }
+    QVector<uint64_t> getInputPositions() { return input_positions; }
+
+private:
+    QString name;
+    QString expression;
+    uint32_t sig_index;  //index of the signal in the pool where the results are stored
+    QStringList inputs;  //names of the signals used by the expression
+    QVector<uint32_t> input_indexes;  //indexes in the pool of the signals used by the expression
+    QVector<uint64_t> input_positions;  //absolute position (received samples) of the next sample of each input to be calculated
+
+    QVector<mathOp> program;  //operations in reverse polish notation
+    int stack_size;  //number of batch registers needed by the program
+    std::vector<std::vector<float>> registers;
+
+    //parser
+    int pos;
+    QString parse_error;
+    QStringList names;
+    bool parseExpr();
+    bool parseTerm();
+    bool parseUnary();
+    bool parsePower();
+    bool parsePrimary();
+    void skipSpaces();
+    void emit_op(math_op_t code, int arg, float value);
+};
+
+#endif // DERIVEDSIGNAL_H
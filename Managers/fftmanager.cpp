@@ -258,6 +258,16 @@ void fftManager::updateSigData(int wdwIdx, int sigIdx, float *data, int N_data)
     memcpy(windowPool[i].sig_data[j].data(), data + start, N * sizeof(float));
 }
 
+int fftManager::getNSamples(int wdwIdx)
+{
+    int i = findWindow(wdwIdx);
+
+    if (i == -1)
+        return 0;
+
+    return windowPool[i].n_Samples;
+}
+
 QString fftManager::getWindowName(int wdwIdx, bool *ok)
 {
     QString ret;
@@ -340,6 +350,25 @@ void fftManager::checkGrids(int *n, int *m)
     *n = a; *m = b;
 }
 
+qint64 fftManager::getMemoryData()
+{
+    int i, j;
+    qint64 floats, bytes;
+
+    floats = 0; bytes = 0;
+    for (i = 0; i < windowPool.count(); i++)
+    {
+        for (j = 0; j < windowPool[i].sig_data.count(); j++)
+            floats += windowPool[i].sig_data[j].capacity();
+        for (j = 0; j < windowPool[i].fft_data.count(); j++)
+            floats += windowPool[i].fft_data[j].capacity();
+        floats += windowPool[i].nullVector.capacity();
+        bytes += windowPool[i].fftWnd->getStagingMemory();
+    }
+
+    return bytes + (floats * static_cast<qint64>(sizeof(float)));
+}
+
 void fftManager::setAllGrids(bool en)
 {
     int i;
@@ -358,6 +387,9 @@ void fftManager::jobHasFinished()
 
     for (i = 0; i < windowPool.count(); i++)
     {
+        if (renderScheduler::isShown(windowPool[i].fftWnd) == false)
+            continue;  //nobody can see it, it will get the spectrum of the next calculation
+
         data = new float*[windowPool[i].N_sig];
         for (j = 0; j < windowPool[i].fft_data.count(); j++)
         {
@@ -366,11 +398,16 @@ void fftManager::jobHasFinished()
 
         windowPool[i].fftWnd->parallel_prepare_Signal_Data(windowPool[i].N_sig, (windowPool[i].n_Samples >> 1) + 1, data, windowPool[i].sigCol.data(), windowPool[i].line_width.data(), windowPool[i].sig_name.data());
 
-        windowPool[i].fftWnd->update();
-
         delete data;
     }
 
+    //all the windows have been started before waiting for the first one, so that their signals are prepared together
+    for (i = 0; i < windowPool.count(); i++)
+    {
+        if (windowPool[i].fftWnd->complete_Signal_Data() == 0)
+            windowPool[i].fftWnd->update();
+    }
+
     status = false;  //the manager is now free
 }
 
@@ -55,6 +55,7 @@
 #include "Dialogs/fft_plot_window.h"
 #include "FontManager/fontmanager.h"
 #include "prefmanager.h"
+#include "renderscheduler.h"
 
 #include "3rdparty/kissFFT/kiss_fftr.h"
 
@@ -96,6 +97,7 @@ public:
     QVector<int> getSignalIndexPerWindow(int wdwIdx);
 
     void updateSigData(int wdwIdx, int sigIdx, float *data, int N_data);
+    int getNSamples(int wdwIdx);  //samples used by the FFT of a window
 
     bool getStatus() { return status; }
 
@@ -109,6 +111,8 @@ public:
     void checkGrids(int *n, int *m);
     void setAllGrids(bool en);
 
+    qint64 getMemoryData();  //bytes allocated by the FFT windows
+
     appPreferencesStruct *preferences;
     fontManager *fontMgr;  //it manages all the fonts
 
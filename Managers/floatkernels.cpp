@@ -0,0 +1,638 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :floatkernels.cpp
+  @brief    :Vectorized kernels over float spans, selected at run time
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "floatkernels.h"
+
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define KERNEL_TARGET_AVX2  //MSVC accepts the AVX2 intrinsics in any function
+#else
+#define KERNEL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+typedef struct _kernelTable
+{
+    void (*reduce)(const float *data, int N, spanReduction *out);
+    double (*deviations)(const float *data, int N, double mean);
+    int (*first)(const float *data, int from, int to, float level, int edge);
+    int (*last)(const float *data, int from, int to, float level, int edge);
+    const char *name;
+} kernelTable;
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+//scalar versions, also used for the samples left over by the vector loops
+
+static void reduce_scalar(const float *data, int N, spanReduction *out)
+{
+    int k;
+    float x;
+
+    for (k = 0; k < N; k++)
+    {
+        x = data[k];
+        if (std::isfinite(x) == false)
+            continue;
+        if (x < out->min)
+            out->min = x;
+        if (x > out->max)
+            out->max = x;
+        out->sum += static_cast<double>(x);
+        out->sumsq += static_cast<double>(x) * static_cast<double>(x);
+        out->finite++;
+    }
+}
+
+static double deviations_scalar(const float *data, int N, double mean)
+{
+    int k;
+    double d, m2;
+
+    m2 = 0.0;
+    for (k = 0; k < N; k++)
+    {
+        if (std::isfinite(data[k]) == false)
+            continue;
+        d = static_cast<double>(data[k]) - mean;
+        m2 += d * d;
+    }
+
+    return m2;
+}
+
+static inline bool crossing(const float *data, int k, float level, int edge)
+{
+    if (edge == KERNEL_EDGE_RISING)
+        return (data[k - 1] < level) && (data[k] >= level);
+    return (data[k - 1] > level) && (data[k] <= level);
+}
+
+static int first_scalar(const float *data, int from, int to, float level, int edge)
+{
+    int k;
+
+    for (k = from; k < to; k++)
+        if (crossing(data, k, level, edge) == true)
+            return k;
+
+    return -1;
+}
+
+static int last_scalar(const float *data, int from, int to, float level, int edge)
+{
+    int k;
+
+    for (k = to - 1; k >= from; k--)
+        if (crossing(data, k, level, edge) == true)
+            return k;
+
+    return -1;
+}
+
+#ifdef KERNEL_X86
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+//SSE2, always available on x86-64
+//a sample is finite when sample * 0 is not NAN
+
+static inline int lowest_bit(unsigned int bits)
+{
+    int i;
+
+    i = 0;
+    while ((bits & 1u) == 0)
+    {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+}
+
+static inline int highest_bit(unsigned int bits)
+{
+    int i;
+
+    i = -1;
+    while (bits != 0)
+    {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+}
+
+static void reduce_sse2(const float *data, int N, spanReduction *out)
+{
+    int k;
+    float lanes[4];
+    double dl[2];
+    int32_t counts[4];
+    __m128 x, z, m, xm, vmin, vmax, inf, ninf, zero;
+    __m128d s0, s1, q0, q1, lo, hi;
+    __m128i cnt;
+
+    inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    ninf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    zero = _mm_setzero_ps();
+    vmin = inf; vmax = ninf;
+    s0 = _mm_setzero_pd(); s1 = s0; q0 = s0; q1 = s0;
+    cnt = _mm_setzero_si128();
+
+    for (k = 0; k + 4 <= N; k += 4)
+    {
+        x = _mm_loadu_ps(data + k);
+        z = _mm_mul_ps(x, zero);
+        m = _mm_cmpord_ps(z, z);
+        xm = _mm_and_ps(m, x);  //0 in place of the non finite samples
+        vmin = _mm_min_ps(vmin, _mm_or_ps(xm, _mm_andnot_ps(m, inf)));
+        vmax = _mm_max_ps(vmax, _mm_or_ps(xm, _mm_andnot_ps(m, ninf)));
+        cnt = _mm_sub_epi32(cnt, _mm_castps_si128(m));
+        lo = _mm_cvtps_pd(xm);
+        hi = _mm_cvtps_pd(_mm_movehl_ps(xm, xm));
+        s0 = _mm_add_pd(s0, lo); s1 = _mm_add_pd(s1, hi);
+        q0 = _mm_add_pd(q0, _mm_mul_pd(lo, lo)); q1 = _mm_add_pd(q1, _mm_mul_pd(hi, hi));
+    }
+
+    _mm_storeu_ps(lanes, vmin);
+    for (int i = 0; i < 4; i++)
+        if (lanes[i] < out->min)
+            out->min = lanes[i];
+    _mm_storeu_ps(lanes, vmax);
+    for (int i = 0; i < 4; i++)
+        if (lanes[i] > out->max)
+            out->max = lanes[i];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(counts), cnt);
+    out->finite += static_cast<int64_t>(counts[0]) + counts[1] + counts[2] + counts[3];
+    _mm_storeu_pd(dl, _mm_add_pd(s0, s1));
+    out->sum += dl[0] + dl[1];
+    _mm_storeu_pd(dl, _mm_add_pd(q0, q1));
+    out->sumsq += dl[0] + dl[1];
+
+    reduce_scalar(data + k, N - k, out);
+}
+
+static double deviations_sse2(const float *data, int N, double mean)
+{
+    int k;
+    double dl[2];
+    __m128 x, z, m, xm, one, zero, w;
+    __m128d vmean, acc, lo, hi;
+
+    one = _mm_set1_ps(1.0f);
+    zero = _mm_setzero_ps();
+    vmean = _mm_set1_pd(mean);
+    acc = _mm_setzero_pd();
+
+    for (k = 0; k + 4 <= N; k += 4)
+    {
+        x = _mm_loadu_ps(data + k);
+        z = _mm_mul_ps(x, zero);
+        m = _mm_cmpord_ps(z, z);
+        xm = _mm_and_ps(m, x);
+        w = _mm_and_ps(m, one);  //weight 1 for the finite samples, 0 for the others
+        lo = _mm_sub_pd(_mm_cvtps_pd(xm), vmean);
+        hi = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(xm, xm)), vmean);
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_mul_pd(lo, lo), _mm_cvtps_pd(w)));
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_mul_pd(hi, hi), _mm_cvtps_pd(_mm_movehl_ps(w, w))));
+    }
+
+    _mm_storeu_pd(dl, acc);
+    return dl[0] + dl[1] + deviations_scalar(data + k, N - k, mean);
+}
+
+static inline int crossing_mask_sse2(const float *data, int k, __m128 level, int edge)
+{
+    __m128 prev, cur;
+
+    prev = _mm_loadu_ps(data + k - 1);
+    cur = _mm_loadu_ps(data + k);
+    if (edge == KERNEL_EDGE_RISING)
+        return _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(prev, level), _mm_cmpge_ps(cur, level)));
+    return _mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(prev, level), _mm_cmple_ps(cur, level)));
+}
+
+static int first_sse2(const float *data, int from, int to, float level, int edge)
+{
+    int k, bits;
+    __m128 lvl;
+
+    lvl = _mm_set1_ps(level);
+    for (k = from; k + 4 <= to; k += 4)
+    {
+        bits = crossing_mask_sse2(data, k, lvl, edge);
+        if (bits != 0)
+            return k + lowest_bit(static_cast<unsigned int>(bits));
+    }
+
+    return first_scalar(data, k, to, level, edge);
+}
+
+static int last_sse2(const float *data, int from, int to, float level, int edge)
+{
+    int k, bits, res;
+    __m128 lvl;
+
+    lvl = _mm_set1_ps(level);
+    for (k = to - 4; k >= from; k -= 4)
+    {
+        bits = crossing_mask_sse2(data, k, lvl, edge);
+        if (bits != 0)
+            return k + highest_bit(static_cast<unsigned int>(bits));
+    }
+
+    res = last_scalar(data, from, k + 4, level, edge);  //the first samples which do not fill a vector
+    return res;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+//AVX2
+
+KERNEL_TARGET_AVX2 static void reduce_avx2(const float *data, int N, spanReduction *out)
+{
+    int k;
+    float lanes[8];
+    double dl[4];
+    int32_t counts[8];
+    __m256 x, z, m, xm, vmin, vmax, inf, ninf, zero;
+    __m256d s0, s1, q0, q1, lo, hi;
+    __m256i cnt;
+
+    inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    ninf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    zero = _mm256_setzero_ps();
+    vmin = inf; vmax = ninf;
+    s0 = _mm256_setzero_pd(); s1 = s0; q0 = s0; q1 = s0;
+    cnt = _mm256_setzero_si256();
+
+    for (k = 0; k + 8 <= N; k += 8)
+    {
+        x = _mm256_loadu_ps(data + k);
+        z = _mm256_mul_ps(x, zero);
+        m = _mm256_cmp_ps(z, z, _CMP_ORD_Q);
+        xm = _mm256_and_ps(m, x);
+        vmin = _mm256_min_ps(vmin, _mm256_blendv_ps(inf, x, m));
+        vmax = _mm256_max_ps(vmax, _mm256_blendv_ps(ninf, x, m));
+        cnt = _mm256_sub_epi32(cnt, _mm256_castps_si256(m));
+        lo = _mm256_cvtps_pd(_mm256_castps256_ps128(xm));
+        hi = _mm256_cvtps_pd(_mm256_extractf128_ps(xm, 1));
+        s0 = _mm256_add_pd(s0, lo); s1 = _mm256_add_pd(s1, hi);
+        q0 = _mm256_fmadd_pd(lo, lo, q0); q1 = _mm256_fmadd_pd(hi, hi, q1);
+    }
+
+    _mm256_storeu_ps(lanes, vmin);
+    for (int i = 0; i < 8; i++)
+        if (lanes[i] < out->min)
+            out->min = lanes[i];
+    _mm256_storeu_ps(lanes, vmax);
+    for (int i = 0; i < 8; i++)
+        if (lanes[i] > out->max)
+            out->max = lanes[i];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(counts), cnt);
+    for (int i = 0; i < 8; i++)
+        out->finite += counts[i];
+    _mm256_storeu_pd(dl, _mm256_add_pd(s0, s1));
+    out->sum += (dl[0] + dl[1]) + (dl[2] + dl[3]);
+    _mm256_storeu_pd(dl, _mm256_add_pd(q0, q1));
+    out->sumsq += (dl[0] + dl[1]) + (dl[2] + dl[3]);
+
+    reduce_scalar(data + k, N - k, out);
+}
+
+KERNEL_TARGET_AVX2 static double deviations_avx2(const float *data, int N, double mean)
+{
+    int k;
+    double dl[4];
+    __m256 x, z, m, xm, w, one, zero;
+    __m256d vmean, acc, lo, hi;
+
+    one = _mm256_set1_ps(1.0f);
+    zero = _mm256_setzero_ps();
+    vmean = _mm256_set1_pd(mean);
+    acc = _mm256_setzero_pd();
+
+    for (k = 0; k + 8 <= N; k += 8)
+    {
+        x = _mm256_loadu_ps(data + k);
+        z = _mm256_mul_ps(x, zero);
+        m = _mm256_cmp_ps(z, z, _CMP_ORD_Q);
+        xm = _mm256_and_ps(m, x);
+        w = _mm256_and_ps(m, one);
+        lo = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(xm)), vmean);
+        hi = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(xm, 1)), vmean);
+        acc = _mm256_fmadd_pd(_mm256_mul_pd(lo, lo), _mm256_cvtps_pd(_mm256_castps256_ps128(w)), acc);
+        acc = _mm256_fmadd_pd(_mm256_mul_pd(hi, hi), _mm256_cvtps_pd(_mm256_extractf128_ps(w, 1)), acc);
+    }
+
+    _mm256_storeu_pd(dl, acc);
+    return (dl[0] + dl[1]) + (dl[2] + dl[3]) + deviations_scalar(data + k, N - k, mean);
+}
+
+KERNEL_TARGET_AVX2 static inline int crossing_mask_avx2(const float *data, int k, __m256 level, int edge)
+{
+    __m256 prev, cur;
+
+    prev = _mm256_loadu_ps(data + k - 1);
+    cur = _mm256_loadu_ps(data + k);
+    if (edge == KERNEL_EDGE_RISING)
+        return _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(prev, level, _CMP_LT_OQ), _mm256_cmp_ps(cur, level, _CMP_GE_OQ)));
+    return _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(prev, level, _CMP_GT_OQ), _mm256_cmp_ps(cur, level, _CMP_LE_OQ)));
+}
+
+KERNEL_TARGET_AVX2 static int first_avx2(const float *data, int from, int to, float level, int edge)
+{
+    int k, bits;
+    __m256 lvl;
+
+    lvl = _mm256_set1_ps(level);
+    for (k = from; k + 8 <= to; k += 8)
+    {
+        bits = crossing_mask_avx2(data, k, lvl, edge);
+        if (bits != 0)
+            return k + lowest_bit(static_cast<unsigned int>(bits));
+    }
+
+    return first_scalar(data, k, to, level, edge);
+}
+
+KERNEL_TARGET_AVX2 static int last_avx2(const float *data, int from, int to, float level, int edge)
+{
+    int k, bits;
+    __m256 lvl;
+
+    lvl = _mm256_set1_ps(level);
+    for (k = to - 8; k >= from; k -= 8)
+    {
+        bits = crossing_mask_avx2(data, k, lvl, edge);
+        if (bits != 0)
+            return k + highest_bit(static_cast<unsigned int>(bits));
+    }
+
+    return last_scalar(data, from, k + 8, level, edge);
+}
+
+static bool cpu_has_avx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    unsigned long long xcr0;
+
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    if (((regs[2] & (1 << 27)) == 0) || ((regs[2] & (1 << 12)) == 0))  //OSXSAVE and FMA
+        return false;
+    xcr0 = _xgetbv(0);
+    if ((xcr0 & 6) != 6)  //the OS saves the YMM registers
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("avx2") != 0) && (__builtin_cpu_supports("fma") != 0);
+#endif
+}
+#endif
+
+#ifdef KERNEL_NEON
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+//NEON, always available on ARM 64
+
+static void reduce_neon(const float *data, int N, spanReduction *out)
+{
+    int k;
+    float32x4_t x, z, xm, vmin, vmax, inf, ninf;
+    uint32x4_t m, cnt;
+    float64x2_t s0, s1, q0, q1, lo, hi;
+
+    inf = vdupq_n_f32(std::numeric_limits<float>::infinity());
+    ninf = vdupq_n_f32(-std::numeric_limits<float>::infinity());
+    vmin = inf; vmax = ninf;
+    s0 = vdupq_n_f64(0.0); s1 = s0; q0 = s0; q1 = s0;
+    cnt = vdupq_n_u32(0);
+
+    for (k = 0; k + 4 <= N; k += 4)
+    {
+        x = vld1q_f32(data + k);
+        z = vmulq_n_f32(x, 0.0f);
+        m = vceqq_f32(z, z);
+        xm = vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(x)));
+        vmin = vminq_f32(vmin, vbslq_f32(m, x, inf));
+        vmax = vmaxq_f32(vmax, vbslq_f32(m, x, ninf));
+        cnt = vsubq_u32(cnt, m);
+        lo = vcvt_f64_f32(vget_low_f32(xm));
+        hi = vcvt_high_f64_f32(xm);
+        s0 = vaddq_f64(s0, lo); s1 = vaddq_f64(s1, hi);
+        q0 = vfmaq_f64(q0, lo, lo); q1 = vfmaq_f64(q1, hi, hi);
+    }
+
+    if (vminvq_f32(vmin) < out->min)
+        out->min = vminvq_f32(vmin);
+    if (vmaxvq_f32(vmax) > out->max)
+        out->max = vmaxvq_f32(vmax);
+    out->finite += vaddvq_u32(cnt);
+    out->sum += vaddvq_f64(vaddq_f64(s0, s1));
+    out->sumsq += vaddvq_f64(vaddq_f64(q0, q1));
+
+    reduce_scalar(data + k, N - k, out);
+}
+
+static double deviations_neon(const float *data, int N, double mean)
+{
+    int k;
+    float32x4_t x, z, xm, w;
+    uint32x4_t m;
+    float64x2_t vmean, acc, lo, hi;
+
+    vmean = vdupq_n_f64(mean);
+    acc = vdupq_n_f64(0.0);
+
+    for (k = 0; k + 4 <= N; k += 4)
+    {
+        x = vld1q_f32(data + k);
+        z = vmulq_n_f32(x, 0.0f);
+        m = vceqq_f32(z, z);
+        xm = vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(x)));
+        w = vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+        lo = vsubq_f64(vcvt_f64_f32(vget_low_f32(xm)), vmean);
+        hi = vsubq_f64(vcvt_high_f64_f32(xm), vmean);
+        acc = vfmaq_f64(acc, vmulq_f64(lo, lo), vcvt_f64_f32(vget_low_f32(w)));
+        acc = vfmaq_f64(acc, vmulq_f64(hi, hi), vcvt_high_f64_f32(w));
+    }
+
+    return vaddvq_f64(acc) + deviations_scalar(data + k, N - k, mean);
+}
+
+static inline uint32x4_t crossing_mask_neon(const float *data, int k, float32x4_t level, int edge)
+{
+    float32x4_t prev, cur;
+
+    prev = vld1q_f32(data + k - 1);
+    cur = vld1q_f32(data + k);
+    if (edge == KERNEL_EDGE_RISING)
+        return vandq_u32(vcltq_f32(prev, level), vcgeq_f32(cur, level));
+    return vandq_u32(vcgtq_f32(prev, level), vcleq_f32(cur, level));
+}
+
+static int first_neon(const float *data, int from, int to, float level, int edge)
+{
+    int k;
+    float32x4_t lvl;
+
+    lvl = vdupq_n_f32(level);
+    for (k = from; k + 4 <= to; k += 4)
+        if (vmaxvq_u32(crossing_mask_neon(data, k, lvl, edge)) != 0)
+            return first_scalar(data, k, k + 4, level, edge);
+
+    return first_scalar(data, k, to, level, edge);
+}
+
+static int last_neon(const float *data, int from, int to, float level, int edge)
+{
+    int k;
+    float32x4_t lvl;
+
+    lvl = vdupq_n_f32(level);
+    for (k = to - 4; k >= from; k -= 4)
+        if (vmaxvq_u32(crossing_mask_neon(data, k, lvl, edge)) != 0)
+            return last_scalar(data, k, k + 4, level, edge);
+
+    return last_scalar(data, from, k + 4, level, edge);
+}
+#endif
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const kernelTable *select_kernels()
+{
+#ifdef KERNEL_X86
+    static const kernelTable avx2 = {reduce_avx2, deviations_avx2, first_avx2, last_avx2, "AVX2"};
+    static const kernelTable sse2 = {reduce_sse2, deviations_sse2, first_sse2, last_sse2, "SSE2"};
+
+    if (cpu_has_avx2() == true)
+        return &avx2;
+    return &sse2;
+#elif defined(KERNEL_NEON)
+    static const kernelTable neon = {reduce_neon, deviations_neon, first_neon, last_neon, "NEON"};
+
+    return &neon;
+#else
+    static const kernelTable scalar = {reduce_scalar, deviations_scalar, first_scalar, last_scalar, "scalar"};
+
+    return &scalar;
+#endif
+}
+
+static const kernelTable *kernels()
+{
+    static const kernelTable *table = select_kernels();  //initialized once, also when called from several threads
+
+    return table;
+}
+
+void floatKernels::reduce(const float *data, int N, spanReduction *out)
+{
+    out->min = std::numeric_limits<float>::infinity();
+    out->max = -std::numeric_limits<float>::infinity();
+    out->sum = 0.0;
+    out->sumsq = 0.0;
+    out->finite = 0;
+
+    if (N > 0)
+        kernels()->reduce(data, N, out);
+}
+
+double floatKernels::sumSquaredDeviations(const float *data, int N, double mean)
+{
+    if (N <= 0)
+        return 0.0;
+
+    return kernels()->deviations(data, N, mean);
+}
+
+int floatKernels::findCrossing(const float *data, int from, int to, float level, int edge)
+{
+    if (from < 1)
+        from = 1;
+    if (from >= to)
+        return -1;
+
+    return kernels()->first(data, from, to, level, edge);
+}
+
+int floatKernels::findLastCrossing(const float *data, int from, int to, float level, int edge)
+{
+    if (from < 1)
+        from = 1;
+    if (from >= to)
+        return -1;
+
+    return kernels()->last(data, from, to, level, edge);
+}
+
+bool floatKernels::rangeOfSignals(int n_signals, int start, int end, float **buff_ptr, float *min, float *max)
+{
+    int i;
+    bool found;
+    spanReduction r;
+
+    found = false;
+    for (i = 0; i < n_signals; i++)
+    {
+        reduce(buff_ptr[i] + start, end - start + 1, &r);
+        if (r.finite == 0)
+            continue;
+        if ((found == false) || (r.min < *min))
+            *min = r.min;
+        if ((found == false) || (r.max > *max))
+            *max = r.max;
+        found = true;
+    }
+
+    return found;
+}
+
+const char *floatKernels::getInstructionSet()
+{
+    return kernels()->name;
+}
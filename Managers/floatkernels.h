@@ -0,0 +1,68 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :floatkernels.h
+  @brief    :Header of the vectorized kernels over float spans
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef FLOATKERNELS_H
+#define FLOATKERNELS_H
+
+#include <stdint.h>
+
+#define KERNEL_EDGE_RISING  0  //same values of the trigger mode of the plots
+#define KERNEL_EDGE_FALLING 1
+
+typedef struct _spanReduction
+{
+    float min, max;  //of the finite samples, +inf and -inf if there are none
+    double sum;  //of the finite samples
+    double sumsq;
+    int64_t finite;  //number of finite samples
+} spanReduction;
+
+//Reductions and searches used by autoscale, statistics and trigger, written once for every instruction set.
+//The implementation is chosen the first time a kernel is called: AVX2 if the CPU supports it, otherwise SSE2 on x86,
+//NEON on ARM 64 and plain C++ elsewhere. The results do not depend on the instruction set apart from the rounding of the sums.
+class floatKernels
+{
+public:
+    static void reduce(const float *data, int N, spanReduction *out);  //min, max, sum, sum of squares and count of the finite samples in one pass
+    static double sumSquaredDeviations(const float *data, int N, double mean);  //finite samples only
+    //first (last) k in [from, to) where data crosses level between k - 1 and k, -1 if there is none. from must be at least 1
+    //rising: data[k - 1] < level <= data[k]; falling: data[k - 1] > level >= data[k]
+    static int findCrossing(const float *data, int from, int to, float level, int edge);
+    static int findLastCrossing(const float *data, int from, int to, float level, int edge);
+    //min and max of the samples start - end of n_signals buffers, false if none of them is finite
+    static bool rangeOfSignals(int n_signals, int start, int end, float **buff_ptr, float *min, float *max);
+
+    static const char *getInstructionSet();
+};
+
+#endif // FLOATKERNELS_H
@@ -0,0 +1,188 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :glresourcemanager.cpp
+  @brief    :Cache of the OpenGL resources shared by the plots
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "glresourcemanager.h"
+
+#include <QtDebug>
+
+QVector<sharedProgram> glResourceManager::programs;
+QVector<sharedTexture> glResourceManager::textures;
+
+QOpenGLShaderProgram *glResourceManager::getProgram(QString vertex, QString geometry, QString fragment)
+{
+    QOpenGLContextGroup *group;
+    QOpenGLShaderProgram *program;
+    sharedProgram entry;
+    QString key;
+    int i;
+
+    if (QOpenGLContext::currentContext() == nullptr)
+    {
+        qDebug("No OpenGL context is current, the program cannot be created");
+        return nullptr;
+    }
+    group = QOpenGLContext::currentContext()->shareGroup();
+    key = vertex + "|" + geometry + "|" + fragment;
+
+    for (i = 0; i < programs.count(); i++)
+    {
+        if ((programs[i].group == group) && (programs[i].key == key))
+            return programs[i].program;
+    }
+
+    //the cacheable shaders are compiled only when the linked binary is not found in the shader cache of Qt
+    program = new QOpenGLShaderProgram;
+    if (program->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, vertex) == false)
+        qDebug() << "Error compiling" << vertex;
+    if (geometry.isEmpty() == false)
+    {
+        if (program->addCacheableShaderFromSourceFile(QOpenGLShader::Geometry, geometry) == false)
+            qDebug() << "Error compiling" << geometry;
+    }
+    if (program->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, fragment) == false)
+        qDebug() << "Error compiling" << fragment;
+    if (program->link() == false)
+        qDebug() << "Shaders were not linked correctly:" << key;
+
+    watchGroup(group);
+    entry.group = group;
+    entry.key = key;
+    entry.program = program;
+    programs.append(entry);
+
+    return program;
+}
+
+QOpenGLShaderProgram *glResourceManager::getTextProgram(bool sdf)
+{
+    if (sdf == true)
+        return getProgram(":/shaders/Shaders/Texture.vsh", "", ":/shaders/Shaders/TextureSDF.fsh");
+    return getProgram(":/shaders/Shaders/Texture.vsh", "", ":/shaders/Shaders/Texture.fsh");
+}
+
+QOpenGLTexture *glResourceManager::acquireTexture(QImage image)
+{
+    QOpenGLContextGroup *group;
+    sharedTexture entry;
+    int i;
+
+    if (QOpenGLContext::currentContext() == nullptr)
+    {
+        qDebug("No OpenGL context is current, the texture cannot be created");
+        return nullptr;
+    }
+    group = QOpenGLContext::currentContext()->shareGroup();
+
+    //the atlases are compared by content since every text renderer loads its own copy of the font
+    for (i = 0; i < textures.count(); i++)
+    {
+        if ((textures[i].group == group) && (textures[i].image == image))
+        {
+            textures[i].users++;
+            return textures[i].texture;
+        }
+    }
+
+    watchGroup(group);
+    entry.group = group;
+    entry.image = image;
+    entry.texture = new QOpenGLTexture(image.mirrored());
+    entry.users = 1;
+    textures.append(entry);
+
+    return entry.texture;
+}
+
+void glResourceManager::releaseTexture(QOpenGLTexture *texture)
+{
+    int i;
+
+    if (texture == nullptr)
+        return;
+
+    for (i = 0; i < textures.count(); i++)
+    {
+        if (textures[i].texture == texture)
+        {
+            textures[i].users--;
+            if (textures[i].users == 0)
+            {
+                delete textures[i].texture;
+                textures.remove(i);
+            }
+            return;
+        }
+    }
+}
+
+void glResourceManager::watchGroup(QOpenGLContextGroup *group)
+{
+    int i;
+
+    for (i = 0; i < programs.count(); i++)
+    {
+        if (programs[i].group == group)
+            return;
+    }
+    for (i = 0; i < textures.count(); i++)
+    {
+        if (textures[i].group == group)
+            return;
+    }
+
+    //a group disappears when all its contexts are destroyed, with Qt::AA_ShareOpenGLContexts this happens only at exit
+    QObject::connect(group, &QObject::destroyed, [group]() { removeGroup(group); });
+}
+
+void glResourceManager::removeGroup(QOpenGLContextGroup *group)
+{
+    int i;
+
+    //the OpenGL objects have already been destroyed together with the group, only the wrappers are left
+    for (i = programs.count() - 1; i >= 0; i--)
+    {
+        if (programs[i].group == group)
+        {
+            delete programs[i].program;
+            programs.remove(i);
+        }
+    }
+    for (i = textures.count() - 1; i >= 0; i--)
+    {
+        if (textures[i].group == group)
+        {
+            delete textures[i].texture;
+            textures.remove(i);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :glresourcemanager.h
+  @brief    :Header of the cache of the OpenGL resources shared by the plots
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef GLRESOURCEMANAGER_H
+#define GLRESOURCEMANAGER_H
+
+#include <QOpenGLContext>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+typedef struct _sharedProgram
+{
+    QOpenGLContextGroup *group;  //programs can only be used by the contexts of the group in which they were linked
+    QString key;  //names of the shader files
+    QOpenGLShaderProgram *program;
+} sharedProgram;
+
+typedef struct _sharedTexture
+{
+    QOpenGLContextGroup *group;
+    QImage image;  //image the texture was created from, before mirroring
+    QOpenGLTexture *texture;
+    int users;  //the texture is deleted when the last window releases it
+} sharedTexture;
+
+//All the plot windows share their OpenGL contexts (Qt::AA_ShareOpenGLContexts is set in main), so the shader programs and the font
+//textures are created once and used by every window. The vertex array objects stay per window since they cannot be shared.
+//The functions must be called with an OpenGL context current.
+class glResourceManager
+{
+public:
+    //returns the linked program made of the given shaders, geometry can be empty
+    //the program is compiled only the first time, the binary is also cached on disk by Qt so that the next launch does not compile it
+    static QOpenGLShaderProgram *getProgram(QString vertex, QString geometry, QString fragment);
+    //program drawing the text, with the fragment shader of the distance field atlases or of the bitmap ones
+    static QOpenGLShaderProgram *getTextProgram(bool sdf);
+
+    //returns the texture of the image mirrored for OpenGL, the windows using the same font atlas get the same texture
+    static QOpenGLTexture *acquireTexture(QImage image);
+    static void releaseTexture(QOpenGLTexture *texture);
+
+private:
+    static void watchGroup(QOpenGLContextGroup *group);
+    static void removeGroup(QOpenGLContextGroup *group);
+
+    static QVector<sharedProgram> programs;
+    static QVector<sharedTexture> textures;
+};
+
+#endif // GLRESOURCEMANAGER_H
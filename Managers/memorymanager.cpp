@@ -0,0 +1,261 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :memorymanager.cpp
+  @brief    :Functions of the Memory Manager Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "memorymanager.h"
+
+#include <limits>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#include <QTextStream>
+#endif
+
+memoryManager::memoryManager()
+{
+    budget = 0;  //no budget by default
+    policy = MEM_POLICY_DOWNSAMPLE;
+    warningLevel = 0.8f;  //warns at 80% of the budget
+    systemLowLevel = 0.1f;  //warns when less than 10% of the physical memory is free
+    spillFolder = QDir::tempPath();
+    budgetHit = false;
+    downsampleSpilled = false;
+}
+
+mem_status_t memoryManager::checkMemory(memoryReport *report)
+{
+    getSystemMemory(&report->systemAvailable, &report->systemTotal);
+
+    if ((report->systemAvailable >= 0) && (report->systemTotal > 0))
+        if (static_cast<float>(report->systemAvailable) < (static_cast<float>(report->systemTotal) * systemLowLevel))
+            return MEM_SYSTEM_LOW;
+
+    if (budget == 0)
+        return MEM_OK;
+
+    if (report->totalBytes > budget)
+        return MEM_BUDGET_HIT;
+
+    if (static_cast<float>(report->totalBytes) > (static_cast<float>(budget) * warningLevel))
+        return MEM_WARNING;
+
+    return MEM_OK;
+}
+
+mem_status_t memoryManager::enforceBudget(QVector<Signal_Data*> *pool, commandTrack *cmd, timeIndex *time, memoryReport *report, unsigned int maxData)
+{
+    int i, prio, minPrio, maxPrio, div;
+    uint64_t keep;
+    qint64 target, released, cmd_released;
+    mem_status_t st;
+
+    st = checkMemory(report);
+    if ((budget == 0) || (report->totalBytes <= budget))
+    {
+        budgetHit = false;
+        downsampleSpilled = false;
+        return st;
+    }
+
+    //we aim a bit below the warning level so that the policy is not applied at every poll
+    target = report->totalBytes - static_cast<qint64>(static_cast<float>(budget) * warningLevel * 0.9f);
+
+    released = 0;
+    cmd_released = cmd->memoryData();
+    switch (policy)
+    {
+    case MEM_POLICY_DOWNSAMPLE:
+        //the rows are reduced all together: the same number of the most recent rows is kept at full resolution everywhere
+        //signals received at a lower rate keep the same time span
+        if (time->countFull() > maxData)
+        {
+            keep = time->countFull() - ((time->countFull() - maxData) & ~static_cast<uint64_t>(1));
+            cmd->downsample(keep);
+            time->downsample(keep);
+            for (i = 0; i < pool->count(); i++)
+            {
+                div = (*pool)[i]->get_Rate_Divider();
+                released += (*pool)[i]->Downsample_Old(static_cast<uint32_t>(keep / static_cast<uint64_t>(div)));
+            }
+        }
+        if (released >= target)
+            break;
+
+        //the reduced part is never halved again, so it keeps growing at half the rate of the signals:
+        //once halving the new samples is not enough anymore, the oldest data are moved to disk
+        if (downsampleSpilled == false)
+            qDebug() << "Memory budget still exceeded after downsampling, the oldest data are spilled";
+        downsampleSpilled = true;
+        released += spillOld(pool, cmd, time, maxData);
+        break;
+
+    case MEM_POLICY_SPILL:
+        released += spillOld(pool, cmd, time, maxData);
+        break;
+
+    case MEM_POLICY_STOP_LOW:
+        if (canStopLow(pool) == false)  //rejected by the settings, nothing can be stopped
+            break;
+
+        minPrio = std::numeric_limits<int>::max();
+        maxPrio = 0;
+        for (i = 0; i < pool->count(); i++)
+        {
+            if ((*pool)[i]->get_Priority() < minPrio)
+                minPrio = (*pool)[i]->get_Priority();
+            if ((*pool)[i]->get_Priority() > maxPrio)
+                maxPrio = (*pool)[i]->get_Priority();
+        }
+
+        //signals are stopped starting from the lowest priority, the ones with the highest priority keep recording
+        for (prio = minPrio; (prio < maxPrio) && (released < target); prio++)
+        {
+            for (i = 0; (i < pool->count()) && (released < target); i++)
+            {
+                if (((*pool)[i]->get_Priority() != prio) || ((*pool)[i]->get_Stopped() == true))
+                    continue;
+                (*pool)[i]->set_Stopped(true);
+                released += (*pool)[i]->Trim_Data(maxData);
+                qDebug() << "Memory budget exceeded, signal " << (*pool)[i]->get_Name() << " stopped";
+            }
+        }
+        break;
+    }
+    cmd_released -= cmd->memoryData();
+
+    //the policy is applied at every poll while the budget is exceeded, so only the first hit is reported
+    if (budgetHit == false)
+        qDebug() << "Memory budget exceeded, applying policy " << getPolicyText(policy);
+    budgetHit = true;
+
+    report->signalBytes -= released;
+    report->commandBytes -= cmd_released;
+    report->totalBytes -= released + cmd_released;
+
+    return checkMemory(report);
+}
+
+qint64 memoryManager::spillOld(QVector<Signal_Data*> *pool, commandTrack *cmd, timeIndex *time, unsigned int maxData)
+{
+    int i, div;
+    qint64 released;
+
+    released = 0;
+    cmd->trim(maxData);
+    time->trim(maxData);
+    for (i = 0; i < pool->count(); i++)
+    {
+        div = (*pool)[i]->get_Rate_Divider();
+        released += (*pool)[i]->Spill_Old(getSpillFileName((*pool)[i]), maxData / static_cast<unsigned int>(div));
+    }
+
+    return released;
+}
+
+bool memoryManager::canStopLow(QVector<Signal_Data*> *pool)
+{
+    int i;
+
+    for (i = 1; i < pool->count(); i++)
+        if ((*pool)[i]->get_Priority() != (*pool)[0]->get_Priority())
+            return true;
+
+    return false;
+}
+
+void memoryManager::getSystemMemory(qint64 *available, qint64 *total)
+{
+    *available = -1;
+    *total = -1;
+
+#if defined(Q_OS_WIN)
+    MEMORYSTATUSEX status;
+
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status) != 0)
+    {
+        *available = static_cast<qint64>(status.ullAvailPhys);
+        *total = static_cast<qint64>(status.ullTotalPhys);
+    }
+#elif defined(Q_OS_LINUX)
+    QFile file("/proc/meminfo");
+    QString line;
+
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+        return;
+
+    QTextStream in(&file);
+    line = in.readLine();
+    while (line.isNull() == false)
+    {
+        //values are given in kB
+        if (line.startsWith("MemTotal:") == true)
+            *total = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong() * 1024;
+        if (line.startsWith("MemAvailable:") == true)
+            *available = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong() * 1024;
+        line = in.readLine();
+    }
+    file.close();
+#endif
+}
+
+QString memoryManager::getPolicyText(int pol)
+{
+    QString st;
+
+    switch (pol)
+    {
+    case MEM_POLICY_DOWNSAMPLE:
+        st = "Downsample old data";
+        break;
+
+    case MEM_POLICY_SPILL:
+        st = "Spill old data to disk";
+        break;
+
+    case MEM_POLICY_STOP_LOW:
+        st = "Stop recording low-priority signals";
+        break;
+
+    default:
+        st = "None";
+    }
+
+    return st;
+}
+
+QString memoryManager::getSpillFileName(Signal_Data *sig)
+{
+    return QDir(spillFolder).filePath(sig->get_Name() + "_" + QString::number(sig->get_Index()) + ".spill");
+}
@@ -0,0 +1,98 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :memorymanager.h
+  @brief    :Header of the Memory Manager Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef MEMORYMANAGER_H
+#define MEMORYMANAGER_H
+
+#include <QVector>
+#include <QString>
+#include <QDir>
+#include <QDebug>
+
+#include "signal_data.h"
+#include "commandtrack.h"
+#include "timeindex.h"
+
+#define MEM_POLICY_DOWNSAMPLE   0
+#define MEM_POLICY_SPILL        1
+#define MEM_POLICY_STOP_LOW     2
+
+typedef enum {MEM_OK, MEM_WARNING, MEM_BUDGET_HIT, MEM_SYSTEM_LOW} mem_status_t;
+
+typedef struct _memoryReport
+{
+    qint64 signalBytes;  //allocated by the signal buffers
+    qint64 commandBytes;  //allocated by the command pool
+    qint64 fftBytes;  //allocated by the FFT windows
+    qint64 stagingBytes;  //allocated by the plot buffers waiting to be uploaded to the GPU
+    qint64 totalBytes;
+    qint64 systemAvailable;  //physical memory still available in the system, -1 if unknown
+    qint64 systemTotal;  //physical memory installed in the system, -1 if unknown
+} memoryReport;
+
+//This class keeps the memory taken by the application within a budget set by the user
+//When the budget is exceeded, downsample and spill are applied to all the signals, the commands and the time index together, so that
+//the rows stored keep referring to the same instants. The signals with the lowest priority are stopped first by the stop policy
+class memoryManager
+{
+public:
+    memoryManager();
+
+    void setBudget(qint64 bytes) { if (bytes >= 0) budget = bytes; }  //0 disables the budget
+    qint64 getBudget() { return budget; }
+    void setPolicy(int pol) { if ((pol >= MEM_POLICY_DOWNSAMPLE) && (pol <= MEM_POLICY_STOP_LOW)) policy = pol; }
+    int getPolicy() { return policy; }
+    void setWarningLevel(float level) { if ((level > 0.0f) && (level <= 1.0f)) warningLevel = level; }
+    void setSpillFolder(QString folder) { spillFolder = folder; }
+
+    mem_status_t checkMemory(memoryReport *report);  //evaluates the report without modifying any data
+    mem_status_t enforceBudget(QVector<Signal_Data*> *pool, commandTrack *cmd, timeIndex *time, memoryReport *report, unsigned int maxData);  //reduces the data till the report is back within the budget
+
+    static bool canStopLow(QVector<Signal_Data*> *pool);  //the stop policy needs signals with different priorities
+    static void getSystemMemory(qint64 *available, qint64 *total);
+    static QString getPolicyText(int pol);
+
+private:
+    qint64 budget;  //bytes allowed, 0 => no budget
+    int policy;  //what to do once the budget has been hit
+    float warningLevel;  //fraction of the budget at which the user is warned
+    float systemLowLevel;  //fraction of free physical memory below which the OS is likely to start swapping
+    QString spillFolder;  //where the spilled data are written
+    bool budgetHit;  //the budget was exceeded at the last check, used to report only the changes
+    bool downsampleSpilled;  //the downsample policy had to spill during the current hit, used to report only the changes
+
+    QString getSpillFileName(Signal_Data *sig);
+    qint64 spillOld(QVector<Signal_Data*> *pool, commandTrack *cmd, timeIndex *time, unsigned int maxData);  //returns the bytes released by the signals
+};
+
+#endif // MEMORYMANAGER_H
@@ -45,6 +45,7 @@ typedef struct _appPreferences
     int plot_width_size;
     int plot_height_size;
     int font_resolution;
+    bool sdf_fonts;  //the fonts are stored as distance fields => one atlas for every size, font_resolution is not used
 
     //GRID
     int N_points;
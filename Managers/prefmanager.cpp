@@ -69,6 +69,8 @@ int prefManager::saveOnFile(QString filename)
 
     stream << preferences.toolTip_font << preferences.toolTip_char_size << preferences.toolTip_line_space << preferences.toolTip_color;
 
+    stream << preferences.sdf_fonts;
+
     file.close();
 
     return 0;
@@ -100,6 +102,10 @@ int prefManager::loadFromFile(QString filename)
 
     stream >> preferences.toolTip_font >> preferences.toolTip_char_size >> preferences.toolTip_line_space >> preferences.toolTip_color;
 
+    //the files saved by the previous versions end here, the current font mode is then kept
+    if (stream.atEnd() == false)
+        stream >> preferences.sdf_fonts;
+
     file.close();
 
     return 0;
@@ -111,6 +117,7 @@ appPreferencesStruct prefManager::load_Default()
     preferences.plot_height_size = 200;
     preferences.plot_width_size = 200;
     preferences.font_resolution = 32;
+    preferences.sdf_fonts = false;  //bitmap atlases, the distance fields are enabled in the preferences
 
     preferences.N_points = 1000;
     preferences.max_Y = 100.0;
@@ -0,0 +1,272 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :renderscheduler.cpp
+  @brief    :Render scheduler class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "renderscheduler.h"
+
+renderScheduler::renderScheduler(QObject *parent) : QObject(parent)
+{
+    maxFps = RENDER_DEFAULT_FPS;
+    refreshPeriod = 1000000000 / 60;
+    frameInterval = refreshPeriod;
+
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    frameTimer.setSingleShot(true);
+    connect(&frameTimer, &QTimer::timeout, this, &renderScheduler::tick);
+
+    updateFrameInterval();
+}
+
+renderScheduler::~renderScheduler()
+{
+    frameTimer.stop();
+}
+
+void renderScheduler::addTarget(int id, QWidget *window)
+{
+    renderTarget target;
+
+    if (findTarget(id) != -1)
+        return;
+
+    target.id = id;
+    target.window = window;
+    target.dirty = RENDER_DIRTY_DATA | RENDER_DIRTY_VIEW | RENDER_DIRTY_STYLE;  //a new window has never been rendered
+    target.dataVersion = 0;
+    target.lastRender.invalidate();
+
+    targets.append(target);
+
+    schedule();
+}
+
+void renderScheduler::removeTarget(int id)
+{
+    int pos = findTarget(id);
+
+    if (pos != -1)
+        targets.removeAt(pos);
+}
+
+void renderScheduler::markDirty(int id, int flags)
+{
+    int pos = findTarget(id);
+
+    if (pos == -1)
+        return;
+
+    targets[pos].dirty |= flags;
+
+    schedule();
+}
+
+void renderScheduler::markAllDirty(int flags)
+{
+    int i;
+
+    for (i = 0; i < targets.count(); i++)
+        targets[i].dirty |= flags;
+
+    schedule();
+}
+
+void renderScheduler::markData(int id, uint64_t version)
+{
+    int pos = findTarget(id);
+
+    if (pos == -1)
+        return;
+
+    if (targets[pos].dataVersion != version)
+    {
+        targets[pos].dataVersion = version;
+        targets[pos].dirty |= RENDER_DIRTY_DATA;
+
+        schedule();
+    }
+}
+
+bool renderScheduler::isDirty(int id)
+{
+    int pos = findTarget(id);
+
+    if (pos == -1)
+        return false;
+
+    return (targets[pos].dirty != 0);
+}
+
+void renderScheduler::markRendered(int id)
+{
+    int pos = findTarget(id);
+
+    if (pos == -1)
+        return;
+
+    targets[pos].dirty = 0;
+    targets[pos].lastRender.start();
+}
+
+void renderScheduler::setMaxFps(int fps)
+{
+    if ((fps < 1) || (fps > RENDER_MAX_FPS))
+    {
+        qDebug() << "Frame rate cap out of range: " << fps;
+        return;
+    }
+
+    maxFps = fps;
+    updateFrameInterval();
+}
+
+bool renderScheduler::isShown(QWidget *window)
+{
+    QWidget *top;
+
+    if (window == nullptr)
+        return true;
+
+    if ((window->isVisible() == false) || (window->isMinimized() == true))
+        return false;
+
+    top = window->window();
+    if ((top->windowHandle() != nullptr) && (top->windowHandle()->isExposed() == false))
+        return false;
+
+    return (window->visibleRegion().isEmpty() == false);  //fully covered by other widgets of the same window
+}
+
+void renderScheduler::tick()
+{
+    int i;
+    QVector<int> due_id, due_flags;
+
+    updateFrameInterval();  //the windows may have been moved to a screen with a different refresh rate
+
+    //the targets are collected first, since the preparation may add or remove targets
+    for (i = 0; i < targets.count(); i++)
+    {
+        if (targets[i].dirty == 0)
+            continue;
+        if (isShown(targets[i].window) == false)
+            continue;  //rendered as soon as it is visible again
+        //half a refresh period of tolerance, otherwise the timer jitter would skip a whole vsync
+        if ((targets[i].lastRender.isValid() == true) && (targets[i].lastRender.nsecsElapsed() < (frameInterval - (refreshPeriod / 2))))
+            continue;
+
+        due_id.append(targets[i].id);
+        due_flags.append(targets[i].dirty);
+
+        targets[i].dirty = 0;
+        targets[i].lastRender.start();
+    }
+
+    if (due_id.isEmpty() == false)
+        emit renderDue(due_id, due_flags);
+
+    schedule();
+}
+
+int renderScheduler::findTarget(int id)
+{
+    int i;
+
+    for (i = 0; i < targets.count(); i++)
+        if (targets[i].id == id)
+            return i;
+
+    return -1;
+}
+
+void renderScheduler::updateFrameInterval()
+{
+    int frames;
+    qreal rate = 0.0;
+    QScreen *screen = QGuiApplication::primaryScreen();
+
+    if (screen != nullptr)
+        rate = screen->refreshRate();
+    if (rate < 1.0)
+        rate = 60.0;  //unknown refresh rate
+
+    refreshPeriod = static_cast<qint64>(1000000000.0 / rate);
+
+    //the interval is a whole number of refresh periods, so that all the windows are rendered on the same vsync
+    frames = static_cast<int>(std::ceil((rate / static_cast<qreal>(maxFps)) - 0.01));
+    if (frames < 1)
+        frames = 1;
+
+    frameInterval = frames * refreshPeriod;
+}
+
+void renderScheduler::schedule()
+{
+    int i;
+    qint64 wait, next = -1;
+    bool hidden_pending = false;
+
+    //finds the first dirty and visible target that will be due
+    for (i = 0; i < targets.count(); i++)
+    {
+        if (targets[i].dirty == 0)
+            continue;
+        if (isShown(targets[i].window) == false)
+        {
+            hidden_pending = true;
+            continue;
+        }
+
+        wait = 0;
+        if (targets[i].lastRender.isValid() == true)
+            wait = frameInterval - (refreshPeriod / 2) - targets[i].lastRender.nsecsElapsed();
+        if (wait < 0)
+            wait = 0;
+
+        if ((next == -1) || (wait < next))
+            next = wait;
+    }
+
+    if ((next == -1) && (hidden_pending == true))
+        next = static_cast<qint64>(RENDER_HIDDEN_POLL_MS) * 1000000;
+
+    if (next == -1)  //nothing to render, the timer sleeps till the next change
+    {
+        frameTimer.stop();
+        return;
+    }
+
+    //a running timer expiring earlier is kept
+    if ((frameTimer.isActive() == true) && ((static_cast<qint64>(frameTimer.remainingTime()) * 1000000) <= next))
+        return;
+
+    frameTimer.start(static_cast<int>((next + 999999) / 1000000));
+}
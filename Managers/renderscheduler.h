@@ -0,0 +1,110 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :renderscheduler.h
+  @brief    :Header for the render scheduler class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef RENDERSCHEDULER_H
+#define RENDERSCHEDULER_H
+
+#include <QObject>
+#include <QWidget>
+#include <QWindow>
+#include <QScreen>
+#include <QGuiApplication>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QVector>
+#include <QDebug>
+
+#include <cmath>
+
+#define RENDER_DIRTY_DATA   0x01  //new samples have been received
+#define RENDER_DIRTY_VIEW   0x02  //zoom, pan, grid or number of points changed
+#define RENDER_DIRTY_STYLE  0x04  //colors, line widths or associations changed
+
+#define RENDER_DEFAULT_FPS      30
+#define RENDER_MAX_FPS          240
+#define RENDER_HIDDEN_POLL_MS   250  //how often the hidden windows with pending changes are checked again
+
+typedef struct _renderTarget
+{
+    int id;  //index of the plot, as assigned by the plotter manager
+    QPointer<QWidget> window;  //nullptr for targets without a window (always considered visible)
+    int dirty;  //RENDER_DIRTY_xxx flags not rendered yet
+    uint64_t dataVersion;  //version of the data last seen by the target
+    QElapsedTimer lastRender;
+} renderTarget;
+
+//This class decides when each plot window is prepared and repainted
+//New data, view and style changes only mark a window as dirty, the windows are rendered later at most at maxFps,
+//aligned to the refresh period of the screen and only if they can be seen => the render rate does not depend on the polling rate
+class renderScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    renderScheduler(QObject *parent = nullptr);
+    ~renderScheduler();
+
+    void addTarget(int id, QWidget *window);
+    void removeTarget(int id);
+
+    void markDirty(int id, int flags);
+    void markAllDirty(int flags);
+    void markData(int id, uint64_t version);  //marks the target dirty only if the version of its data has changed
+    bool isDirty(int id);  //the target has changes not rendered yet
+    void markRendered(int id);  //the target has been rendered outside of the scheduler, e.g. for the thumbnail of a hidden window
+
+    void setMaxFps(int fps);
+    int getMaxFps() { return maxFps; }
+
+    static bool isShown(QWidget *window);  //false if the window is hidden, minimized or not exposed
+
+signals:
+    void renderDue(QVector<int> ids, QVector<int> flags);  //the targets have to be prepared and repainted now, together so that they are prepared in parallel
+
+private slots:
+    void tick();
+
+private:
+    QVector<renderTarget> targets;
+    QTimer frameTimer;
+    int maxFps;
+    qint64 refreshPeriod;  //ns between two vertical syncs of the screen
+    qint64 frameInterval;  //ns between two renders of the same window, multiple of refreshPeriod
+
+    int findTarget(int id);
+    void updateFrameInterval();
+    void schedule();
+};
+
+#endif // RENDERSCHEDULER_H
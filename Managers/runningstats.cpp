@@ -0,0 +1,240 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :runningstats.cpp
+  @brief    :Functions of the Running Statistics Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "runningstats.h"
+#include "floatkernels.h"
+
+runningStats::runningStats()
+{
+    epoch = 0;
+    clear();
+}
+
+void runningStats::clear()
+{
+    blocks.clear();
+    blocks_first = 0;
+    first = 0;
+    next = 0;
+    epoch++;
+    emptySummary(&cumulative);
+}
+
+void runningStats::append(const float *data, uint32_t N)
+{
+    uint32_t n;
+    statSummary s;
+
+    s = summarize(data, N);
+    merge(&cumulative, &s);
+
+    //the first samples complete the last block, the others open new blocks
+    while (N > 0)
+    {
+        if ((next % STAT_BLOCK_SAMPLES) == 0)
+        {
+            emptySummary(&s);
+            blocks.push_back(s);
+        }
+        n = STAT_BLOCK_SAMPLES - static_cast<uint32_t>(next % STAT_BLOCK_SAMPLES);
+        if (n > N)
+            n = N;
+
+        s = summarize(data, n);
+        merge(&blocks.back(), &s);
+
+        data += n;
+        next += n;
+        N -= n;
+    }
+}
+
+void runningStats::dropFront(uint64_t first)
+{
+    if (first > next)
+        first = next;
+    this->first = first;
+
+    while ((blocks.empty() == false) && (blocks_first + STAT_BLOCK_SAMPLES <= first))
+    {
+        blocks.pop_front();
+        blocks_first += STAT_BLOCK_SAMPLES;
+    }
+}
+
+void runningStats::rebuild(const float *data, uint32_t N)
+{
+    statSummary cum;
+
+    cum = cumulative;  //the cumulative statistics refer to the samples received, not to the ones stored
+    clear();
+    append(data, N);
+    cumulative = cum;
+}
+
+statSummary runningStats::query(const float *data, uint64_t data_first, uint64_t data_epoch, uint32_t start, uint32_t end)
+{
+    statSummary res, s;
+    uint64_t a, b, blk;
+    size_t k;
+
+    emptySummary(&res);
+    if (end < start)
+        return res;
+
+    a = data_first + start;  //absolute positions of the window
+    b = data_first + end + 1;
+
+    if ((data_epoch != epoch) || (blocks.empty() == true))
+        return summarize(data + start, end - start + 1);
+
+    //left border up to the first complete block
+    blk = ((a + STAT_BLOCK_SAMPLES - 1) / STAT_BLOCK_SAMPLES) * STAT_BLOCK_SAMPLES;
+    if ((blk < blocks_first) || (blk >= b))
+        return summarize(data + start, end - start + 1);
+    if (blk > a)
+    {
+        s = summarize(data + start, static_cast<uint32_t>(blk - a));
+        merge(&res, &s);
+    }
+
+    //complete blocks
+    k = static_cast<size_t>((blk - blocks_first) / STAT_BLOCK_SAMPLES);
+    while ((blk + STAT_BLOCK_SAMPLES <= b) && (k < blocks.size()) && (blocks[k].n == STAT_BLOCK_SAMPLES))
+    {
+        merge(&res, &blocks[k]);
+        blk += STAT_BLOCK_SAMPLES;
+        k++;
+    }
+
+    //right border
+    if (blk < b)
+    {
+        s = summarize(data + (blk - data_first), static_cast<uint32_t>(b - blk));
+        merge(&res, &s);
+    }
+
+    return res;
+}
+
+statSummary runningStats::summarize(const float *data, uint32_t N)
+{
+    statSummary s;
+    uint32_t i;
+    float min, max;
+    double sum, sumsq, m2, d;
+    spanReduction r;
+
+    emptySummary(&s);
+    if (N == 0)
+        return s;
+
+    //usual case: all the samples are finite and the vector kernels give the same result
+    floatKernels::reduce(data, static_cast<int>(N), &r);
+    if (r.finite == static_cast<int64_t>(N))
+    {
+        s.n = N;
+        s.mean = r.sum / N;
+        s.m2 = floatKernels::sumSquaredDeviations(data, static_cast<int>(N), s.mean);
+        s.sumsq = r.sumsq;
+        s.min = r.min;
+        s.max = r.max;
+        return s;
+    }
+
+    //separate passes without branches so that every loop can be vectorized
+    min = data[0]; max = data[0];
+    for (i = 1; i < N; i++)
+    {
+        min = (data[i] < min) ? data[i] : min;
+        max = (data[i] > max) ? data[i] : max;
+    }
+
+    sum = 0.0; sumsq = 0.0;
+    for (i = 0; i < N; i++)
+    {
+        sum += static_cast<double>(data[i]);
+        sumsq += static_cast<double>(data[i]) * static_cast<double>(data[i]);
+    }
+
+    s.n = N;
+    s.mean = sum / N;
+
+    m2 = 0.0;
+    for (i = 0; i < N; i++)
+    {
+        d = static_cast<double>(data[i]) - s.mean;
+        m2 += d * d;
+    }
+
+    s.m2 = m2;
+    s.sumsq = sumsq;
+    s.min = min;
+    s.max = max;
+
+    return s;
+}
+
+void runningStats::merge(statSummary *a, const statSummary *b)
+{
+    uint64_t n;
+    double delta;
+
+    if (b->n == 0)
+        return;
+    if (a->n == 0)
+    {
+        *a = *b;
+        return;
+    }
+
+    //parallel version of the Welford algorithm (Chan et al.)
+    n = a->n + b->n;
+    delta = b->mean - a->mean;
+    a->m2 += b->m2 + delta * delta * (static_cast<double>(a->n) * static_cast<double>(b->n) / n);
+    a->mean += delta * b->n / n;
+    a->sumsq += b->sumsq;
+    a->min = (b->min < a->min) ? b->min : a->min;
+    a->max = (b->max > a->max) ? b->max : a->max;
+    a->n = n;
+}
+
+void runningStats::emptySummary(statSummary *s)
+{
+    s->n = 0;
+    s->mean = 0.0;
+    s->m2 = 0.0;
+    s->sumsq = 0.0;
+    s->min = 0.0f;
+    s->max = 0.0f;
+}
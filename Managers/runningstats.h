@@ -0,0 +1,89 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :runningstats.h
+  @brief    :Header of the Running Statistics Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef RUNNINGSTATS_H
+#define RUNNINGSTATS_H
+
+#include <deque>
+#include <math.h>
+#include <stdint.h>
+
+#define STAT_BLOCK_SAMPLES  256  //samples summarized by each block
+
+typedef struct _statSummary
+{
+    uint64_t n;  //number of samples
+    double mean;
+    double m2;  //sum of the squared distances from the mean (Welford)
+    double sumsq;  //sum of the squares, used for the RMS
+    float min, max;
+} statSummary;
+
+//This class keeps the statistics of a signal up to date while the data are received
+//The samples are summarized in blocks aligned to their absolute position, so that the statistics of any window are obtained
+//by merging the blocks it contains and scanning only the samples at its borders
+class runningStats
+{
+public:
+    runningStats();
+
+    void append(const float *data, uint32_t N);  //summarizes N new samples
+    void dropFront(uint64_t first);  //releases the blocks ending before the absolute sample first
+    void rebuild(const float *data, uint32_t N);  //the samples have been replaced => summarizes them from scratch
+    void clear();  //clears the blocks and the cumulative statistics
+    void resetCumulative() { emptySummary(&cumulative); }  //the cumulative statistics restart from the next sample
+
+    uint64_t getEpoch() { return epoch; }
+    uint64_t getFirst() { return first; }
+    statSummary getCumulative() { return cumulative; }
+
+    //statistics of the samples start - end (inclusive) of data, whose first sample has absolute position data_first
+    //the blocks are used only if they have been computed on the same samples (same epoch)
+    statSummary query(const float *data, uint64_t data_first, uint64_t data_epoch, uint32_t start, uint32_t end);
+
+    static statSummary summarize(const float *data, uint32_t N);
+    static void merge(statSummary *a, const statSummary *b);
+    static void emptySummary(statSummary *s);
+    static double getRMS(const statSummary *s) { return (s->n > 0) ? sqrt(s->sumsq / s->n) : 0.0; }
+    static double getStd(const statSummary *s) { return (s->n > 1) ? sqrt(s->m2 / (s->n - 1)) : 0.0; }
+
+private:
+    std::deque<statSummary> blocks;  //blocks_first is the absolute position of the first sample of blocks[0]
+    uint64_t blocks_first;
+    uint64_t first;  //absolute position of the oldest sample still available
+    uint64_t next;  //absolute position of the next sample
+    uint64_t epoch;  //increased every time the absolute positions are assigned again
+    statSummary cumulative;  //all the samples received since the last clear
+};
+
+#endif // RUNNINGSTATS_H
@@ -33,18 +33,29 @@
 
 #include "sgnalplottermanager.h"
 
+#include <algorithm>
+
 SgnalPlotterManager::SgnalPlotterManager(appPreferencesStruct *pref, fontManager *font, filenameGenerator *gen)
 {
     N_Plots = 0;
     N_Signals = 0;
     maxNData = 1000;  //by default
     command_Rec = false;
+    historyCompression = false;
+    acquisition_Paused = false;
+    trigger_Engine = nullptr;
 
     fftMgr = new fftManager(pref, font);  //we create the FFT manager
     connect(fftMgr, &fftManager::gridActTriggered, this, &SgnalPlotterManager::gridFFTChanged);
 
     fileGen = gen;
 
+    memMgr = new memoryManager();
+
+    renderSched = new renderScheduler(this);
+    renderSched->addTarget(RENDER_FFT_TARGET, nullptr);  //the FFT manager checks the visibility of its windows
+    connect(renderSched, &renderScheduler::renderDue, this, &SgnalPlotterManager::renderPlots);
+
     preferences = pref;
 
     //Loads now all the fonts
@@ -172,7 +183,14 @@ SgnalPlotterManager::~SgnalPlotterManager()
         delete XY_Plot_Pool[i].plot;
     }
 
+    for (i = 0; i < Derived_Pool.count(); i++)
+        delete Derived_Pool[i];
+    for (i = 0; i < Filter_Pool.count(); i++)
+        delete Filter_Pool[i];
+    delete trigger_Engine;
+
     delete fftMgr;
+    delete memMgr;
 }
 
 uint32_t SgnalPlotterManager::Add_Signal(QString signal_name, int type, float scaling)
@@ -184,6 +202,7 @@ uint32_t SgnalPlotterManager::Add_Signal(QString signal_name, int type, float sc
     Signal_Data *sig = new Signal_Data(signal_name, index, type, scaling);
 
     sig->set_Record(false);  //by default
+    sig->set_Compression(historyCompression);
 
     Signal_Pool.append(sig);
 
@@ -221,11 +240,19 @@ void SgnalPlotterManager::Pass_Data_to_Signal(uint32_t index, float *data, int N
 {
     int i = find_signal_by_index(index);
     int pos;
+    std::vector<float> filtered;
 
     if (i != -1)
         Signal_Pool[i]->Add_Data(data, N_Data, maxNData);
 
+    //the filters attached to this signal process only the new samples, their state is kept between batches
+    for (i = 0; i < Filter_Pool.count(); i++)
+        if (Filter_Pool[i]->getInputIndex() == index)
+            if (Filter_Pool[i]->process(data, N_Data, &filtered) > 0)
+                Pass_Data_to_Signal(Filter_Pool[i]->getOutputIndex(), filtered.data(), static_cast<int>(filtered.size()));
+
     int j;
+    signalSnapshot snap;
     //we check if the fftManager is free and in that case we update the fftmanager data as well
     if (fftMgr->getStatus() == false)  //the fftManager is free
     {
@@ -236,7 +263,8 @@ void SgnalPlotterManager::Pass_Data_to_Signal(uint32_t index, float *data, int N
             for (j = 0; j < sigIdx.count(); j++)
             {
                 pos = find_signal_by_index(static_cast<uint32_t>(sigIdx[j]));
-                fftMgr->updateSigData(fftWdwList[i], sigIdx[j], Signal_Pool[pos]->retrieve_Data_Pointer(), static_cast<int>(Signal_Pool[pos]->Count_Data()));
+                snap = Signal_Pool[pos]->Get_Snapshot(static_cast<uint32_t>(fftMgr->getNSamples(fftWdwList[i])));
+                fftMgr->updateSigData(fftWdwList[i], sigIdx[j], const_cast<float*>(snap.data), static_cast<int>(snap.count));  //the data are copied by the manager
             }
         }
     }
@@ -248,30 +276,426 @@ void SgnalPlotterManager::Clear_Signal_Data(uint32_t index)
 
     if (i != -1)
         Signal_Pool[i]->Clean_Data();
+
+    for (i = 0; i < Filter_Pool.count(); i++)
+        if (Filter_Pool[i]->getInputIndex() == index)
+            Filter_Pool[i]->reset();
 }
 
-void SgnalPlotterManager::Pass_Cmd_to_Pool(uint8_t *cmd, int N_Data)
+uint32_t SgnalPlotterManager::Add_Derived_Signal(QString signal_name, QString expression, QString *error)
+{
+    int i, n, pos;
+    uint32_t index;
+    QStringList names, inputs;
+    QVector<uint32_t> input_indexes;
+    QVector<uint64_t> positions;
+    QVector<signalSnapshot> snaps;
+    std::vector<const float*> in;
+
+    for (i = 0; i < Signal_Pool.count(); i++)
+        names << Signal_Pool[i]->get_Name();
+
+    if (names.contains(signal_name) == true)
+    {
+        *error = "A signal named " + signal_name + " already exists";
+        return 0;
+    }
+
+    derivedSignal *der = new derivedSignal(signal_name, expression);
+
+    if (der->compile(names, error) != 0)
+    {
+        delete der;
+        return 0;
+    }
+
+    //the inputs are paired sample by sample, so they must have the same rate, e.g. a decimating filter cannot be mixed with its input
+    inputs = der->getInputs();
+    for (i = 0; i < inputs.count(); i++)
+    {
+        pos = names.indexOf(inputs[i]);
+        if (Signal_Pool[pos]->get_Rate_Divider() != Signal_Pool[names.indexOf(inputs[0])]->get_Rate_Divider())
+        {
+            *error = "The inputs " + inputs[0] + " and " + inputs[i] + " have different sampling rates";
+            delete der;
+            return 0;
+        }
+        input_indexes.append(Signal_Pool[pos]->get_Index());
+    }
+    der->setInputIndexes(input_indexes);
+
+    index = Add_Signal(signal_name, DERIVED_SIG_TYPE, 1.0f);
+    der->setSignalIndex(index);
+    if (input_indexes.count() > 0)  //the channel follows the rate of its inputs
+        Signal_Pool[find_signal_by_index(index)]->set_Rate_Divider(Signal_Pool[find_signal_by_index(input_indexes[0])]->get_Rate_Divider());
+    Derived_Pool.append(der);
+
+    //the channel is calculated on the data already available
+    n = -1;
+    for (i = 0; i < input_indexes.count(); i++)
+    {
+        pos = find_signal_by_index(input_indexes[i]);
+        snaps.append(Signal_Pool[pos]->Get_Snapshot());
+        if ((n == -1) || (static_cast<int>(snaps[i].count) < n))
+            n = static_cast<int>(snaps[i].count);
+    }
+    if (n == -1)  //constant expression, it follows the first signal
+        n = (Signal_Pool.count() > 1) ? static_cast<int>(Signal_Pool[0]->Count_Data()) : 0;
+
+    if ((n > 0) && (snaps.count() > 0))  //the channel starts with the first sample calculated
+        Signal_Pool[find_signal_by_index(index)]->set_Origin(snaps[0].origin + (snaps[0].received - static_cast<uint64_t>(n)) * static_cast<uint64_t>(snaps[0].rate_divider));
+    if (n > 0)
+    {
+        for (i = 0; i < snaps.count(); i++)
+            in.push_back(snaps[i].data + (snaps[i].count - static_cast<uint32_t>(n)));
+        derived_buffer.resize(static_cast<size_t>(n));
+        der->evaluate(in.data(), n, derived_buffer.data());
+        Signal_Pool[find_signal_by_index(index)]->Add_Data(derived_buffer.data(), n, maxNData);
+    }
+
+    //from here on only the samples following the ones already calculated are read
+    for (i = 0; i < snaps.count(); i++)
+        positions.append(snaps[i].received);
+    der->setInputPositions(positions);
+
+    return index;
+}
+
+void SgnalPlotterManager::Update_Derived_Signals(int N_Data)
+{
+    int i, j, n, pos;
+    uint64_t avail;
+    QVector<uint32_t> input_indexes;
+    QVector<uint64_t> positions;
+    QVector<signalSnapshot> snaps;
+    std::vector<const float*> in;
+
+    if (N_Data <= 0)
+        return;
+
+    for (i = 0; i < Derived_Pool.count(); i++)
+    {
+        input_indexes = Derived_Pool[i]->getInputIndexes();
+        positions = Derived_Pool[i]->getInputPositions();
+        snaps.clear();
+        in.clear();
+
+        //each input is read from the absolute position of its first sample not calculated yet
+        //an input receiving its samples later is waited for, so the channel is calculated only on the samples received by all the inputs
+        n = -1;
+        if (input_indexes.count() == 0)  //a constant expression follows the received batch
+            n = N_Data;
+        for (j = 0; j < input_indexes.count(); j++)
+        {
+            pos = find_signal_by_index(input_indexes[j]);
+            if ((pos == -1) || (j >= positions.count()))
+                break;
+            snaps.append(Signal_Pool[pos]->Get_Snapshot());
+
+            if (positions[j] > snaps[j].received)  //the input has been cleaned
+                positions[j] = snaps[j].received;
+            if (snaps[j].received - positions[j] > snaps[j].count)  //the samples have been dropped before being calculated
+                positions[j] = snaps[j].received - snaps[j].count;
+
+            avail = snaps[j].received - positions[j];
+            if ((n == -1) || (avail < static_cast<uint64_t>(n)))
+                n = static_cast<int>(avail);
+        }
+        if (snaps.count() != input_indexes.count())  //an input has been removed, the channel keeps its data but is not calculated anymore
+        {
+            qDebug() << "Math channel " + Derived_Pool[i]->getName() + " disabled: inputs not available";
+            delete Derived_Pool[i];
+            Derived_Pool.remove(i);
+            i--;
+            continue;
+        }
+        if (n <= 0)
+            continue;
+
+        for (j = 0; j < snaps.count(); j++)
+        {
+            in.push_back(snaps[j].data + (snaps[j].count - static_cast<uint32_t>(snaps[j].received - positions[j])));
+            positions[j] += static_cast<uint64_t>(n);
+        }
+        Derived_Pool[i]->setInputPositions(positions);
+
+        if (derived_buffer.size() < static_cast<size_t>(n))
+            derived_buffer.resize(static_cast<size_t>(n));
+
+        Derived_Pool[i]->evaluate(in.data(), n, derived_buffer.data());
+        Pass_Data_to_Signal(Derived_Pool[i]->getSignalIndex(), derived_buffer.data(), n);
+    }
+}
+
+void SgnalPlotterManager::Update_Triggers(int N_Data)
 {
-    unsigned long long N, old_N;
-    unsigned long long size = sizeof(uint8_t);
+    int j, n, pos;
+    uint64_t avail, row;
+    triggerSettings settings;
+    QVector<uint64_t> positions;
+    QVector<signalSnapshot> snaps;
+    std::vector<const float*> in;
+
+    if ((trigger_Engine == nullptr) || (N_Data <= 0))
+        return;
+
+    settings = trigger_Engine->getSettings();
+    positions = trigger_Engine->getInputPositions();
+
+    //every new sample of the condition signals is scanned, aligned by absolute position as for the math channels
+    n = -1;
+    for (j = 0; j < settings.conditions.count(); j++)
+    {
+        pos = find_signal_by_index(settings.conditions[j].signal_index);
+        if (pos == -1)  //the signal has been removed, the engine cannot work anymore
+        {
+            trigger_Notice = "The trigger engine has been disabled: a condition signal is not available anymore.";
+            qDebug() << trigger_Notice;
+            delete trigger_Engine;
+            trigger_Engine = nullptr;
+            return;
+        }
+        snaps.append(Signal_Pool[pos]->Get_Snapshot());
 
+        if (j >= positions.count())  //first scan, it starts from the samples received from now on
+            positions.append(snaps[j].received - std::min(static_cast<uint64_t>(N_Data), static_cast<uint64_t>(snaps[j].count)));
+        if (positions[j] > snaps[j].received)  //the signal has been cleaned
+            positions[j] = snaps[j].received;
+        if (snaps[j].received - positions[j] > snaps[j].count)  //the samples have been dropped before being scanned
+            positions[j] = snaps[j].received - snaps[j].count;
+
+        avail = snaps[j].received - positions[j];
+        if ((n == -1) || (avail < static_cast<uint64_t>(n)))
+            n = static_cast<int>(avail);
+    }
+    if (n <= 0)
+    {
+        trigger_Engine->setInputPositions(positions);
+        return;
+    }
+
+    for (j = 0; j < snaps.count(); j++)
+        in.push_back(snaps[j].data + (snaps[j].count - static_cast<uint32_t>(snaps[j].received - positions[j])));
+
+    //acquisition sample of the first scanned sample, the triggers are kept this way
+    row = snaps[0].origin + positions[0] * static_cast<uint64_t>(snaps[0].rate_divider);
+    trigger_Engine->process(in.data(), n, row, snaps[0].rate_divider);
+
+    for (j = 0; j < snaps.count(); j++)
+        positions[j] += static_cast<uint64_t>(n);
+    trigger_Engine->setInputPositions(positions);
+
+    //the segments are copied from the signals once their post-trigger samples have been received
+    snaps.clear();
+    snaps.resize(settings.capture.count());
+    for (j = 0; j < settings.capture.count(); j++)
+    {
+        pos = find_signal_by_index(settings.capture[j]);
+        if (pos != -1)
+            snaps[j] = Signal_Pool[pos]->Get_Snapshot();
+        else
+        {
+            snaps[j].data = nullptr;  //stored as NAN
+            snaps[j].count = 0;
+        }
+    }
+    trigger_Engine->capture(snaps.data());
+}
+
+void SgnalPlotterManager::Update_Sweeps()
+{
+    int i, j, n, pos, N_sig;
+    QVector<signalSnapshot> snaps;
+    std::vector<float*> data;
+
+    for (i = 0; i < Plot_Pool.count(); i++)
+    {
+        N_sig = Plot_Pool[i].signals_associated.count();
+        snaps.resize(N_sig);
+        data.resize(static_cast<size_t>(N_sig));
+
+        n = -1;
+        for (j = 0; j < N_sig; j++)
+        {
+            pos = find_signal_by_index(Plot_Pool[i].signals_associated[j].signal_ID);
+            if (pos == -1)
+                break;
+            snaps[j] = Signal_Pool[pos]->Get_Snapshot();
+            if ((n == -1) || (static_cast<int>(snaps[j].count) < n))
+                n = static_cast<int>(snaps[j].count);
+        }
+        if ((j < N_sig) || (n < 2))
+            continue;
+
+        //the signals are aligned by the newest sample, the positions follow the samples skipped at the front
+        for (j = 0; j < N_sig; j++)
+        {
+            snaps[j].data += snaps[j].count - static_cast<uint32_t>(n);
+            snaps[j].first += snaps[j].count - static_cast<uint32_t>(n);
+            snaps[j].count = static_cast<uint32_t>(n);
+            data[static_cast<size_t>(j)] = const_cast<float*>(snaps[j].data);  //the accumulator only reads the data
+        }
+
+        Plot_Pool[i].plot->process_Sweeps(N_sig, n, data.data(), snaps.data());
+    }
+}
+
+uint32_t SgnalPlotterManager::Add_Filtered_Signal(QString signal_name, uint32_t input_index, filterSettings settings, QString *error)
+{
+    int i, pos;
+    uint32_t index;
+    signalSnapshot snap;
+    std::vector<float> filtered;
+
+    pos = find_signal_by_index(input_index);
+    if (pos == -1)
+    {
+        *error = "The signal to be filtered does not exist";
+        return 0;
+    }
+
+    for (i = 0; i < Signal_Pool.count(); i++)
+    {
+        if (Signal_Pool[i]->get_Name() == signal_name)
+        {
+            *error = "A signal named " + signal_name + " already exists";
+            return 0;
+        }
+    }
+
+    index = Add_Signal(signal_name, FILTER_SIG_TYPE, 1.0f);
+    Signal_Pool[find_signal_by_index(index)]->set_Rate_Divider(Signal_Pool[pos]->get_Rate_Divider() * settings.decimation);
+
+    streamFilter *filt = new streamFilter(settings, input_index, index);
+
+    //the filter starts from the data already available
+    snap = Signal_Pool[pos]->Get_Snapshot();
+    Signal_Pool[find_signal_by_index(index)]->set_Origin(snap.origin + (snap.received - snap.count) * static_cast<uint64_t>(snap.rate_divider));
+    if (filt->process(snap.data, static_cast<int>(snap.count), &filtered) > 0)
+        Signal_Pool[find_signal_by_index(index)]->Add_Data(filtered.data(), static_cast<int>(filtered.size()), maxNData);
+
+    Filter_Pool.append(filt);
+
+    return index;
+}
+
+void SgnalPlotterManager::Pass_Cmd_to_Pool(uint8_t *cmd, int N_Data)
+{
     //if N_data is <= 0 we exit
     if (N_Data <= 0)
         return;
 
-    old_N = static_cast<unsigned long long>(command_Pool.size());
-    //we resize with the new dimension
-    command_Pool.resize(static_cast<int>(old_N + static_cast<unsigned long long>(N_Data)));
+    command_Track.append(cmd, N_Data);
 
-    memcpy(command_Pool.data() + old_N, cmd, static_cast<unsigned long long>(N_Data) * size);
+    //the time index follows the same samples, the pauses of the acquisition are measured with the host clock
+    if ((time_Index.count() == 0) || (acquisition_Clock.isValid() == false))
+        acquisition_Clock.start();
+    else if (acquisition_Paused == true)
+        time_Index.startSegment(static_cast<double>(acquisition_Clock.nsecsElapsed()) / 1e9);
+    acquisition_Paused = false;
+    time_Index.append(N_Data);
 
+    //if the new data overcome the maxData allowed, we cut
     if (command_Rec == false)
     {
-        //if the new data overcome the maxData allowed, we cut
-        N = static_cast<unsigned long long>(command_Pool.size());
-        if (N > maxNData)
-            command_Pool.erase(command_Pool.begin(), command_Pool.begin() + static_cast<int>((N - maxNData)));
+        command_Track.trim(maxNData);
+        time_Index.trim(maxNData);
+    }
+}
+
+double SgnalPlotterManager::Sample_to_Time(uint64_t idx)
+{
+    int pos;
+    signalSnapshot snap;
+
+    pos = find_time_signal();
+    if (pos != -1)
+    {
+        snap = Signal_Pool[pos]->Get_Snapshot();
+        if (idx < snap.count)
+            return static_cast<double>(snap.data[idx]);
     }
+
+    return time_Index.timeOf(idx);
+}
+
+uint64_t SgnalPlotterManager::Time_to_Sample(double t)
+{
+    int pos;
+    signalSnapshot snap;
+    const float *it;
+    uint64_t idx;
+
+    pos = find_time_signal();
+    if (pos == -1)
+        return time_Index.nearest(t);
+
+    //binary search over the time column
+    snap = Signal_Pool[pos]->Get_Snapshot();
+    if (snap.count == 0)
+        return 0;
+    it = std::lower_bound(snap.data, snap.data + snap.count, static_cast<float>(t));
+    idx = static_cast<uint64_t>(it - snap.data);
+    if (idx >= snap.count)
+        return snap.count - 1;
+    if ((idx > 0) && ((t - static_cast<double>(snap.data[idx - 1])) < (static_cast<double>(snap.data[idx]) - t)))
+        idx--;
+
+    return idx;
+}
+
+int SgnalPlotterManager::Time_Range_to_Samples(double t0, double t1, uint64_t *start, uint64_t *end)
+{
+    int pos;
+    signalSnapshot snap;
+
+    pos = find_time_signal();
+    if (pos == -1)
+        return time_Index.range(t0, t1, start, end);
+
+    if (t1 < t0)
+        return -1;
+
+    snap = Signal_Pool[pos]->Get_Snapshot();
+    *start = static_cast<uint64_t>(std::lower_bound(snap.data, snap.data + snap.count, static_cast<float>(t0)) - snap.data);
+    *end = static_cast<uint64_t>(std::upper_bound(snap.data, snap.data + snap.count, static_cast<float>(t1)) - snap.data);
+
+    if (*end <= *start)
+        return -1;
+
+    return 0;
+}
+
+int SgnalPlotterManager::Get_Time_Bounds(double *t0, double *t1)
+{
+    int pos;
+    uint64_t N;
+
+    pos = find_time_signal();
+    if (pos != -1)
+        N = Signal_Pool[pos]->Count_Data();
+    else
+        N = time_Index.count();
+
+    if (N == 0)
+        return -1;
+
+    *t0 = Sample_to_Time(0);
+    *t1 = Sample_to_Time(N - 1);
+
+    return 0;
+}
+
+int SgnalPlotterManager::find_time_signal()
+{
+    int i;
+
+    //the column can be used only while it is entirely in the signal buffer
+    for (i = 0; i < Signal_Pool.count(); i++)
+        if ((Signal_Pool[i]->get_Name().compare("Time", Qt::CaseInsensitive) == 0) && (Signal_Pool[i]->Count_History() == 0))
+            return i;
+
+    return -1;
 }
 
 uint32_t SgnalPlotterManager::Add_Plot(QString plot_name, double frequency)
@@ -298,11 +722,18 @@ uint32_t SgnalPlotterManager::Add_Plot(QString plot_name, double frequency)
 
     connect(p, &plot_Window::closing, this, &SgnalPlotterManager::plotClose);
     connect(p, SIGNAL (replot(int)), this, SLOT (replot(int)));
+
+    renderSched->addTarget(static_cast<int>(index), p);
     connect(p, SIGNAL (gridNSamplesChanged(int)), this, SLOT (gridNSampChanged(int)));
 
-    //add a new thumbnail
+    //add a new thumbnail, filled with the first frame of the plot when it has been painted
     QListWidgetItem* item;
-    item = new QListWidgetItem(QIcon(QPixmap::fromImage(p->get_Plot_Pointer()->getPlotFigure().scaled(150, 150))), plot_name);
+    QPixmap blank(THUMB_WIDTH, THUMB_HEIGHT);
+    blank.fill(preferences->backGround_color);
+    item = new QListWidgetItem(QIcon(blank), plot_name);
+    p->get_Plot_Pointer()->get_Thumbnail_Grabber()->setTag(static_cast<int>(index));
+    connect(p->get_Plot_Pointer()->get_Thumbnail_Grabber(), &thumbnailGrabber::thumbnailReady, this, &SgnalPlotterManager::setThumbnail);
+    p->get_Plot_Pointer()->get_Thumbnail_Grabber()->request();
     thumbnailPlots->addItem(item);
     thumbnailPlots->item(thumbnailPlots->count()-1)->setTextColor(QColor("Black"));
     thumbnailPlots->item(thumbnailPlots->count()-1)->setBackgroundColor(QColor("Green"));
@@ -323,6 +754,7 @@ void SgnalPlotterManager::Remove_Plot(uint32_t index)
 
     disconnect(Plot_Pool[idx].plot, &plot_Window::closing, this, &SgnalPlotterManager::plotClose);
     disconnect(Plot_Pool[idx].plot, SIGNAL (replot(int)), this, SLOT (replot(int)));
+    renderSched->removeTarget(static_cast<int>(index));
 
     Plot_Pool[idx].plot->close();
     delete Plot_Pool[idx].plot;
@@ -358,11 +790,18 @@ uint32_t SgnalPlotterManager::Add_XY_Plot(QString plot_name, double frequency)
 
     connect(p, &xy_plot_Window::closing, this, &SgnalPlotterManager::xy_plotClose);
     connect(p, SIGNAL (replot(int)), this, SLOT (replot(int)));
+
+    renderSched->addTarget(static_cast<int>(index), p);
     connect(p, SIGNAL (gridNSamplesChanged(int)), this, SLOT (gridNSampChanged(int)));
 
-    //add a new thumbnail
+    //add a new thumbnail, filled with the first frame of the plot when it has been painted
     QListWidgetItem* item;
-    item = new QListWidgetItem(QIcon(QPixmap::fromImage(p->get_Plot_Pointer()->getPlotFigure().scaled(150, 150))), plot_name);
+    QPixmap blank(THUMB_WIDTH, THUMB_HEIGHT);
+    blank.fill(preferences->backGround_color);
+    item = new QListWidgetItem(QIcon(blank), plot_name);
+    p->get_Plot_Pointer()->get_Thumbnail_Grabber()->setTag(static_cast<int>(index));
+    connect(p->get_Plot_Pointer()->get_Thumbnail_Grabber(), &thumbnailGrabber::thumbnailReady, this, &SgnalPlotterManager::setThumbnail);
+    p->get_Plot_Pointer()->get_Thumbnail_Grabber()->request();
     thumbnailPlots->addItem(item);
     thumbnailPlots->item(thumbnailPlots->count()-1)->setTextColor(QColor("Black"));
     thumbnailPlots->item(thumbnailPlots->count()-1)->setBackgroundColor(QColor("Green"));
@@ -383,6 +822,7 @@ void SgnalPlotterManager::Remove_XY_Plot(uint32_t index)
 
     disconnect(XY_Plot_Pool[idx].plot, &xy_plot_Window::closing, this, &SgnalPlotterManager::xy_plotClose);
     disconnect(XY_Plot_Pool[idx].plot, SIGNAL (replot(int)), this, SLOT (replot(int)));
+    renderSched->removeTarget(static_cast<int>(index));
 
     XY_Plot_Pool[idx].plot->close();
     delete XY_Plot_Pool[idx].plot;
@@ -502,53 +942,66 @@ void SgnalPlotterManager::prepareSigViewModel()
     sigView->setEditTriggers(QAbstractItemView::NoEditTriggers);
 }
 
-int SgnalPlotterManager::Prepare_and_Plot_Individual(int i)
+int SgnalPlotterManager::Prepare_Individual(int i)
 {
-    int j, min, res;
+    int j, min;
     float** data; QColor* colors; float* line_width;
     int N_sig; int idx; int* n_p;
+    QVector<signalSnapshot> snaps;  //keeps the data valid while the plot is prepared
+    QVector<Signal_Data*> sources;  //provide the running statistics
 
     N_sig = Plot_Pool[i].signals_associated.count();
     data = new float*[N_sig]; colors = new QColor[N_sig]; line_width = new float[N_sig];
     n_p = new int[N_sig];
+    snaps.resize(N_sig);
+    sources.resize(N_sig);
 
     for (j = 0; j < N_sig; j++)
     {
         idx = find_signal_by_index(Plot_Pool[i].signals_associated[j].signal_ID);
         if (idx != -1)
-            data[j] = Signal_Pool[idx]->retrieve_Data_Pointer();
+        {
+            snaps[j] = Signal_Pool[idx]->Get_Snapshot(static_cast<uint32_t>(Plot_Pool[i].plot->getNPoints()));
+            data[j] = const_cast<float*>(snaps[j].data);  //the plot only reads the data
+            sources[j] = Signal_Pool[idx];
+        }
         else
             return -1;
         colors[j] = Plot_Pool[i].signals_associated[j].signal_color;
         line_width[j] = Plot_Pool[i].signals_associated[j].line_width;
-        n_p[j] = static_cast<int>(Signal_Pool[idx]->Count_Data());
+        n_p[j] = static_cast<int>(snaps[j].count);
     }
     if (N_sig > 0)
         min = get_Min(n_p, N_sig);  //finds the minimum number of points available among all signals
     else
         min = 0;
 
-    res = Plot_Pool[i].plot->parallel_prepare_Signal_Data(N_sig, min, data, colors, line_width);
-
-    if (res == 0)  //preparation of data has been successful => order a rewrite of the plot buffer
-        Plot_Pool[i].plot->update();
+    Plot_Pool[i].plot->parallel_prepare_Signal_Data(N_sig, min, data, colors, line_width, sources.data(), snaps.data());  //completed by Plot_Individual
 
-    delete data; delete colors; delete line_width; delete n_p;
+    delete data; delete colors; delete line_width; delete n_p;  //the plot keeps its own copies while it is prepared
 
     return min;
 }
 
+void SgnalPlotterManager::Plot_Individual(int i)
+{
+    if (Plot_Pool[i].plot->complete_Signal_Data() == 0)  //preparation of data has been successful => order a rewrite of the plot buffer
+        Plot_Pool[i].plot->update();
+}
+
 int SgnalPlotterManager::Prepare_and_Plot_XY_Individual(int i)
 {
     int j, min, res;
     float** x_data; float** y_data;
     QColor* colors; float* line_width;
     int N_sig; int x_idx, y_idx; int* n_p;
+    QVector<signalSnapshot> snaps;  //keeps the data valid while the plot is prepared
 
     N_sig = XY_Plot_Pool[i].x_signals_associated.count();
     x_data = new float*[N_sig]; y_data = new float*[N_sig];
     colors = new QColor[N_sig]; line_width = new float[N_sig];
     n_p = new int[2*N_sig];
+    snaps.resize(2 * N_sig);
 
     for (j = 0; j < N_sig; j++)
     {
@@ -556,22 +1009,24 @@ int SgnalPlotterManager::Prepare_and_Plot_XY_Individual(int i)
         y_idx = find_signal_by_index(XY_Plot_Pool[i].y_signals_associated[j].signal_ID);
         if ((x_idx != -1) && (y_idx != -1))  //signals are found
         {
-            x_data[j] = Signal_Pool[x_idx]->retrieve_Data_Pointer();
-            y_data[j] = Signal_Pool[y_idx]->retrieve_Data_Pointer();
+            snaps[2 * j] = Signal_Pool[x_idx]->Get_Snapshot();
+            snaps[(2 * j) + 1] = Signal_Pool[y_idx]->Get_Snapshot();
+            x_data[j] = const_cast<float*>(snaps[2 * j].data);  //the plot only reads the data
+            y_data[j] = const_cast<float*>(snaps[(2 * j) + 1].data);
         }
         else
             return -1;
         colors[j] = XY_Plot_Pool[i].x_signals_associated[j].signal_color;
         line_width[j] = XY_Plot_Pool[i].x_signals_associated[j].line_width;
-        n_p[2 * j] = static_cast<int>(Signal_Pool[x_idx]->Count_Data());
-        n_p[(2 * j) + 1] = static_cast<int>(Signal_Pool[y_idx]->Count_Data());
+        n_p[2 * j] = static_cast<int>(snaps[2 * j].count);
+        n_p[(2 * j) + 1] = static_cast<int>(snaps[(2 * j) + 1].count);
     }
     if (N_sig > 0)
         min = get_Min(n_p, 2 * N_sig);
     else
         min = 0;
 
-    res = XY_Plot_Pool[i].plot->prepare_Signal_Data(N_sig, min, x_data, y_data, colors, line_width);
+    res = XY_Plot_Pool[i].plot->prepare_Signal_Data(N_sig, min, x_data, y_data, colors, line_width, snaps.data());
 
     if (res == 0)  //preparation of data has been successful => order a rewrite of the plot buffer
         XY_Plot_Pool[i].plot->update();
@@ -615,6 +1070,14 @@ QString SgnalPlotterManager::get_type_text(int type)
         st = "Float";
         break;
 
+    case DERIVED_SIG_TYPE:
+        st = "Math";
+        break;
+
+    case FILTER_SIG_TYPE:
+        st = "Filtered";
+        break;
+
     default:
         st = "None";
     }
@@ -649,6 +1112,7 @@ void SgnalPlotterManager::Associate(uint32_t signal_index, uint32_t plot_index,
             SignalInfo s_i; s_i.signal_ID = signal_index; s_i.signal_color = color; s_i.line_width = line_width; s_i.visible = true;  //by defaults it is visible
             Plot_Pool[j].signals_associated.append(s_i);
             Plot_Pool[j].plot->addSignal(Signal_Pool[i]->get_Index(), Signal_Pool[i]->get_Name(), color);
+            renderSched->markDirty(static_cast<int>(plot_index), RENDER_DIRTY_STYLE);
         }
     }
 }
@@ -708,6 +1172,7 @@ void SgnalPlotterManager::Associate_XY(uint32_t x_signal_index, uint32_t y_signa
             XY_Plot_Pool[k].y_signals_associated.append(s_y);
 
             XY_Plot_Pool[k].plot->addSignal(x_signal_index, y_signal_index, Signal_Pool[i]->get_Name(), Signal_Pool[j]->get_Name(), color);
+            renderSched->markDirty(static_cast<int>(plot_index), RENDER_DIRTY_STYLE);
         }
     }
 }
@@ -764,33 +1229,94 @@ void SgnalPlotterManager::Enable_Record_All(bool record)
 
 void SgnalPlotterManager::Prepare_and_Plot()
 {
-    int i;
-//    QElapsedTimer timer;
+    int i, j, idx;
+    uint64_t version;
 
-//    timer.start();
-
-    //We start the FFT calculations if the fftManager is free
-    if (fftMgr->getStatus() == false)  //the manager is free
-        fftMgr->startFFTCalculation();  //now we don't care, the fftManager will update the FFT windows when calculation is done, not our concern here
+    //the FFT calculation is started by the render scheduler, at most once per frame
+    if (fftWdwList.count() > 0)
+        renderSched->markDirty(RENDER_FFT_TARGET, RENDER_DIRTY_DATA);
 
+    //the versions of the signals only increase, so their sum changes as soon as one of the signals changes
     for (i = 0; i < static_cast<int>(Plot_Pool.count()); i++)
     {
-        Prepare_and_Plot_Individual(i);
+        version = 0;
+        for (j = 0; j < Plot_Pool[i].signals_associated.count(); j++)
+        {
+            idx = find_signal_by_index(Plot_Pool[i].signals_associated[j].signal_ID);
+            if (idx != -1)
+                version += Signal_Pool[idx]->get_Version();
+        }
+        renderSched->markData(static_cast<int>(Plot_Pool[i].index), version);
     }
 
     for (i = 0; i < static_cast<int>(XY_Plot_Pool.count()); i++)
     {
-        Prepare_and_Plot_XY_Individual(i);
+        version = 0;
+        for (j = 0; j < XY_Plot_Pool[i].x_signals_associated.count(); j++)
+        {
+            idx = find_signal_by_index(XY_Plot_Pool[i].x_signals_associated[j].signal_ID);
+            if (idx != -1)
+                version += Signal_Pool[idx]->get_Version();
+            idx = find_signal_by_index(XY_Plot_Pool[i].y_signals_associated[j].signal_ID);
+            if (idx != -1)
+                version += Signal_Pool[idx]->get_Version();
+        }
+        renderSched->markData(static_cast<int>(XY_Plot_Pool[i].index), version);
     }
 
     //We now update the value of each signal in the sigView
     for (i = 0; i < static_cast<int>(N_Signals); i++)
     {
-        sigViewModel->setItem(i, 1, new QStandardItem(QString::number(Signal_Pool[i]->getLastSample())));
+        if (Signal_Pool[i]->get_Stopped() == true)  //stopped by the memory manager, it is not exported anymore since its rows end earlier
+        {
+            sigViewModel->setItem(i, 1, new QStandardItem("Stopped"));
+            sigViewModel->item(i, 0)->setCheckState(Qt::Unchecked);
+        }
+        else
+            sigViewModel->setItem(i, 1, new QStandardItem(QString::number(Signal_Pool[i]->getLastSample())));
     }
+}
+
+void SgnalPlotterManager::Invalidate_Plots(int flags)
+{
+    renderSched->markAllDirty(flags);
+}
+
+void SgnalPlotterManager::renderPlots(QVector<int> ids, QVector<int> flags)
+{
+    int i, type, pos;
+    QVector<int> started;  //time plots being prepared on the worker pool
+
+    (void) flags;  //data, view and style changes need the same preparation
+
+    for (i = 0; i < ids.count(); i++)
+    {
+        if (ids[i] == RENDER_FFT_TARGET)
+        {
+            //We start the FFT calculations if the fftManager is free
+            if (fftMgr->getStatus() == false)  //the manager is free
+                fftMgr->startFFTCalculation();  //the fftManager will update the FFT windows when calculation is done
+            else
+                renderSched->markDirty(RENDER_FFT_TARGET, RENDER_DIRTY_DATA);  //tried again at the next frame
+            continue;
+        }
+
+        pos = find_plot_by_index(static_cast<uint32_t>(ids[i]), &type);
+        if (pos == -1)
+            continue;
 
- //   qDebug() << "Preparation time = " << (timer.nsecsElapsed() / 1000000) << " ms";
+        if (type == 0)
+        {
+            Prepare_Individual(pos);
+            started.append(pos);
+        }
+        if (type == 1)
+            Prepare_and_Plot_XY_Individual(pos);  //prepared here while the time plots are prepared by the pool
+    }
 
+    //all the time plots have been started before waiting for the first one, so that their signals are prepared together
+    for (i = 0; i < started.count(); i++)
+        Plot_Individual(started[i]);
 }
 
 void SgnalPlotterManager::set_Plots_N_Points(int N)
@@ -802,6 +1328,21 @@ void SgnalPlotterManager::set_Plots_N_Points(int N)
 }
 
 int SgnalPlotterManager::exportToFile(QString filename)
+{
+    return export_Samples(filename, 0, std::numeric_limits<uint64_t>::max());
+}
+
+int SgnalPlotterManager::exportTimeRangeToFile(QString filename, double t0, double t1)
+{
+    uint64_t from, to;
+
+    if (Time_Range_to_Samples(t0, t1, &from, &to) != 0)
+        return -1;
+
+    return export_Samples(filename, from, to);
+}
+
+int SgnalPlotterManager::export_Samples(QString filename, uint64_t from, uint64_t to)
 {
     int i, res;
 
@@ -811,7 +1352,8 @@ int SgnalPlotterManager::exportToFile(QString filename)
     MatlabFileSaver saver;
     float** data;
     int N_sig, counter, N_samples;
-    QVector<int> samples;
+    std::vector<std::vector<float>> temp;
+    QVector<signalSnapshot> snaps;  //keeps the data valid while they are written
 
     N_sig = 0;
     for (i = 0; i < static_cast<int>(N_Signals); i++)
@@ -825,22 +1367,29 @@ int SgnalPlotterManager::exportToFile(QString filename)
     if (N_sig == 0)
         return -1;  //no signals to be saved
 
+    //the rows are the samples of the acquisition stored in the command track, each signal is placed on them by its origin and rate
+    if (to > command_Track.count())
+        to = command_Track.count();
+    if (from >= to)
+        return -1;
+    N_samples = static_cast<int>(to - from);
+
     //prepares pointers to data to be saved
     data = new float*[N_sig];
-    samples.resize(N_sig);
+    temp.resize(static_cast<size_t>(N_sig));
+    snaps.resize(N_sig);
     counter = 0;
     for (i = 0; i < static_cast<int>(N_Signals); i++)
         if (sigViewModel->item(i, 0)->checkState() == Qt::Checked)
         {
-            data[counter] = Signal_Pool[i]->retrieve_Data_Pointer();
-            samples[counter] = static_cast<int>(Signal_Pool[i]->Count_Data());
+            data[counter] = get_Aligned_Segment(i, from, N_samples, &temp[static_cast<size_t>(counter)], &snaps[counter]);
             counter++;
         }
 
-    N_samples = get_Min_Vector(samples);
-
     res = saver.Save_MATLAB_File(data, N_samples, filename);
 
+    delete[] data;
+
     return res;
 }
 
@@ -852,12 +1401,15 @@ int SgnalPlotterManager::autoExportToFile()
 
     res = -1;
 
-    if (command_Pool.length() < 1)
+    if (command_Track.count() < 1)
         return -1;
 
     MatlabFileSaver *saver;
     float** data;
     int N_sig, counter, N_samples;
+    std::vector<std::vector<float>> temp;
+    QVector<signalSnapshot> snaps;  //keeps the data valid while they are written
+    QVector<cmdSegment> segments;
 
     N_sig = 0;
     saver = new MatlabFileSaver();
@@ -877,74 +1429,113 @@ int SgnalPlotterManager::autoExportToFile()
 
     //prepares pointers to data to be saved
 
-    int start_idx; int end_idx; int state;
-    bool command_save;
+    int start_idx; int end_idx;
 
-    //state = 0 => we are waiting for RECORD_ACT
-    //state = 1 => we are waiting for NO_ACT
+    //every RECORD_CMD => NO_CMD segment is read directly from the command transitions
+    segments = command_Track.getSegments(RECORD_CMD, NO_CMD, 0, command_Track.count());
 
+    for (k = 0; k < segments.count(); k++)
+    {
+        start_idx = static_cast<int>(segments[k].start);
+        end_idx = static_cast<int>(segments[k].end);
 
-    state = command_Pool[0];
-    if (state == RECORD_CMD)
-        start_idx = 0;
-    command_save = false;
+        //first we generate a new valid filename
+        filename = fileGen->generateAutoFileName(&out);
 
-    for (k = 1; k < command_Pool.length(); k++)
-    {
-        //two cases: we are in record or we are in no_cmd
-        switch(state)
+        if (out != 0)
         {
-        case NO_CMD:
-            if (command_Pool[k] == RECORD_CMD)
-            {
-                start_idx = k;
-                state = RECORD_CMD;
-            }
-            break;
-
-        case RECORD_CMD:
-            if (command_Pool[k] == NO_CMD)
-            {
-                end_idx = k;
-                command_save = true;
-                state = NO_CMD;
-            }
-            break;
+            delete saver;
+            return -1;
         }
 
-        if (command_save == true)
-        {
-            //first we generate a new valid filename
-            filename = fileGen->generateAutoFileName(&out);
+        N_samples = end_idx - start_idx;
 
-            if (out != 0)
+        data = new float*[N_sig];
+        temp.resize(static_cast<size_t>(N_sig));
+        snaps.resize(N_sig);
+        counter = 0;
+        for (i = 0; (i < static_cast<int>(N_Signals)) && (N_samples > 0); i++)
+            if (sigViewModel->item(i, 0)->checkState() == Qt::Checked)
             {
-                delete saver;
-                return -1;
+                //the segment is given in rows of the command track, the filtered and decimated signals are sliced at their own rate
+                data[counter] = get_Aligned_Segment(i, static_cast<uint64_t>(start_idx), N_samples, &temp[static_cast<size_t>(counter)], &snaps[counter]);
+                counter++;
             }
 
-            N_samples = end_idx - start_idx;
-
-            data = new float*[N_sig];
-            counter = 0;
-            for (i = 0; i < static_cast<int>(N_Signals); i++)
-                if (sigViewModel->item(i, 0)->checkState() == Qt::Checked)
-                {
-                    data[counter] = &(Signal_Pool[i]->retrieve_Data_Pointer()[start_idx]);
-                    counter++;
-                }
-
+        if (N_samples > 0)
             res = saver->Save_MATLAB_File(data, N_samples, filename);
+        else
+            qDebug() << "Empty RECORD segment not saved";
 
-//            delete data;
-            command_save = false;
-        }
+        delete[] data;
     }
     delete saver;
 
     return res;
 }
 
+float *SgnalPlotterManager::get_Signal_Segment(int pos, uint64_t start, int N, std::vector<float> *temp, signalSnapshot *snap)
+{
+    uint64_t history;
+
+    history = Signal_Pool[pos]->Count_History();
+
+    //data still in the signal buffer are passed directly, the snapshot keeps them valid
+    if (start >= history)
+    {
+        *snap = Signal_Pool[pos]->Get_Snapshot();
+        return const_cast<float*>(snap->data) + (start - history);
+    }
+
+    temp->resize(static_cast<size_t>(N));
+    Signal_Pool[pos]->Copy_Data(start, static_cast<uint32_t>(N), temp->data());
+
+    return temp->data();
+}
+
+float *SgnalPlotterManager::get_Aligned_Segment(int pos, uint64_t from, int N, std::vector<float> *temp, signalSnapshot *snap)
+{
+    int j, first, last;
+    int64_t s, s_first, s_last;
+    uint64_t acq_first, acq_last;
+    float *src;
+    std::vector<float> src_temp;
+
+    //the stored samples of the signal are found from the acquisition sample of each row, the mapping only grows with the rows
+    acq_first = command_Track.toAbsolute(from);
+    acq_last = command_Track.toAbsolute(from + static_cast<uint64_t>(N) - 1);
+    s_first = Signal_Pool[pos]->Stored_Index(acq_first);
+    s_last = Signal_Pool[pos]->Stored_Index(acq_last);
+
+    //a signal of the acquisition rate stored at full resolution over the rows is passed as it is
+    if ((s_first >= 0) && (s_last - s_first == N - 1) && (acq_last - acq_first == static_cast<uint64_t>(N - 1)) && (Signal_Pool[pos]->get_Rate_Divider() == 1))
+        return get_Signal_Segment(pos, static_cast<uint64_t>(s_first), N, temp, snap);
+
+    temp->assign(static_cast<size_t>(N), NAN);
+
+    //rows before the first and after the last sample of the signal stay NAN
+    first = 0;
+    while ((first < N) && (Signal_Pool[pos]->Stored_Index(command_Track.toAbsolute(from + static_cast<uint64_t>(first))) < 0))
+        first++;
+    last = N - 1;
+    while ((last >= first) && (Signal_Pool[pos]->Stored_Index(command_Track.toAbsolute(from + static_cast<uint64_t>(last))) < 0))
+        last--;
+    if (last < first)
+        return temp->data();
+
+    //every row gets the last sample of the signal at or before it
+    s_first = Signal_Pool[pos]->Stored_Index(command_Track.toAbsolute(from + static_cast<uint64_t>(first)));
+    s_last = Signal_Pool[pos]->Stored_Index(command_Track.toAbsolute(from + static_cast<uint64_t>(last)));
+    src = get_Signal_Segment(pos, static_cast<uint64_t>(s_first), static_cast<int>(s_last - s_first + 1), &src_temp, snap);
+    for (j = first; j <= last; j++)
+    {
+        s = Signal_Pool[pos]->Stored_Index(command_Track.toAbsolute(from + static_cast<uint64_t>(j)));
+        (*temp)[static_cast<size_t>(j)] = src[s - s_first];
+    }
+
+    return temp->data();
+}
+
 void SgnalPlotterManager::Organize_Windows()
 {
     int N_plots;
@@ -1031,12 +1622,430 @@ qint64 SgnalPlotterManager::getSignalMemoryData()
     return bytes;
 }
 
+memoryReport SgnalPlotterManager::getMemoryReport()
+{
+    int i;
+    memoryReport report;
+
+    report.signalBytes = 0;
+    report.stagingBytes = 0;
+
+    //we count the allocated capacity and not the number of samples since this is what the OS sees
+    for (i = 0; i < Signal_Pool.count(); i++)
+        report.signalBytes += Signal_Pool[i]->Memory_Data();
+
+    report.commandBytes = command_Track.memoryData();
+    report.fftBytes = fftMgr->getMemoryData();
+
+    for (i = 0; i < Plot_Pool.count(); i++)
+        report.stagingBytes += Plot_Pool[i].plot->getStagingMemory();
+    for (i = 0; i < XY_Plot_Pool.count(); i++)
+        report.stagingBytes += XY_Plot_Pool[i].plot->getStagingMemory();
+
+    report.totalBytes = report.signalBytes + report.commandBytes + report.fftBytes + report.stagingBytes;
+    report.systemAvailable = -1;
+    report.systemTotal = -1;
+
+    return report;
+}
+
+mem_status_t SgnalPlotterManager::enforceMemoryBudget(memoryReport *report)
+{
+    *report = getMemoryReport();
+
+    //spilled data are written next to the exported files when an export folder has been chosen
+    if (fileGen->getSaveFolder().isEmpty() == false)
+        memMgr->setSpillFolder(fileGen->getSaveFolder());
+
+    return memMgr->enforceBudget(&Signal_Pool, &command_Track, &time_Index, report, maxNData);
+}
+
+void SgnalPlotterManager::memoryBudgetSettings()
+{
+    QMessageBox msgBox;
+    bool ok;
+    int i, mbytes, pol;
+    QStringList items;
+
+    mbytes = QInputDialog::getInt(this, "Memory budget", "Maximum memory to be used in Mbyte (0 = no budget):", static_cast<int>(memMgr->getBudget() / (1024 * 1024)), 0, std::numeric_limits<int>::max(), 1, &ok);
+
+    if (ok == false)
+        return;
+
+    for (i = MEM_POLICY_DOWNSAMPLE; i <= MEM_POLICY_STOP_LOW; i++)
+        items << memoryManager::getPolicyText(i);
+
+    QString selected = QInputDialog::getItem(this, "Memory policy", "Action taken when the budget is exceeded", items, memMgr->getPolicy(), false, &ok);
+
+    if (ok == false)
+        return;
+
+    pol = items.indexOf(selected);
+
+    //with equal priorities there is no signal that could be stopped
+    if ((pol == MEM_POLICY_STOP_LOW) && (memoryManager::canStopLow(&Signal_Pool) == false))
+    {
+        msgBox.setText("All the signals have the same priority, so none of them can be stopped. Set a lower priority for the signals that may be stopped first.");
+        msgBox.exec();
+        return;
+    }
+
+    memMgr->setBudget(static_cast<qint64>(mbytes) * 1024 * 1024);
+    memMgr->setPolicy(pol);
+}
+
+void SgnalPlotterManager::newMathChannel()
+{
+    QMessageBox msgBox;
+    QString name, expression, error;
+    bool ok;
+
+    name = QInputDialog::getText(this, "New math channel", "Name of the channel:", QLineEdit::Normal, "Math " + QString::number(Derived_Pool.count() + 1), &ok);
+
+    if ((ok == false) || (name.isEmpty() == true))
+        return;
+
+    expression = QInputDialog::getText(this, "New math channel", "Expression (e.g. sqrt(ia^2 + ib^2), atan2(ib, ia), {v dc} * 0.5)\n"
+                                       "Operators: + - * / ^   Functions: sin cos tan sqrt abs exp log atan2 min max pow", QLineEdit::Normal, "", &ok);
+
+    if ((ok == false) || (expression.isEmpty() == true))
+        return;
+
+    if (Add_Derived_Signal(name, expression, &error) == 0)
+    {
+        msgBox.setText("The math channel could not be created: " + error);
+        msgBox.exec();
+    }
+}
+
+void SgnalPlotterManager::newFilterChannel()
+{
+    QMessageBox msgBox;
+    QStringList items;
+    QString selected, name, error;
+    filterSettings settings;
+    int i, pos;
+    bool ok;
+    double cutoff;
+
+    for (i = 0; i < Signal_Pool.count(); i++)
+        items << Signal_Pool[i]->get_Name();
+
+    if (items.isEmpty() == true)
+        return;
+
+    selected = QInputDialog::getItem(this, "New filtered signal", "Signal to be filtered:", items, 0, false, &ok);
+    if (ok == false)
+        return;
+    pos = items.indexOf(selected);
+
+    items.clear();
+    for (i = FILTER_IIR_LOWPASS; i <= FILTER_MOVING_AVERAGE; i++)
+        items << streamFilter::getTypeText(i);
+
+    selected = QInputDialog::getItem(this, "New filtered signal", "Filter:", items, 0, false, &ok);
+    if (ok == false)
+        return;
+    settings.type = items.indexOf(selected);
+
+    switch (settings.type)
+    {
+    case FILTER_IIR_LOWPASS:
+    case FILTER_IIR_HIGHPASS:
+        settings.order = QInputDialog::getInt(this, "New filtered signal", "Number of second order sections (filter order / 2):", 2, 1, 8, 1, &ok);
+        break;
+
+    case FILTER_FIR_LOWPASS:
+        settings.order = QInputDialog::getInt(this, "New filtered signal", "Number of taps:", 63, 3, 1023, 2, &ok);
+        break;
+
+    default:
+        settings.order = QInputDialog::getInt(this, "New filtered signal", "Number of averaged samples:", 10, 2, 100000, 1, &ok);
+        break;
+    }
+    if (ok == false)
+        return;
+
+    settings.cutoff = 0.0;
+    if (settings.type != FILTER_MOVING_AVERAGE)
+    {
+        cutoff = QInputDialog::getDouble(this, "New filtered signal", "Cut-off frequency in Hz (sampling frequency " + QString::number(plot_frequency) + " Hz):", plot_frequency / 10.0, 0.0, plot_frequency / 2.0, 3, &ok);
+        if (ok == false)
+            return;
+        settings.cutoff = cutoff / plot_frequency;
+    }
+
+    settings.decimation = QInputDialog::getInt(this, "New filtered signal", "Decimation (1 output sample every N input samples):", 1, 1, 1000, 1, &ok);
+    if (ok == false)
+        return;
+
+    name = QInputDialog::getText(this, "New filtered signal", "Name of the signal:", QLineEdit::Normal, Signal_Pool[pos]->get_Name() + " filtered", &ok);
+    if ((ok == false) || (name.isEmpty() == true))
+        return;
+
+    if (Add_Filtered_Signal(name, Signal_Pool[pos]->get_Index(), settings, &error) == 0)
+    {
+        msgBox.setText("The filtered signal could not be created: " + error);
+        msgBox.exec();
+    }
+}
+
+void SgnalPlotterManager::triggerEngineSettings()
+{
+    QMessageBox msgBox;
+    QStringList names, items;
+    QString selected;
+    triggerSettings settings;
+    triggerCondition cond;
+    int i, c, nc, pos;
+    bool ok;
+
+    for (i = 0; i < Signal_Pool.count(); i++)
+        names << Signal_Pool[i]->get_Name();
+
+    if (names.isEmpty() == true)
+        return;
+
+    if (trigger_Notice.isEmpty() == false)
+    {
+        msgBox.setText(trigger_Notice);
+        msgBox.exec();
+        trigger_Notice.clear();
+    }
+
+    if (trigger_Engine != nullptr)
+    {
+        items << "New trigger configuration" << "Disable the trigger engine";
+        selected = QInputDialog::getItem(this, "Trigger engine", QString::number(trigger_Engine->getTriggerCount()) + " triggers, " + QString::number(trigger_Engine->getSegmentCount()) + " segments stored:", items, 0, false, &ok);
+        if (ok == false)
+            return;
+        if (items.indexOf(selected) == 1)
+        {
+            delete trigger_Engine;
+            trigger_Engine = nullptr;
+            return;
+        }
+    }
+
+    nc = QInputDialog::getInt(this, "Trigger engine", "Number of conditions:", 1, 1, 4, 1, &ok);
+    if (ok == false)
+        return;
+
+    for (c = 0; c < nc; c++)
+    {
+        selected = QInputDialog::getItem(this, "Trigger condition " + QString::number(c + 1), "Signal:", names, 0, false, &ok);
+        if (ok == false)
+            return;
+        pos = names.indexOf(selected);
+        cond.signal_index = Signal_Pool[pos]->get_Index();
+
+        //the conditions are scanned sample by sample together, so they must have the same rate as the first one
+        if ((c > 0) && (Signal_Pool[pos]->get_Rate_Divider() != Signal_Pool[find_signal_by_index(settings.conditions[0].signal_index)]->get_Rate_Divider()))
+        {
+            msgBox.setText("The conditions must use signals with the same sampling rate: " + selected + " is decimated differently from the signal of the first condition.");
+            msgBox.exec();
+            return;
+        }
+
+        items.clear();
+        for (i = TRIGGER_COND_EDGE; i <= TRIGGER_COND_PULSE; i++)
+            items << triggerEngine::getTypeText(i);
+        selected = QInputDialog::getItem(this, "Trigger condition " + QString::number(c + 1), "Type:", items, 0, false, &ok);
+        if (ok == false)
+            return;
+        cond.type = items.indexOf(selected);
+
+        items.clear();
+        switch (cond.type)
+        {
+        case TRIGGER_COND_EDGE:
+            items << "Rising" << "Falling" << "Any";
+            break;
+
+        case TRIGGER_COND_WINDOW:
+            items << "Entering the window" << "Leaving the window";
+            break;
+
+        default:
+            items << "Positive pulse (above the level)" << "Negative pulse (below the level)";
+            break;
+        }
+        selected = QInputDialog::getItem(this, "Trigger condition " + QString::number(c + 1), "Slope:", items, 0, false, &ok);
+        if (ok == false)
+            return;
+        cond.slope = items.indexOf(selected);
+
+        cond.level = 0.0f;
+        cond.low = 0.0f;
+        cond.high = 0.0f;
+        cond.min_width = 0;
+        cond.max_width = 0;
+        if (cond.type == TRIGGER_COND_WINDOW)
+        {
+            cond.low = static_cast<float>(QInputDialog::getDouble(this, "Trigger condition " + QString::number(c + 1), "Lower limit of the window:", 0.0, -1e30, 1e30, 4, &ok));
+            if (ok == false)
+                return;
+            cond.high = static_cast<float>(QInputDialog::getDouble(this, "Trigger condition " + QString::number(c + 1), "Upper limit of the window:", static_cast<double>(cond.low) + 1.0, static_cast<double>(cond.low), 1e30, 4, &ok));
+            if (ok == false)
+                return;
+        }
+        else
+        {
+            cond.level = static_cast<float>(QInputDialog::getDouble(this, "Trigger condition " + QString::number(c + 1), "Level:", 0.0, -1e30, 1e30, 4, &ok));
+            if (ok == false)
+                return;
+        }
+        if (cond.type == TRIGGER_COND_PULSE)
+        {
+            cond.min_width = static_cast<uint64_t>(QInputDialog::getInt(this, "Trigger condition " + QString::number(c + 1), "Minimum pulse width in samples:", 1, 1, std::numeric_limits<int>::max(), 1, &ok));
+            if (ok == false)
+                return;
+            cond.max_width = static_cast<uint64_t>(QInputDialog::getInt(this, "Trigger condition " + QString::number(c + 1), "Maximum pulse width in samples:", static_cast<int>(cond.min_width), static_cast<int>(cond.min_width), std::numeric_limits<int>::max(), 1, &ok));
+            if (ok == false)
+                return;
+        }
+
+        settings.conditions.append(cond);
+    }
+
+    settings.combine = TRIGGER_COMBINE_OR;
+    if (nc > 1)
+    {
+        items.clear();
+        items << "OR: any condition triggers" << "AND: a condition triggers while all the others are true";
+        selected = QInputDialog::getItem(this, "Trigger engine", "Combination of the conditions:", items, 0, false, &ok);
+        if (ok == false)
+            return;
+        settings.combine = items.indexOf(selected);
+    }
+
+    settings.holdoff = static_cast<uint64_t>(QInputDialog::getInt(this, "Trigger engine", "Holdoff in samples (no trigger accepted after a trigger):", 0, 0, std::numeric_limits<int>::max(), 1, &ok));
+    if (ok == false)
+        return;
+    settings.pre = QInputDialog::getInt(this, "Trigger engine", "Samples stored before the trigger:", 100, 0, static_cast<int>(maxNData) - 1, 1, &ok);
+    if (ok == false)
+        return;
+    settings.post = QInputDialog::getInt(this, "Trigger engine", "Samples stored from the trigger on:", 400, 1, static_cast<int>(maxNData) - settings.pre, 1, &ok);
+    if (ok == false)
+        return;
+    settings.max_segments = QInputDialog::getInt(this, "Trigger engine", "Segments kept in memory (the oldest are dropped):", TRIGGER_DEFAULT_SEGMENTS, 1, 100000, 1, &ok);
+    if (ok == false)
+        return;
+
+    //as in a scope, each segment holds all the channels
+    for (i = 0; i < Signal_Pool.count(); i++)
+        settings.capture.append(Signal_Pool[i]->get_Index());
+
+    delete trigger_Engine;
+    trigger_Engine = new triggerEngine(settings);
+
+    msgBox.setText("The trigger engine is armed. The segments can be exported from the File menu.");
+    msgBox.exec();
+}
+
+int SgnalPlotterManager::exportTriggerSegments(QString filename)
+{
+    int i, j, k, n_cap, length, n_seg, res;
+    triggerSettings settings;
+    const triggerSegment *seg;
+    std::vector<std::vector<float>> columns;
+    std::vector<float*> data;
+    MatlabFileSaver saver;
+
+    if ((trigger_Engine == nullptr) || (filename.isEmpty() == true))
+        return -1;
+
+    n_seg = trigger_Engine->getSegmentCount();
+    if (n_seg == 0)
+        return -1;
+
+    settings = trigger_Engine->getSettings();
+    n_cap = settings.capture.count();
+    length = settings.pre + settings.post;
+
+    //the segments are written one after the other, the last column tells the segment of each sample
+    columns.resize(static_cast<size_t>(n_cap + 1));
+    for (j = 0; j < n_cap; j++)
+    {
+        i = find_signal_by_index(settings.capture[j]);
+        if (i != -1)
+            saver.AddSignalInfoToWrite(Signal_Pool[i]->get_Name());
+        else
+            saver.AddSignalInfoToWrite("Signal_" + QString::number(settings.capture[j]));
+        columns[static_cast<size_t>(j)].reserve(static_cast<size_t>(n_seg) * static_cast<size_t>(length));
+    }
+    saver.AddSignalInfoToWrite("Trigger_Segment");
+
+    for (k = 0; k < n_seg; k++)
+    {
+        seg = trigger_Engine->getSegment(k);
+        for (j = 0; j < n_cap; j++)
+            columns[static_cast<size_t>(j)].insert(columns[static_cast<size_t>(j)].end(), seg->data[static_cast<size_t>(j)].begin(), seg->data[static_cast<size_t>(j)].end());
+        columns[static_cast<size_t>(n_cap)].insert(columns[static_cast<size_t>(n_cap)].end(), static_cast<size_t>(length), static_cast<float>(k + 1));
+    }
+
+    for (j = 0; j <= n_cap; j++)
+        data.push_back(columns[static_cast<size_t>(j)].data());
+
+    res = saver.Save_MATLAB_File(data.data(), n_seg * length, filename);
+
+    return res;
+}
+
+void SgnalPlotterManager::setHistoryCompression(bool en)
+{
+    int i;
+
+    historyCompression = en;
+
+    for (i = 0; i < Signal_Pool.count(); i++)
+        Signal_Pool[i]->set_Compression(en);
+}
+
+void SgnalPlotterManager::signalPrioritySettings()
+{
+    int i, prio;
+    QStringList items;
+    bool ok;
+    QString selected;
+
+    for (i = 0; i < Signal_Pool.count(); i++)
+        items << Signal_Pool[i]->get_Name();
+
+    if (items.count() == 0)
+        return;
+
+    selected = QInputDialog::getItem(this, "Signals list", "Choose the signal", items, 0, false, &ok);
+
+    if (ok == false)
+        return;
+
+    i = items.indexOf(selected);
+    if (i == -1)
+        return;
+
+    prio = QInputDialog::getInt(this, "Signal priority", "Priority (signals with lower priority are reduced first):", Signal_Pool[i]->get_Priority(), 0, 100, 1, &ok);
+
+    if (ok == true)
+        Signal_Pool[i]->set_Priority(prio);
+}
+
 void SgnalPlotterManager::clearAllData()
 {
     int i;
 
     for (i = 0; i < Signal_Pool.count(); i++)
         Signal_Pool[i]->Clean_Data();
+
+    for (i = 0; i < Filter_Pool.count(); i++)
+        Filter_Pool[i]->reset();
+
+    if (trigger_Engine != nullptr)
+        trigger_Engine->reset();
+
+    command_Track.clear();  //the rows of the commands must restart with the signals
+    time_Index.clear();
+    acquisition_Clock.invalidate();
 }
 
 void SgnalPlotterManager::updateFonts()
@@ -1120,25 +2129,51 @@ void SgnalPlotterManager::setPushButtonsEnable(bool en)
 
 void SgnalPlotterManager::replot(int index)
 {
-    int type;
-
-    int pos = find_plot_by_index(index, &type);
-    if ((type == 0) && (pos != -1))
-        Prepare_and_Plot_Individual(pos);
-    if ((type == 1) && (pos != -1))
-        Prepare_and_Plot_XY_Individual(pos);
+    //the plot is prepared again at the next frame, several changes within a frame are rendered once
+    renderSched->markDirty(index, RENDER_DIRTY_VIEW);
 
     emit replotCalled();
 }
 
 void SgnalPlotterManager::updateThumbs()
 {
-    int i;
+    int i, id;
 
+    //the thumbnails are taken from the next frame each visible plot paints, a plot that is not repainted keeps its thumbnail
+    //hidden and minimized plots are not painted: if they have changed, they are prepared and rendered offscreen
     for (i = 0; i < Plot_Pool.count(); i++)
-        thumbPlotAssInv.value(Plot_Pool[i].index)->setIcon(QIcon(QPixmap::fromImage(Plot_Pool[i].plot->get_Plot_Pointer()->getPlotFigure().scaled(150, 150))));
+    {
+        id = static_cast<int>(Plot_Pool[i].index);
+        if (renderScheduler::isShown(Plot_Pool[i].plot) == true)
+            Plot_Pool[i].plot->get_Plot_Pointer()->get_Thumbnail_Grabber()->request();
+        else if (renderSched->isDirty(id) == true)
+        {
+            Prepare_Individual(i);
+            Plot_Individual(i);
+            Plot_Pool[i].plot->get_Plot_Pointer()->get_Thumbnail_Grabber()->grab();
+            renderSched->markRendered(id);
+        }
+    }
     for (i = 0; i < XY_Plot_Pool.count(); i++)
-        thumbPlotAssInv.value(XY_Plot_Pool[i].index)->setIcon(QIcon(QPixmap::fromImage(XY_Plot_Pool[i].plot->get_Plot_Pointer()->getPlotFigure().scaled(150, 150))));
+    {
+        id = static_cast<int>(XY_Plot_Pool[i].index);
+        if (renderScheduler::isShown(XY_Plot_Pool[i].plot) == true)
+            XY_Plot_Pool[i].plot->get_Plot_Pointer()->get_Thumbnail_Grabber()->request();
+        else if (renderSched->isDirty(id) == true)
+        {
+            Prepare_and_Plot_XY_Individual(i);
+            XY_Plot_Pool[i].plot->get_Plot_Pointer()->get_Thumbnail_Grabber()->grab();
+            renderSched->markRendered(id);
+        }
+    }
+}
+
+void SgnalPlotterManager::setThumbnail(int index, QImage image)
+{
+    if (thumbPlotAssInv.contains(static_cast<uint32_t>(index)) == false)  //the plot has been removed meanwhile
+        return;
+
+    thumbPlotAssInv.value(static_cast<uint32_t>(index))->setIcon(QIcon(QPixmap::fromImage(image)));
 }
 
 void SgnalPlotterManager::plotClose(int index)
@@ -1291,6 +2326,7 @@ void SgnalPlotterManager::sigSetTriggered()
                 Plot_Pool[i].plot->addSignal(Plot_Pool[i].signals_associated[j].signal_ID, Signal_Pool[sig_pos]->get_Name(), Plot_Pool[i].signals_associated[j].signal_color);
             }
         }
+        Invalidate_Plots(RENDER_DIRTY_STYLE);  //colors and line widths may have changed
     }
 
     delete sD;
@@ -1402,7 +2438,7 @@ void SgnalPlotterManager::deassociateTriggered()
         msgBox.exec();
     }
 
-    Prepare_and_Plot();
+    Invalidate_Plots(RENDER_DIRTY_STYLE);
 }
 
 void SgnalPlotterManager::associateXYTriggered()
@@ -1610,7 +2646,7 @@ void SgnalPlotterManager::deassociateXYTriggered()
         msgBox.exec();
     }
 
-    Prepare_and_Plot();
+    Invalidate_Plots(RENDER_DIRTY_STYLE);
 }
 
 void SgnalPlotterManager::changeTitleTriggered()
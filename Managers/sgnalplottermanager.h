@@ -67,10 +67,19 @@
 #include "Dialogs/xy_plot_window.h"
 #include "Dialogs/sigassdlg.h"
 #include "filenamegenerator.h"
+#include "memorymanager.h"
+#include "commandtrack.h"
+#include "derivedsignal.h"
+#include "streamfilter.h"
+#include "triggerengine.h"
+#include "timeindex.h"
+#include "renderscheduler.h"
 
 #define NO_CMD		0
 #define RECORD_CMD	1
 
+#define RENDER_FFT_TARGET   -1  //render target of the FFT windows, the plot indexes are never negative
+
 //This class contains all the signals information and data
 //It also contains all the information about the number of plotter class instances
 //and by passing their grid info prepares the data to be sent to a particular plot
@@ -105,6 +114,12 @@ public:
     void Pass_Data_to_Signal(uint32_t index, float* data, int N_Data);  //passed the obtained data to the indexed signal
     void Clear_Signal_Data(uint32_t index);  //clears the data of a signal
 
+    uint32_t Add_Derived_Signal(QString signal_name, QString expression, QString *error);  //adds a math channel calculated from other signals, returns 0 on error
+    void Update_Derived_Signals(int N_Data);  //calculates the math channels from the samples of their inputs received since the last call, aligned by absolute position; N_Data is used by the constant expressions
+    uint32_t Add_Filtered_Signal(QString signal_name, uint32_t input_index, filterSettings settings, QString *error);  //adds a signal filtered while received, returns 0 on error
+    void Update_Triggers(int N_Data);  //scans the new samples of the condition signals with the trigger engine, to be called after the math channels
+    void Update_Sweeps();  //collects the triggered sweeps of the time plots on the received samples, to be called after the triggers
+
     void Pass_Cmd_to_Pool(uint8_t* cmd, int N_Data);
 
     uint32_t Add_Plot(QString plot_name, double frequency);
@@ -122,9 +137,18 @@ public:
     void Enable_Record(uint32_t signal_index, bool record);
     void Enable_Record_All(bool record);
 
-    void set_plot_frequency(double frequency) { if (frequency > 0) { plot_frequency = frequency; fftMgr->setFrequency(frequency); } }
+    void set_plot_frequency(double frequency) { if (frequency > 0) { plot_frequency = frequency; fftMgr->setFrequency(frequency); time_Index.setFrequency(frequency); } }
+
+    void Acquisition_Stopped() { acquisition_Paused = true; }  //the next samples will open a new time segment
+    double Sample_to_Time(uint64_t idx);  //time in seconds of a sample, counted from the oldest sample stored
+    uint64_t Time_to_Sample(double t);  //sample closest to t
+    int Time_Range_to_Samples(double t0, double t1, uint64_t *start, uint64_t *end);  //samples [start, end) within t0 and t1, returns -1 if there are none
+    int Get_Time_Bounds(double *t0, double *t1);  //time of the oldest and of the newest sample, returns -1 if there are no data
 
-    void Prepare_and_Plot(void);  //prepares the datas per each plot and trigger the painting
+    void Prepare_and_Plot(void);  //marks the plots whose data changed, the painting is triggered by the render scheduler
+    void Invalidate_Plots(int flags);  //all the plots will be prepared again at the next frame
+    void set_Max_Fps(int fps) { renderSched->setMaxFps(fps); }
+    int get_Max_Fps() { return renderSched->getMaxFps(); }
 
     void set_Max_N_Data(unsigned int N) { if (N > 1) maxNData = N; }
     void set_Plots_N_Points(int N);
@@ -136,11 +160,21 @@ public:
     void exportFFT();
 
     int exportToFile(QString filename);
+    int exportTimeRangeToFile(QString filename, double t0, double t1);
     int autoExportToFile();
 
     void Organize_Windows();  //automatically organizes windows
 
-    qint64 getSignalMemoryData();
+    qint64 getSignalMemoryData();  //bytes taken by the samples stored in the signals
+    memoryReport getMemoryReport();  //accounts all the memory allocated for signals, commands, FFTs and plot buffers
+    mem_status_t enforceMemoryBudget(memoryReport *report);  //applies the memory policy if the budget has been exceeded
+    void memoryBudgetSettings();
+    void signalPrioritySettings();
+    void newMathChannel();
+    void newFilterChannel();
+    void triggerEngineSettings();
+    int exportTriggerSegments(QString filename);
+    void setHistoryCompression(bool en);  //enables the compression of the recorded data older than the maximum number of samples
     void clearAllData();
 
     void updateFonts();
@@ -152,7 +186,9 @@ public:
 
 public slots:
     void replot(int index);
+    void renderPlots(QVector<int> ids, QVector<int> flags);
     void updateThumbs();
+    void setThumbnail(int index, QImage image);
     void plotClose(int index);
     void xy_plotClose(int index);
     void thumbDoubleClick(QListWidgetItem *item);
@@ -175,14 +211,30 @@ signals:
 private:
     fftManager *fftMgr;
     filenameGenerator *fileGen;
+    memoryManager *memMgr;
+    renderScheduler *renderSched;  //decides when the plots are prepared and repainted
 
     unsigned int maxNData;  //when not in record mode, indicates how many data samples will be stored per signal
     QVector<Signal_Data*> Signal_Pool;  //this is our pool of Signals
     uint32_t N_Signals;  //number of signals in the pool
 
-    QVector<uint8_t> command_Pool;
+    commandTrack command_Track;  //commands received with the data, stored as transitions
     bool command_Rec;
 
+    bool historyCompression;  //applied to all the signals
+
+    timeIndex time_Index;  //time of the received samples, follows the commands and the received signals
+    QElapsedTimer acquisition_Clock;  //measures the pauses of the acquisition
+    bool acquisition_Paused;
+
+    QVector<derivedSignal*> Derived_Pool;  //math channels, evaluated in order of creation so that a channel can use the previous ones
+    std::vector<float> derived_buffer;
+
+    QVector<streamFilter*> Filter_Pool;  //filters applied to the signals while they are received
+
+    triggerEngine *trigger_Engine;  //nullptr when no trigger is armed
+    QString trigger_Notice;  //why the trigger engine has been disabled, shown by the next trigger dialog
+
     QVector<Plot_Structure> Plot_Pool;  //this is our pool of Plots
     uint32_t N_Plots;  //number of plots in the pool
 
@@ -209,7 +261,14 @@ private:
 
     void prepareSigViewModel();
 
-    int Prepare_and_Plot_Individual(int i);
+    int find_time_signal();  //position of a received signal named Time, used instead of the sampling frequency if available
+    int export_Samples(QString filename, uint64_t from, uint64_t to);
+
+    float *get_Signal_Segment(int pos, uint64_t start, int N, std::vector<float> *temp, signalSnapshot *snap);  //returns N samples of a signal, decompressing the history if needed
+    float *get_Aligned_Segment(int pos, uint64_t from, int N, std::vector<float> *temp, signalSnapshot *snap);  //as above for the rows from - from + N of the command track, NAN where the signal has no sample
+
+    int Prepare_Individual(int i);  //starts the preparation on the worker pool
+    void Plot_Individual(int i);  //waits for the preparation and repaints
     int Prepare_and_Plot_XY_Individual(int i);
 
     QString get_type_text(int type);
@@ -40,37 +40,103 @@ Signal_Data::Signal_Data(QString Name, uint32_t Index, int type, float scaling)
     index = Index;
     sig_type = type;
     scaling_factor = scaling;
+    priority = 0;  //by default
+    compression = false;  //by default
+    stopped = false;  //by default
+    rate_divider = 1;  //by default
+    origin = 0;  //by default
+    history_count = 0;
+    history_bytes = 0;
+    reduced_count = 0;
 
-    data_count = static_cast<uint32_t>(signal_data.size());
+    signal_data = std::make_shared<std::vector<float>>();
+    data_start = 0;
+    version = 0;
+    received = 0;
+
+    data_count = 0;
 }
 
 Signal_Data::~Signal_Data()
 {
-    signal_data.clear();
+    Clean_History();
+}
+
+void Signal_Data::Clean_Data()
+{
+    //readers may still hold the old buffer, so we just start a new one
+    Replace_Buffer(std::make_shared<std::vector<float>>());
+
+    Clean_History();
+    reduced_count = 0;
+    stopped = false;  //a clean signal records again
+    origin = 0;  //all the signals start again from the next acquisition sample
+
+    QMutexLocker locker(&bufferLock);
+    stats.clear();
+    received = 0;
 }
 
 void Signal_Data::Add_Data(float *data_ptr, int N_data, unsigned int maxData)
 {
     unsigned long long N, old_N;
     unsigned long long size = sizeof(float);
+    uint64_t removed;
+    std::shared_ptr<std::vector<float>> buffer;
 
-    //if N_data is <= 0 we exit
-    if (N_data <= 0)
+    //if N_data is <= 0 or the signal has been stopped we exit
+    if ((N_data <= 0) || (stopped == true))
         return;
 
-    old_N = signal_data.size();
-    //we resize with the new dimension
-    signal_data.resize(old_N + N_data);
+    QMutexLocker locker(&bufferLock);
+
+    old_N = signal_data->size();
+    if (old_N + static_cast<unsigned long long>(N_data) > signal_data->capacity())
+    {
+        if (signal_data.use_count() == 1)  //nobody is reading => the buffer can be compacted and grown in place
+        {
+            signal_data->erase(signal_data->begin(), signal_data->begin() + static_cast<long>(data_start));
+            data_start = 0;
+        }
+        else  //a snapshot is using the buffer => we continue on a new one
+        {
+            buffer = std::make_shared<std::vector<float>>();
+            buffer->reserve(2 * (data_count + static_cast<unsigned long long>(N_data)));
+            buffer->assign(signal_data->begin() + static_cast<long>(data_start), signal_data->end());
+            signal_data = buffer;
+            data_start = 0;
+        }
+        old_N = signal_data->size();
+    }
+
+    //we resize with the new dimension, within the capacity the samples seen by the snapshots are not moved
+    signal_data->resize(old_N + N_data);
 
-    memcpy(signal_data.data() + old_N, data_ptr, N_data * size);
+    memcpy(signal_data->data() + old_N, data_ptr, N_data * size);
+    data_count = static_cast<uint32_t>(signal_data->size() - data_start);
+    version++;
+    received += static_cast<uint64_t>(N_data);
+
+    stats.append(data_ptr, static_cast<uint32_t>(N_data));
+
+    locker.unlock();
 
     if (record == false)
     {
         //if the new data overcome the maxData allowed, we cut
-        N = signal_data.size();
+        N = data_count;
+        removed = history_count;
         if (N > maxData)
-            signal_data.erase(signal_data.begin(), signal_data.begin() + static_cast<int>((N - maxData)));
+        {
+            Drop_Front(static_cast<size_t>(N - maxData));
+            removed += N - maxData;
+        }
+        if (history_count > 0)  //the history is older than maxData as well
+            Clean_History();
+        Release_Reduced(removed);
     }
+    else if (compression == true)
+        Seal_History(maxData);
 
 
 /*  THIS IS OLD CODE. IT'S RELIABLE BUT MUCH SLOWER THAN THE CODE ABOVE. I KEEP IT JUST IN CASE INSTABILITY ARISES AND WE WANT TO RESTORE THE OLD METHOD
@@ -85,17 +151,446 @@ void Signal_Data::Add_Data(float *data_ptr, int N_data, unsigned int maxData)
             signal_data.erase(signal_data.begin(), signal_data.begin() + static_cast<int>((N - maxData)));
     }
 */
-    data_count = static_cast<uint32_t>(signal_data.size());
+}
+
+signalSnapshot Signal_Data::Get_Snapshot()
+{
+    signalSnapshot snap;
+    QMutexLocker locker(&bufferLock);
+
+    snap.buffer = signal_data;
+    snap.data = signal_data->data() + data_start;
+    snap.count = data_count;
+    snap.version = version;
+    snap.first = stats.getFirst();
+    snap.stats_epoch = stats.getEpoch();
+    snap.received = received;
+    snap.origin = origin;
+    snap.rate_divider = rate_divider;
+
+    return snap;
+}
+
+signalSnapshot Signal_Data::Get_Snapshot(uint32_t min_count)
+{
+    signalSnapshot snap;
+    uint64_t extra;
+    std::shared_ptr<std::vector<float>> buffer;
+
+    snap = Get_Snapshot();
+    if ((snap.count >= min_count) || (history_count == 0))
+        return snap;
+
+    //the missing samples are decompressed from the end of the history in front of the signal buffer
+    extra = min_count - snap.count;
+    if (extra > history_count)
+        extra = history_count;
+    buffer = std::make_shared<std::vector<float>>(static_cast<size_t>(extra) + snap.count);
+    Copy_Data(history_count - extra, static_cast<uint32_t>(extra), buffer->data());
+    memcpy(buffer->data() + extra, snap.data, snap.count * sizeof(float));
+
+    snap.buffer = buffer;
+    snap.data = buffer->data();
+    snap.count = static_cast<uint32_t>(buffer->size());
+    if (snap.first >= extra)  //the history continues the absolute positions of the signal buffer
+        snap.first -= extra;
+    else
+    {
+        snap.first = 0;
+        snap.stats_epoch = SNAPSHOT_NO_EPOCH;
+    }
+
+    return snap;
+}
+
+statSummary Signal_Data::Get_Stats(const signalSnapshot *snap, uint32_t start, uint32_t end)
+{
+    QMutexLocker locker(&bufferLock);
+
+    return stats.query(snap->data, snap->first, snap->stats_epoch, start, end);
+}
+
+statSummary Signal_Data::Get_Cumulative_Stats()
+{
+    QMutexLocker locker(&bufferLock);
+
+    return stats.getCumulative();
+}
+
+void Signal_Data::Reset_Cumulative_Stats()
+{
+    QMutexLocker locker(&bufferLock);
+
+    stats.resetCumulative();
+}
+
+uint64_t Signal_Data::get_Version()
+{
+    QMutexLocker locker(&bufferLock);
+
+    return version;
+}
+
+void Signal_Data::Drop_Front(size_t N)
+{
+    std::shared_ptr<std::vector<float>> buffer;
+    QMutexLocker locker(&bufferLock);
+
+    if (N > data_count)
+        N = data_count;
+
+    data_start += N;
+    data_count = static_cast<uint32_t>(signal_data->size() - data_start);
+    version++;
+
+    stats.dropFront(stats.getFirst() + N);
+
+    //the discarded samples are released once they take more room than the valid ones
+    if (data_start <= data_count)
+        return;
+
+    if (signal_data.use_count() == 1)
+        signal_data->erase(signal_data->begin(), signal_data->begin() + static_cast<long>(data_start));
+    else
+    {
+        buffer = std::make_shared<std::vector<float>>();
+        buffer->reserve(signal_data->capacity());
+        buffer->assign(signal_data->begin() + static_cast<long>(data_start), signal_data->end());
+        signal_data = buffer;
+    }
+    data_start = 0;
+}
+
+void Signal_Data::Replace_Buffer(std::shared_ptr<std::vector<float>> buffer)
+{
+    QMutexLocker locker(&bufferLock);
+
+    signal_data = buffer;
+    data_start = 0;
+    data_count = static_cast<uint32_t>(signal_data->size());
+    version++;
+
+    stats.rebuild(signal_data->data(), data_count);
+}
+
+int64_t Signal_Data::Stored_Index(uint64_t acq)
+{
+    int64_t rec, total, first_full, s;
+
+    if (acq < origin)
+        return -1;
+    rec = static_cast<int64_t>((acq - origin) / static_cast<uint64_t>(rate_divider));  //received sample at or before acq
+    if (rec >= static_cast<int64_t>(received))
+        return -1;  //not received yet, e.g. delayed by a filter
+
+    //the full resolution samples are the last ones received, before them one sample every two received is stored
+    total = static_cast<int64_t>(Count_Total());
+    first_full = static_cast<int64_t>(received) - (total - static_cast<int64_t>(reduced_count));
+    if (rec >= first_full)
+        return total - (static_cast<int64_t>(received) - rec);
+
+    s = static_cast<int64_t>(reduced_count) - ((first_full - rec + 1) / 2);
+    if (s < 0)
+        return -1;  //already dropped
+
+    return s;
+}
+
+int Signal_Data::Copy_Data(uint64_t start, uint32_t N, float *out)
+{
+    size_t c;
+    uint64_t chunk_start, offset, n_copy;
+    std::vector<float> block;
+
+    if (start + N > Count_Total())
+        return -1;
+
+    //first the part contained in the history, decompressed one chunk at a time
+    chunk_start = 0;
+    for (c = 0; (c < history.size()) && (N > 0); c++)
+    {
+        if (start < chunk_start + history[c].n_samples)
+        {
+            offset = start - chunk_start;
+            n_copy = history[c].n_samples - offset;
+            if (n_copy > N)
+                n_copy = N;
+
+            if ((offset == 0) && (n_copy == history[c].n_samples))  //whole chunk => decoded in place
+                chunkCodec::decodeChunk(&history[c], out);
+            else
+            {
+                block.resize(history[c].n_samples);
+                chunkCodec::decodeChunk(&history[c], block.data());
+                memcpy(out, block.data() + offset, n_copy * sizeof(float));
+            }
+
+            out += n_copy;
+            start += n_copy;
+            N -= static_cast<uint32_t>(n_copy);
+        }
+        chunk_start += history[c].n_samples;
+    }
+
+    //then the part still in the signal buffer
+    if (N > 0)
+        memcpy(out, retrieve_Data_Pointer() + (start - history_count), N * sizeof(float));
+
+    return 0;
+}
+
+void Signal_Data::Seal_History(unsigned int maxData)
+{
+    size_t sealed;
+    compressedChunk chunk;
+    float *data;
+
+    //the last maxData samples are kept uncompressed so that plots and FFT can still access them directly
+    sealed = 0;
+    data = retrieve_Data_Pointer();
+    while (data_count - sealed >= static_cast<size_t>(maxData) + CHUNK_SAMPLES)
+    {
+        chunkCodec::encodeChunk(data + sealed, CHUNK_SAMPLES, &chunk);
+        history.push_back(chunk);
+        history_count += CHUNK_SAMPLES;
+        history_bytes += chunk.data.size() + static_cast<qint64>(sizeof(compressedChunk));
+        sealed += CHUNK_SAMPLES;
+    }
+
+    if (sealed > 0)
+        Drop_Front(sealed);
+}
+
+void Signal_Data::Clean_History()
+{
+    history.clear();
+    history.shrink_to_fit();
+    history_count = 0;
+    history_bytes = 0;
+}
+
+void Signal_Data::Release_Reduced(uint64_t N)
+{
+    if (N >= reduced_count)
+        reduced_count = 0;
+    else
+        reduced_count -= N;
 }
 
 float Signal_Data::getLastSample()
 {
     if (data_count > 0)
-        return signal_data.data()[data_count - 1];
+        return retrieve_Data_Pointer()[data_count - 1];
     else
         return 0.0;
 }
 
+qint64 Signal_Data::Downsample_Old(uint32_t keep)
+{
+    size_t c, n;
+    uint64_t from, to, hist_count, chunk_start, a, b, k, halved;
+    qint64 old_mem;
+    float *data;
+    std::vector<float> block, reduced;
+    compressedChunk chunk;
+    std::shared_ptr<std::vector<float>> buffer;
+
+    //the samples before reduced_count have already been halved, so only the samples received since the last call are reduced
+    if (Count_Total() <= reduced_count + keep + 1)
+        return 0;
+
+    old_mem = Memory_Data();
+    from = reduced_count;
+    to = Count_Total() - keep;
+    hist_count = history_count;
+    halved = 0;
+
+    //the history chunks overlapping the range are decoded, halved and sealed again
+    //one sample every two is kept counting from the start of the range, also across the chunks
+    chunk_start = 0;
+    for (c = 0; c < history.size(); c++)
+    {
+        n = history[c].n_samples;
+        if ((chunk_start + n > from) && (chunk_start < to))
+        {
+            a = 0;
+            if (from > chunk_start)
+                a = from - chunk_start;
+            b = n;
+            if (to < chunk_start + n)
+                b = to - chunk_start;
+
+            block.resize(n);
+            chunkCodec::decodeChunk(&history[c], block.data());
+            reduced.assign(block.begin(), block.begin() + static_cast<long>(a));
+            k = a;
+            if ((chunk_start + k - from) % 2 != 0)
+                k++;
+            for (; k < b; k += 2)
+            {
+                reduced.push_back(block[k]);
+                halved++;
+            }
+            reduced.insert(reduced.end(), block.begin() + static_cast<long>(b), block.end());
+
+            chunkCodec::encodeChunk(reduced.data(), static_cast<uint32_t>(reduced.size()), &chunk);
+            history_bytes += static_cast<qint64>(chunk.data.size()) - static_cast<qint64>(history[c].data.size());
+            history_count -= n - reduced.size();
+            history[c] = chunk;
+        }
+        chunk_start += n;
+    }
+
+    //then the part still in the signal buffer, in a new buffer since snapshots may use the old one
+    if (to > hist_count)
+    {
+        a = 0;
+        if (from > hist_count)
+            a = from - hist_count;
+        b = to - hist_count;
+        data = retrieve_Data_Pointer();
+
+        buffer = std::make_shared<std::vector<float>>();
+        buffer->reserve(data_count - (b - a) / 2);
+        buffer->assign(data, data + a);
+        k = a;
+        if ((hist_count + k - from) % 2 != 0)
+            k++;
+        for (; k < b; k += 2)
+        {
+            buffer->push_back(data[k]);
+            halved++;
+        }
+        buffer->insert(buffer->end(), data + b, data + data_count);
+
+        Replace_Buffer(buffer);
+    }
+    else
+    {
+        QMutexLocker locker(&bufferLock);
+        version++;
+    }
+
+    reduced_count = from + halved;
+
+    return old_mem - Memory_Data();
+}
+
+qint64 Signal_Data::Spill_Old(QString filename, uint32_t keep)
+{
+    size_t c, n;
+    uint64_t N, chunk_start, live;
+    qint64 old_mem, bytes, old_size;
+    QFile file(filename);
+    std::vector<float> block;
+    compressedChunk chunk;
+    std::shared_ptr<std::vector<float>> buffer;
+
+    if (Count_Total() <= keep)
+        return 0;
+
+    N = Count_Total() - keep;  //number of old samples that will be written to disk
+
+    //the samples are appended as raw float32 so that successive spills of the same signal end up in one file
+    if (file.open(QIODevice::WriteOnly | QIODevice::Append) == false)
+    {
+        qDebug() << "Could not open spill file " << filename;
+        return 0;
+    }
+    old_size = file.size();  //a failed spill is cut back to this size, the samples stay in memory
+
+    //the history is older than the signal buffer, so it is written first
+    chunk_start = 0;
+    for (c = 0; (c < history.size()) && (chunk_start < N); c++)
+    {
+        n = history[c].n_samples;
+        block.resize(n);
+        chunkCodec::decodeChunk(&history[c], block.data());
+        if (chunk_start + n > N)  //only the older part of the chunk leaves the memory
+            n = static_cast<size_t>(N - chunk_start);
+        bytes = static_cast<qint64>(n * sizeof(float));
+        if (file.write(reinterpret_cast<const char*>(block.data()), bytes) != bytes)
+        {
+            qDebug() << "Could not write spill file " << filename;
+            file.close();
+            if (file.resize(old_size) == false)
+                qDebug() << "Could not restore spill file " << filename;
+            return 0;
+        }
+        chunk_start += n;
+    }
+
+    live = N - chunk_start;
+    if (live > 0)
+    {
+        bytes = static_cast<qint64>(live * sizeof(float));
+        if (file.write(reinterpret_cast<const char*>(retrieve_Data_Pointer()), bytes) != bytes)
+        {
+            qDebug() << "Could not write spill file " << filename;
+            file.close();
+            if (file.resize(old_size) == false)
+                qDebug() << "Could not restore spill file " << filename;
+            return 0;
+        }
+    }
+    file.close();
+
+    old_mem = Memory_Data();
+
+    //the written chunks are released, the remaining part of a chunk written partially is sealed again
+    if (c > 0)
+    {
+        if (n < history[c - 1].n_samples)
+        {
+            chunkCodec::encodeChunk(block.data() + n, history[c - 1].n_samples - static_cast<uint32_t>(n), &chunk);
+            history[c - 1] = chunk;
+            c--;
+        }
+        history.erase(history.begin(), history.begin() + static_cast<long>(c));
+        history_count = 0;
+        history_bytes = 0;
+        for (c = 0; c < history.size(); c++)
+        {
+            history_count += history[c].n_samples;
+            history_bytes += static_cast<qint64>(history[c].data.size() + sizeof(compressedChunk));
+        }
+    }
+
+    if (live > 0)
+    {
+        buffer = std::make_shared<std::vector<float>>(retrieve_Data_Pointer() + live, retrieve_Data_Pointer() + data_count);
+        Replace_Buffer(buffer);
+    }
+    else
+    {
+        QMutexLocker locker(&bufferLock);
+        version++;
+    }
+
+    Release_Reduced(N);
+
+    return old_mem - Memory_Data();
+}
+
+qint64 Signal_Data::Trim_Data(uint32_t maxData)
+{
+    size_t N;
+    qint64 old_mem;
+    std::shared_ptr<std::vector<float>> buffer;
+
+    old_mem = Memory_Data();
+
+    N = data_count;
+    if (N > maxData)
+        N = maxData;
+    Release_Reduced(Count_Total() - N);
+    buffer = std::make_shared<std::vector<float>>(retrieve_Data_Pointer() + (data_count - N), retrieve_Data_Pointer() + data_count);
+    Replace_Buffer(buffer);
+    Clean_History();
+
+    return old_mem - Memory_Data();
+}
+
 float Signal_Data::abs_float(float value)
 {
     if (value < 0)
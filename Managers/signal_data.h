@@ -38,8 +38,31 @@
 #include <QString>
 #include <QColor>
 #include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
 
 #include <math.h>
+#include <vector>
+#include <memory>
+
+#include "chunkcodec.h"
+#include "runningstats.h"
+
+typedef struct _signalSnapshot
+{
+    std::shared_ptr<const std::vector<float>> buffer;  //keeps the data alive as long as the snapshot exists
+    const float *data;  //first sample of the view
+    uint32_t count;  //number of samples in the view
+    uint64_t version;  //version of the signal when the snapshot has been taken
+    uint64_t first;  //absolute position of the first sample, used to read the running statistics
+    uint64_t stats_epoch;  //changes every time the absolute positions are assigned again (clean, downsample)
+    uint64_t received;  //samples received since the last clean, the last sample of the view is the received - 1 th
+    uint64_t origin;  //acquisition sample of the first sample received
+    int rate_divider;  //received sample k is the acquisition sample origin + k * rate_divider
+} signalSnapshot;
+
+#define SNAPSHOT_NO_EPOCH   0xFFFFFFFFFFFFFFFFull  //the positions of the snapshot do not match the running statistics, they are calculated on the data
 
 class Signal_Data
 {
@@ -48,28 +71,83 @@ public:
     ~Signal_Data();
 
     void Add_Data(float* data_ptr, int N_data, unsigned int maxData);  //used to add new data to the signal buffer
-    void Clean_Data() { signal_data.clear(); data_count = static_cast<uint32_t>(signal_data.size()); }  //cleans the whole signal buffer
-    uint32_t Count_Data() {return static_cast<uint32_t>(signal_data.size()); }  //returns the number of data in the signal buffer
+    void Clean_Data();  //cleans the whole signal buffer
+    uint32_t Count_Data() {return data_count; }  //returns the number of data in the signal buffer
+    uint64_t Count_History() { return history_count; }  //returns the number of data sealed in compressed chunks
+    uint64_t Count_Total() { return history_count + data_count; }  //returns the number of data in the history and in the signal buffer
+    uint64_t Count_Received() { return received; }  //returns the number of data received since the last clean, used as absolute position of the next sample
+    int Copy_Data(uint64_t start, uint32_t N, float *out);  //copies N samples starting from start (counted from the oldest sample in the history)
+    int64_t Stored_Index(uint64_t acq);  //stored sample (history included) holding the acquisition sample acq, i.e. the last one at or before it, -1 if there is none
 
     QString get_Name() { return name; }
     uint32_t get_Index() { return index; }
 
     void set_Record(bool rec) { record = rec; }
+    void set_Stopped(bool stop) { stopped = stop; }  //a stopped signal discards the new data, used by the memory manager
+    bool get_Stopped() { return stopped; }
+    void set_Rate_Divider(int div) { if (div >= 1) rate_divider = div; }  //one sample every rate_divider samples of the acquisition, e.g. decimating filters
+    int get_Rate_Divider() { return rate_divider; }
+    void set_Origin(uint64_t org) { origin = org; }  //acquisition sample of the first sample received, for the signals created during the acquisition
 
-    float* retrieve_Data_Pointer() { return signal_data.data(); }
+    float* retrieve_Data_Pointer() { return signal_data->data() + data_start; }  //valid only till the next change of the signal, use Get_Snapshot from other threads
     float getLastSample();
 
+    signalSnapshot Get_Snapshot();  //immutable view of the signal buffer that stays valid while new data are added
+    signalSnapshot Get_Snapshot(uint32_t min_count);  //as above, the view starts in the history if the signal buffer holds less than min_count samples
+    uint64_t get_Version();  //increased at every change of the signal buffer
+
+    statSummary Get_Stats(const signalSnapshot *snap, uint32_t start, uint32_t end);  //statistics of the samples start - end of the snapshot
+    statSummary Get_Cumulative_Stats();  //statistics of all the samples received since the last clean or reset
+    void Reset_Cumulative_Stats();
+
+    qint64 Memory_Data() { return static_cast<qint64>(signal_data->capacity() * sizeof(float)) + history_bytes; }  //returns the bytes allocated by the signal buffer and the history
+    void set_Priority(int prio) { if (prio >= 0) priority = prio; }
+    int get_Priority() { return priority; }
+    bool get_Record() { return record; }
+    void set_Compression(bool en) { compression = en; }
+    bool get_Compression() { return compression; }
+
+    qint64 Downsample_Old(uint32_t keep);  //halves the resolution of the full resolution data older than the last keep samples, history included, returns the bytes released
+    qint64 Spill_Old(QString filename, uint32_t keep);  //moves the data older than the last keep samples to filename, oldest first, returns the bytes released
+    qint64 Trim_Data(uint32_t maxData);  //keeps only the last maxData samples, returns the bytes released
+
 private:
     QString name;   //name of the signal
     uint32_t index;  //ID of the signal
 
     bool record;  //if record is true, new data are added to the old ones, if record is false then old data are cleared before accepting new ones
+    bool stopped;  //if stopped is true, new data are discarded
+    int rate_divider;
+    uint64_t origin;
 
     int sig_type;
     float scaling_factor;
+    int priority;  //used by the memory manager: signals with lower priority are reduced first
 
-    std::vector<float> signal_data;  //includes all the datas of the signal  ==> signal buffer
+    //includes all the datas of the signal  ==> signal buffer
+    //samples before data_start have been discarded but are still allocated, samples already in the buffer are never modified
+    //since snapshots may be reading them: changes other than appending are done on a new buffer (copy on write)
+    std::shared_ptr<std::vector<float>> signal_data;
+    size_t data_start;  //first valid sample in signal_data
     uint32_t data_count;  //number of data contained in the signal buffer
+    uint64_t version;
+    uint64_t received;  //samples added since the last clean
+    QMutex bufferLock;  //protects signal_data, data_start, version and received while a snapshot is taken
+
+    runningStats stats;  //updated once per received batch, protected by bufferLock
+
+    void Drop_Front(size_t N);  //discards the N oldest samples of the signal buffer
+    void Replace_Buffer(std::shared_ptr<std::vector<float>> buffer);
+
+    bool compression;  //if true, while recording the data older than maxData are sealed into compressed chunks
+    std::vector<compressedChunk> history;  //sealed chunks, the oldest first
+    uint64_t history_count;  //number of samples in the history
+    qint64 history_bytes;  //bytes taken by the history
+    uint64_t reduced_count;  //number of the oldest samples, history included, already downsampled: they are never downsampled again
+
+    void Seal_History(unsigned int maxData);
+    void Clean_History();
+    void Release_Reduced(uint64_t N);  //the N oldest samples have been removed
 
     float abs_float(float value);
 };
@@ -0,0 +1,357 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :streamfilter.cpp
+  @brief    :Functions of the Stream Filter Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "streamfilter.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+streamFilter::streamFilter(filterSettings settings, uint32_t input_index, uint32_t output_index)
+{
+    if (settings.order < 1)
+        settings.order = 1;
+    if (settings.decimation < 1)
+        settings.decimation = 1;
+    if (settings.cutoff <= 0.0)
+        settings.cutoff = 0.001;
+    if (settings.cutoff >= 0.5)
+        settings.cutoff = 0.499;
+
+    this->settings = settings;
+    this->input_index = input_index;
+    this->output_index = output_index;
+
+    nfft = 0;
+    fft_fwd = nullptr;
+    fft_inv = nullptr;
+
+    switch (settings.type)
+    {
+    case FILTER_IIR_LOWPASS:
+    case FILTER_IIR_HIGHPASS:
+        designIIR();
+        break;
+
+    case FILTER_FIR_LOWPASS:
+        designFIR();
+        break;
+
+    default:
+        break;
+    }
+
+    reset();
+}
+
+streamFilter::~streamFilter()
+{
+    if (fft_fwd != nullptr)
+        free(fft_fwd);
+    if (fft_inv != nullptr)
+        free(fft_inv);
+}
+
+void streamFilter::reset()
+{
+    size_t i;
+
+    phase = 0;
+    line_pos = 0;
+    sum = 0.0;
+
+    for (i = 0; i < sections.size(); i++)
+    {
+        sections[i].z1 = 0.0;
+        sections[i].z2 = 0.0;
+    }
+
+    line.clear();
+    if (settings.type == FILTER_FIR_LOWPASS)
+        line.assign(taps.size() - 1, 0.0f);
+    else if (settings.type == FILTER_MOVING_AVERAGE)
+        line.assign(static_cast<size_t>(settings.order), 0.0f);
+}
+
+int streamFilter::process(const float *in, int N, std::vector<float> *out)
+{
+    int i, n_out;
+    size_t k, n_taps, hist;
+    double x, y;
+    float acc;
+    const float *src;
+
+    out->clear();
+
+    if (N <= 0)
+        return 0;
+
+    switch (settings.type)
+    {
+    case FILTER_IIR_LOWPASS:
+    case FILTER_IIR_HIGHPASS:
+        for (i = 0; i < N; i++)
+        {
+            x = static_cast<double>(in[i]);
+            for (k = 0; k < sections.size(); k++)
+            {
+                biquadSection &s = sections[k];
+                y = s.b0 * x + s.z1;
+                s.z1 = s.b1 * x - s.a1 * y + s.z2;
+                s.z2 = s.b2 * x - s.a2 * y;
+                x = y;
+            }
+            if (phase == 0)
+                out->push_back(static_cast<float>(x));
+            phase = (phase + 1) % settings.decimation;
+        }
+        break;
+
+    case FILTER_FIR_LOWPASS:
+        //the delay line holds the last n_taps - 1 samples of the previous batch
+        n_taps = taps.size();
+        hist = n_taps - 1;
+        line.insert(line.end(), in, in + N);
+        if (use_FFT(N) == true)
+            i = fir_FFT(N, out);
+        else
+        {
+            for (i = phase; i < N; i += settings.decimation)
+            {
+                src = line.data() + i;
+                acc = 0.0f;
+                for (k = 0; k < n_taps; k++)  //contiguous, but the sum keeps its order and is not vectorized without fast-math
+                    acc += src[k] * taps[k];
+                out->push_back(acc);
+            }
+        }
+        phase = (i - N);
+        line.erase(line.begin(), line.end() - static_cast<long>(hist));
+        break;
+
+    case FILTER_MOVING_AVERAGE:
+        for (i = 0; i < N; i++)
+        {
+            sum += static_cast<double>(in[i]) - static_cast<double>(line[static_cast<size_t>(line_pos)]);
+            line[static_cast<size_t>(line_pos)] = in[i];
+            line_pos = (line_pos + 1) % settings.order;
+            if (phase == 0)
+                out->push_back(static_cast<float>(sum / settings.order));
+            phase = (phase + 1) % settings.decimation;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    n_out = static_cast<int>(out->size());
+
+    return n_out;
+}
+
+QString streamFilter::getTypeText(int type)
+{
+    QString st;
+
+    switch (type)
+    {
+    case FILTER_IIR_LOWPASS:
+        st = "IIR Low-pass (Butterworth)";
+        break;
+
+    case FILTER_IIR_HIGHPASS:
+        st = "IIR High-pass (Butterworth)";
+        break;
+
+    case FILTER_FIR_LOWPASS:
+        st = "FIR Low-pass (Hamming window)";
+        break;
+
+    case FILTER_MOVING_AVERAGE:
+        st = "Moving average";
+        break;
+
+    default:
+        st = "None";
+    }
+
+    return st;
+}
+
+void streamFilter::designIIR()
+{
+    int k, n_sec;
+    double w0, cw, sw, q, alpha, a0;
+    biquadSection s;
+
+    //cascade of second order sections with the Q factors of a Butterworth filter of order 2 * n_sec
+    n_sec = settings.order;
+    w0 = 2.0 * M_PI * settings.cutoff;
+    cw = cos(w0);
+    sw = sin(w0);
+
+    sections.clear();
+    for (k = 0; k < n_sec; k++)
+    {
+        q = 1.0 / (2.0 * cos(M_PI * (2 * k + 1) / (4.0 * n_sec)));
+        alpha = sw / (2.0 * q);
+        a0 = 1.0 + alpha;
+
+        if (settings.type == FILTER_IIR_LOWPASS)
+        {
+            s.b0 = (1.0 - cw) / 2.0 / a0;
+            s.b1 = (1.0 - cw) / a0;
+            s.b2 = s.b0;
+        }
+        else
+        {
+            s.b0 = (1.0 + cw) / 2.0 / a0;
+            s.b1 = -(1.0 + cw) / a0;
+            s.b2 = s.b0;
+        }
+        s.a1 = -2.0 * cw / a0;
+        s.a2 = (1.0 - alpha) / a0;
+        s.z1 = 0.0;
+        s.z2 = 0.0;
+
+        sections.push_back(s);
+    }
+}
+
+void streamFilter::designFIR()
+{
+    int i, n, m;
+    double h, sum_h, x;
+
+    //windowed sinc, odd number of taps so that the delay is an integer number of samples
+    n = settings.order | 1;
+    m = n / 2;
+    taps.resize(static_cast<size_t>(n));
+
+    sum_h = 0.0;
+    for (i = 0; i < n; i++)
+    {
+        x = i - m;
+        if (i == m)
+            h = 2.0 * settings.cutoff;
+        else
+            h = sin(2.0 * M_PI * settings.cutoff * x) / (M_PI * x);
+        if (n > 1)
+            h *= 0.54 - 0.46 * cos(2.0 * M_PI * i / (n - 1));
+        taps[static_cast<size_t>(i)] = static_cast<float>(h);
+        sum_h += h;
+    }
+
+    //unity gain in DC
+    for (i = 0; i < n; i++)
+        taps[static_cast<size_t>(i)] = static_cast<float>(taps[static_cast<size_t>(i)] / sum_h);
+
+    if (n < FILTER_FFT_MIN_TAPS)
+        return;
+
+    //frequency response for the overlap-save convolution, the taps are reversed since the output is their dot product with the delay line
+    nfft = 1;
+    while (nfft < FILTER_FFT_RATIO * n)
+        nfft <<= 1;
+    fft_fwd = kiss_fftr_alloc(nfft, 0, nullptr, nullptr);
+    fft_inv = kiss_fftr_alloc(nfft, 1, nullptr, nullptr);
+    if ((fft_fwd == nullptr) || (fft_inv == nullptr))
+    {
+        qDebug("The FFT of the FIR filter could not be allocated");
+        nfft = 0;
+        return;
+    }
+
+    block.assign(static_cast<size_t>(nfft), 0.0f);
+    spectrum.resize(static_cast<size_t>(nfft / 2 + 1));
+    response.resize(static_cast<size_t>(nfft / 2 + 1));
+    for (i = 0; i < n; i++)
+        block[static_cast<size_t>(i)] = taps[static_cast<size_t>(n - 1 - i)] / static_cast<float>(nfft);  //the inverse FFT is not scaled
+    kiss_fftr(fft_fwd, block.data(), response.data());
+}
+
+bool streamFilter::use_FFT(int N)
+{
+    double n_out, blocks, direct, fft;
+
+    if (nfft == 0)
+        return false;
+
+    //rough number of multiply-adds of both methods: each block costs a forward and an inverse real FFT
+    n_out = ceil(static_cast<double>(N - phase) / settings.decimation);
+    blocks = ceil(static_cast<double>(N) / (nfft - static_cast<int>(taps.size()) + 1));
+    direct = n_out * taps.size();
+    fft = blocks * (nfft * log2(static_cast<double>(nfft)) + nfft);
+
+    return (fft < direct);
+}
+
+int streamFilter::fir_FFT(int N, std::vector<float> *out)
+{
+    int i, s, step, hist, avail;
+    size_t k;
+    float re, im;
+
+    //each block of nfft samples of the delay line gives the step outputs which do not wrap around
+    hist = static_cast<int>(taps.size()) - 1;
+    step = nfft - hist;
+    i = phase;
+    for (s = 0; s < N; s += step)
+    {
+        if (i >= s + step)
+            continue;  //no output kept in this block
+
+        avail = std::min(nfft, static_cast<int>(line.size()) - s);
+        std::copy(line.begin() + s, line.begin() + s + avail, block.begin());
+        std::fill(block.begin() + avail, block.end(), 0.0f);  //only beyond the last output
+
+        kiss_fftr(fft_fwd, block.data(), spectrum.data());
+        for (k = 0; k < spectrum.size(); k++)
+        {
+            re = spectrum[k].r * response[k].r - spectrum[k].i * response[k].i;
+            im = spectrum[k].r * response[k].i + spectrum[k].i * response[k].r;
+            spectrum[k].r = re;
+            spectrum[k].i = im;
+        }
+        kiss_fftri(fft_inv, spectrum.data(), block.data());
+
+        while ((i < s + step) && (i < N))
+        {
+            out->push_back(block[static_cast<size_t>(i - s + hist)]);
+            i += settings.decimation;
+        }
+    }
+
+    return i;
+}
@@ -0,0 +1,113 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :streamfilter.h
+  @brief    :Header of the Stream Filter Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef STREAMFILTER_H
+#define STREAMFILTER_H
+
+#include <QString>
+#include <vector>
+
+#include <math.h>
+#include <stdint.h>
+
+#include "3rdparty/kissFFT/kiss_fftr.h"
+
+#define FILTER_SIG_TYPE     8  //signal type used for the filtered signals in the signal pool
+
+#define FILTER_IIR_LOWPASS      0
+#define FILTER_IIR_HIGHPASS     1
+#define FILTER_FIR_LOWPASS      2
+#define FILTER_MOVING_AVERAGE   3
+
+#define FILTER_FFT_MIN_TAPS     64  //shorter FIR filters are always calculated directly
+#define FILTER_FFT_RATIO        4  //size of the FFT blocks with respect to the taps
+
+typedef struct _filterSettings
+{
+    int type;
+    int order;  //number of biquad sections (IIR), taps (FIR) or length (moving average)
+    double cutoff;  //cut-off frequency normalized to the sampling frequency (0 - 0.5)
+    int decimation;  //one output sample every decimation input samples
+} filterSettings;
+
+typedef struct _biquadSection
+{
+    double b0, b1, b2, a1, a2;
+    double z1, z2;  //state of the transposed direct form II
+} biquadSection;
+
+//This class filters a signal while it is received, batch by batch
+//The state is kept between batches so that the output is the same as filtering the whole record at once
+//The decimation is applied at the output and, for the FIR filter, only the kept samples are calculated (polyphase)
+//The long FIR filters are calculated by overlap-save FFT convolution when the batch is long enough to fill the FFT blocks
+class streamFilter
+{
+public:
+    streamFilter(filterSettings settings, uint32_t input_index, uint32_t output_index);
+    ~streamFilter();
+
+    int process(const float *in, int N, std::vector<float> *out);  //filters N new samples and returns the number of output samples
+    void reset();  //clears the state of the filter
+
+    uint32_t getInputIndex() { return input_index; }
+    uint32_t getOutputIndex() { return output_index; }
+    filterSettings getSettings() { return settings; }
+
+    static QString getTypeText(int type);
+
+private:
+    filterSettings settings;
+    uint32_t input_index;  //index of the filtered signal in the pool
+    uint32_t output_index;  //index of the signal where the results are stored
+
+    int phase;  //input samples to be skipped before the next output sample
+
+    std::vector<biquadSection> sections;  //IIR
+    std::vector<float> taps;  //FIR
+    std::vector<float> line;  //FIR delay line followed by the new samples, moving average window
+    int line_pos;  //moving average position in the window
+    double sum;  //moving average running sum
+
+    int nfft;  //FIR: size of the FFT blocks, 0 if the filter is always calculated directly
+    kiss_fftr_cfg fft_fwd, fft_inv;
+    std::vector<kiss_fft_cpx> response;  //FFT of the reversed taps, divided by nfft
+    std::vector<kiss_fft_scalar> block;  //reused for every FFT block
+    std::vector<kiss_fft_cpx> spectrum;
+
+    void designIIR();
+    void designFIR();
+    bool use_FFT(int N);
+    int fir_FFT(int N, std::vector<float> *out);
+};
+
+#endif // STREAMFILTER_H
@@ -0,0 +1,259 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :sweepaccumulator.cpp
+  @brief    :Functions of the Sweep Accumulator Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "sweepaccumulator.h"
+#include "floatkernels.h"
+
+sweepAccumulator::sweepAccumulator()
+{
+    mode = SWEEP_MODE_OFF;
+    sweepCount = SWEEP_DEFAULT_COUNT;
+
+    source = -1;
+    edge = 0;
+    level = 0.0f;
+    position = 50;
+
+    length = 0;
+    x0 = 0.0f; dx = 0.0f; convY = 0.0f; offY = 0.0f;
+
+    revision = 0;
+    persistence = new densityMap(DENSITY_BINS);
+
+    reset();
+}
+
+sweepAccumulator::~sweepAccumulator()
+{
+    delete persistence;
+}
+
+void sweepAccumulator::reset()
+{
+    started = false;
+    epoch = 0;
+    nextAbs = 0;
+    pending = false;
+    sweepAbs = 0;
+    nSignals = 0;
+
+    sweeps = 0;
+    revision++;
+    average.clear();
+    persistence->clear();
+}
+
+void sweepAccumulator::setMode(int mode)
+{
+    if (this->mode == mode)
+        return;
+
+    this->mode = mode;
+    reset();
+}
+
+void sweepAccumulator::setTrigger(int source, int edge, float level, int position)
+{
+    if ((this->source == source) && (this->edge == edge) && (this->level == level) && (this->position == position))
+        return;
+
+    this->source = source;
+    this->edge = edge;
+    this->level = level;
+    this->position = position;
+    reset();
+}
+
+void sweepAccumulator::setSweepCount(int N)
+{
+    if (N < 1)
+        N = 1;
+    sweepCount = N;  //the sweeps already accumulated are kept, the new count applies from the next one
+}
+
+void sweepAccumulator::setMapping(int length, float x0, float dx, float convY, float offY)
+{
+    if (this->length != length)
+    {
+        this->length = length;
+        reset();
+    }
+
+    //the average does not depend on the position in the plot area, the persistence has to be drawn again
+    if ((this->x0 != x0) || (this->dx != dx) || (this->convY != convY) || (this->offY != offY))
+    {
+        this->x0 = x0;
+        this->dx = dx;
+        this->convY = convY;
+        this->offY = offY;
+        persistence->clear();
+    }
+}
+
+int sweepAccumulator::process(int n_signals, int n_points, float **buff_ptr, const signalSnapshot *snaps, QVector<bool> visible)
+{
+    int j, k, pre, begin, found;
+    uint64_t first;
+    float *s;
+
+    if ((mode == SWEEP_MODE_OFF) || (source < 0) || (source >= n_signals) || (length < 2) || (n_points < 2) || (visible.count() < n_signals))
+        return 0;
+
+    if (n_signals != nSignals)
+        reset();
+    nSignals = n_signals;
+
+    s = buff_ptr[source];
+    first = snaps[source].first;
+    pre = (length * position) / 100;
+    found = 0;
+
+    //after a clean or a downsample the positions start again, when starting we only look at the samples that can still contribute
+    if ((started == false) || (snaps[source].stats_epoch != epoch))
+    {
+        started = true;
+        epoch = snaps[source].stats_epoch;
+        pending = false;
+        nextAbs = first;
+        if (n_points > (sweepCount * length))
+            nextAbs = first + static_cast<uint64_t>(n_points - (sweepCount * length));
+    }
+
+    if (nextAbs < first)  //the samples have been dropped from the buffer before being scanned
+        nextAbs = first;
+    if (nextAbs > (first + static_cast<uint64_t>(n_points)))
+        return 0;
+
+    j = static_cast<int>(nextAbs - first);
+    if (j < 1)
+        j = 1;  //the crossing test needs the previous sample
+
+    while (true)
+    {
+        if (pending == false)
+        {
+            k = floatKernels::findCrossing(s, j, n_points, level, edge);
+            if (k == -1)
+            {
+                nextAbs = first + static_cast<uint64_t>(n_points);  //the last sample is scanned again as previous sample of the next batch
+                return found;
+            }
+
+            if ((k - pre) < 0)  //not enough samples before the trigger
+            {
+                j = k + 1;
+                continue;
+            }
+            pending = true;
+            sweepAbs = first + static_cast<uint64_t>(k - pre);
+        }
+
+        if (sweepAbs < first)  //the pending sweep is not complete anymore
+        {
+            pending = false;
+            j = 1;
+            continue;
+        }
+
+        begin = static_cast<int>(sweepAbs - first);
+        if ((begin + length) > n_points)  //waits for the rest of the sweep
+        {
+            nextAbs = sweepAbs;
+            return found;
+        }
+
+        accumulate(n_signals, buff_ptr, begin, visible);
+        found++;
+        pending = false;
+
+        //armed again after the sweep, the pre-trigger samples have to be new
+        j = begin + length + pre;
+        nextAbs = first + static_cast<uint64_t>(j);
+        if (j >= n_points)
+            return found;
+        if (j < 1)
+            j = 1;
+    }
+}
+
+void sweepAccumulator::accumulate(int n_signals, float **buff_ptr, int begin, QVector<bool> visible)
+{
+    int i, k;
+    float weight;
+    float *avg;
+    const float *data;
+
+    if (mode == SWEEP_MODE_PERSISTENCE)
+    {
+        persistence->decay(std::exp(-1.0f / static_cast<float>(sweepCount)));
+        for (i = 0; i < n_signals; i++)
+        {
+            if (visible[i] == true)
+                persistence->addTrace(buff_ptr[i] + begin, length, x0, dx, convY, offY);
+        }
+    }
+
+    if (mode == SWEEP_MODE_AVERAGE)
+    {
+        if (average.count() != n_signals)
+        {
+            average.resize(n_signals);
+            for (i = 0; i < n_signals; i++)
+                average[i].fill(NAN, length);
+        }
+
+        //cumulative average up to sweepCount sweeps, then the oldest sweeps fade out exponentially
+        if (sweeps < sweepCount)
+            weight = 1.0f / static_cast<float>(sweeps + 1);
+        else
+            weight = 1.0f / static_cast<float>(sweepCount);
+
+        for (i = 0; i < n_signals; i++)
+        {
+            avg = average[i].data();
+            data = buff_ptr[i] + begin;
+            for (k = 0; k < length; k++)
+            {
+                if (std::isfinite(data[k]) == false)
+                    continue;
+                if (std::isfinite(avg[k]) == false)
+                    avg[k] = data[k];
+                else
+                    avg[k] += weight * (data[k] - avg[k]);
+            }
+        }
+    }
+
+    sweeps++;
+    revision++;
+}
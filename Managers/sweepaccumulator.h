@@ -0,0 +1,103 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :sweepaccumulator.h
+  @brief    :Header of the Sweep Accumulator Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef SWEEPACCUMULATOR_H
+#define SWEEPACCUMULATOR_H
+
+#include <QVector>
+
+#include <stdint.h>
+#include <cmath>
+
+#include "Managers/signal_data.h"
+#include "Creators/densitymap.h"
+
+#define SWEEP_MODE_OFF          0
+#define SWEEP_MODE_PERSISTENCE  1  //every sweep is drawn in a decaying intensity map
+#define SWEEP_MODE_AVERAGE      2  //running average of the last sweeps
+#define SWEEP_DEFAULT_COUNT     16  //sweeps averaged, or sweeps after which the persistence has decayed to 1/e
+
+//Collects every triggered sweep of the incoming samples, not only the one displayed by the plot.
+//The trigger position is kept as an absolute sample position, so each batch is scanned only from where the previous one stopped.
+//After a sweep the trigger is armed again once the pre-trigger samples are available, as in a scope.
+class sweepAccumulator
+{
+public:
+    sweepAccumulator();
+    ~sweepAccumulator();
+
+    void setMode(int mode);
+    int getMode() { return mode; }
+    void setTrigger(int source, int edge, float level, int position);  //edge 0 => rising; 1 => falling; position 0 - 100 of the sweep
+    void setSweepCount(int N);
+    int getSweepCount() { return sweepCount; }
+    void setMapping(int length, float x0, float dx, float convY, float offY);  //sweep length and position of its samples in the plot area
+    void reset();
+
+    //scans the samples of the batch (the signals are aligned by index, the positions are the ones of the source), returns the sweeps found
+    int process(int n_signals, int n_points, float **buff_ptr, const signalSnapshot *snaps, QVector<bool> visible);
+
+    int getSweeps() { return sweeps; }  //sweeps accumulated since the last reset
+    int getLength() { return length; }
+    float *getAverage(int signal) { return average[signal].data(); }
+    uint64_t getRevision() { return revision; }  //increased at every sweep
+    densityMap *getPersistence() { return persistence; }
+
+private:
+    int mode;
+    int sweepCount;
+
+    int source;
+    int edge;
+    float level;
+    int position;
+
+    int length;
+    float x0, dx, convY, offY;
+
+    bool started;
+    uint64_t epoch;
+    uint64_t nextAbs;  //absolute position from which the trigger is searched
+    bool pending;  //a trigger has been found, the sweep is waiting for its last samples
+    uint64_t sweepAbs;  //absolute position of the first sample of the pending sweep
+    int nSignals;
+
+    int sweeps;
+    uint64_t revision;
+    QVector<QVector<float>> average;
+    densityMap *persistence;
+
+    void accumulate(int n_signals, float **buff_ptr, int begin, QVector<bool> visible);
+};
+
+#endif // SWEEPACCUMULATOR_H
@@ -0,0 +1,233 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :thumbnailgrabber.cpp
+  @brief    :Thumbnail grabber class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "thumbnailgrabber.h"
+
+thumbnailGrabber::thumbnailGrabber(QOpenGLWidget *widget) : QObject(widget)
+{
+    owner = widget;
+    gl32 = nullptr;
+    resolveFbo = nullptr;
+    smallFbo = nullptr;
+    pbo = 0;
+    fence = nullptr;
+    tag = 0;
+    requested = false;
+    pending = false;
+
+    pollTimer.setInterval(THUMB_POLL_MS);
+    connect(&pollTimer, &QTimer::timeout, this, &thumbnailGrabber::poll);
+    connect(&scaleWatch, &QFutureWatcher<QImage>::finished, this, &thumbnailGrabber::scaled);
+}
+
+thumbnailGrabber::~thumbnailGrabber()
+{
+    pollTimer.stop();
+}
+
+void thumbnailGrabber::capture()
+{
+    int width, height, smallWidth, smallHeight;
+    QOpenGLContext *ctx;
+
+    if ((requested == false) || (pending == true) || (scaleWatch.isRunning() == true))
+        return;
+
+    ctx = QOpenGLContext::currentContext();
+    if (ctx == nullptr)
+        return;
+
+    width = static_cast<int>(owner->width() * owner->devicePixelRatioF());
+    height = static_cast<int>(owner->height() * owner->devicePixelRatioF());
+    if ((width <= 0) || (height <= 0))
+        return;
+
+    smallWidth = THUMB_WIDTH * THUMB_OVERSAMPLING;
+    smallHeight = THUMB_HEIGHT * THUMB_OVERSAMPLING;
+
+    if (gl32 == nullptr)
+    {
+        gl32 = ctx->versionFunctions<QOpenGLFunctions_3_2_Core>();
+        if (gl32 != nullptr)
+            gl32->initializeOpenGLFunctions();
+    }
+
+    if ((resolveFbo != nullptr) && (resolveFbo->size() != QSize(width, height)))
+    {
+        delete resolveFbo;
+        resolveFbo = nullptr;
+    }
+    if (resolveFbo == nullptr)
+        resolveFbo = new QOpenGLFramebufferObject(width, height);
+    if (smallFbo == nullptr)
+        smallFbo = new QOpenGLFramebufferObject(smallWidth, smallHeight);
+
+    //the frame is resolved first, then reduced with linear filtering
+    QOpenGLFramebufferObject::blitFramebuffer(resolveFbo, QRect(0, 0, width, height), nullptr, QRect(0, 0, width, height), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    QOpenGLFramebufferObject::blitFramebuffer(smallFbo, QRect(0, 0, smallWidth, smallHeight), resolveFbo, QRect(0, 0, width, height), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    requested = false;
+
+    if (gl32 == nullptr)
+    {
+        finish(smallFbo->toImage(), false);
+        ctx->functions()->glBindFramebuffer(GL_FRAMEBUFFER, owner->defaultFramebufferObject());
+        return;
+    }
+
+    if (pbo == 0)
+    {
+        gl32->glGenBuffers(1, &pbo);
+        gl32->glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        gl32->glBufferData(GL_PIXEL_PACK_BUFFER, smallWidth * smallHeight * 4, nullptr, GL_STREAM_READ);
+        gl32->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    //the read returns immediately, the pixels are copied in the buffer when the GPU gets there
+    gl32->glBindFramebuffer(GL_READ_FRAMEBUFFER, smallFbo->handle());
+    gl32->glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+    gl32->glReadPixels(0, 0, smallWidth, smallHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl32->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    fence = gl32->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl32->glBindFramebuffer(GL_FRAMEBUFFER, owner->defaultFramebufferObject());
+
+    pending = true;
+    pollTimer.start();
+}
+
+void thumbnailGrabber::grab()
+{
+    QImage image;
+
+    if ((pending == true) || (scaleWatch.isRunning() == true))
+        return;
+
+    //the paint forced by the grab must not start a readback as well
+    requested = false;
+
+    //the read waits for the GPU, this is accepted since it is done only for the windows that are not painted
+    image = owner->grabFramebuffer();
+    if (image.isNull() == false)
+        finish(image, false);
+}
+
+void thumbnailGrabber::poll()
+{
+    GLenum status;
+    int smallWidth, smallHeight;
+    void *data;
+    QImage image;
+
+    if ((pending == false) || (gl32 == nullptr))
+    {
+        pollTimer.stop();
+        return;
+    }
+
+    smallWidth = THUMB_WIDTH * THUMB_OVERSAMPLING;
+    smallHeight = THUMB_HEIGHT * THUMB_OVERSAMPLING;
+
+    owner->makeCurrent();
+
+    status = gl32->glClientWaitSync(fence, 0, 0);  //does not wait
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        owner->doneCurrent();
+        return;
+    }
+
+    pollTimer.stop();
+    gl32->glDeleteSync(fence);
+    fence = nullptr;
+    pending = false;
+
+    if (status == GL_WAIT_FAILED)
+    {
+        qDebug("Thumbnail readback failed\n");
+    }
+    else
+    {
+        gl32->glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        data = gl32->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, smallWidth * smallHeight * 4, GL_MAP_READ_BIT);
+        if (data != nullptr)
+        {
+            image = QImage(static_cast<const uchar*>(data), smallWidth, smallHeight, QImage::Format_RGBA8888).copy();
+            gl32->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        gl32->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    owner->doneCurrent();
+
+    if (image.isNull() == false)
+        finish(image, true);
+}
+
+void thumbnailGrabber::finish(QImage image, bool flip)
+{
+    scaleWatch.setFuture(QtConcurrent::run(&thumbnailGrabber::scaleImage, image, flip));
+}
+
+QImage thumbnailGrabber::scaleImage(QImage image, bool flip)
+{
+    //the rows read back from OpenGL start from the bottom
+    if (flip == true)
+        image = image.mirrored();
+
+    return image.scaled(THUMB_WIDTH, THUMB_HEIGHT, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+void thumbnailGrabber::scaled()
+{
+    emit thumbnailReady(tag, scaleWatch.result());
+}
+
+void thumbnailGrabber::release()
+{
+    pollTimer.stop();
+
+    if ((fence != nullptr) && (gl32 != nullptr))
+        gl32->glDeleteSync(fence);
+    fence = nullptr;
+    pending = false;
+
+    if ((pbo != 0) && (gl32 != nullptr))
+        gl32->glDeleteBuffers(1, &pbo);
+    pbo = 0;
+
+    delete resolveFbo;
+    delete smallFbo;
+    resolveFbo = nullptr;
+    smallFbo = nullptr;
+    gl32 = nullptr;
+}
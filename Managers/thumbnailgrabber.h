@@ -0,0 +1,96 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :thumbnailgrabber.h
+  @brief    :Header for the thumbnail grabber class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef THUMBNAILGRABBER_H
+#define THUMBNAILGRABBER_H
+
+#include <QObject>
+#include <QOpenGLWidget>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions_3_2_Core>
+#include <QOpenGLFramebufferObject>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+#include <QImage>
+#include <QTimer>
+#include <QDebug>
+
+#define THUMB_WIDTH         150
+#define THUMB_HEIGHT        150
+#define THUMB_OVERSAMPLING  2  //the GPU reduces the frame to twice the size of the thumbnail, the last step is filtered by a worker thread
+#define THUMB_POLL_MS       15  //how often a pending readback is checked
+
+//This class makes the thumbnail of a plot window from the frame it has just rendered, without rendering it again
+//The frame is resolved and reduced on the GPU and read back through a pixel buffer object, the read is collected when the GPU is done
+//and the image is filtered down to the thumbnail size by a worker thread => the GUI thread never waits for the GPU nor scales the image
+//Only the frames painted after a request are captured => a plot that is not repainted keeps its thumbnail at no cost
+//A window that is hidden or minimized does not paint, its frame is rendered offscreen by grab()
+class thumbnailGrabber : public QObject
+{
+    Q_OBJECT
+
+public:
+    thumbnailGrabber(QOpenGLWidget *widget);
+    ~thumbnailGrabber();
+
+    void setTag(int value) { tag = value; }  //returned with the thumbnail
+    void request() { requested = true; }  //the next painted frame becomes the thumbnail
+    void capture();  //to be called at the end of paintGL
+    void grab();  //renders the frame now into the framebuffer of the widget and makes the thumbnail from it, the widget does not need to be visible
+    void release();  //frees the OpenGL objects, the context of the widget must be current
+
+signals:
+    void thumbnailReady(int tag, QImage image);
+
+private slots:
+    void poll();
+    void scaled();
+
+private:
+    QOpenGLWidget *owner;
+    QOpenGLFunctions_3_2_Core *gl32;  //nullptr if the functions are not available, the thumbnail is then read synchronously
+    QOpenGLFramebufferObject *resolveFbo;  //the multisampled frame cannot be scaled while it is resolved
+    QOpenGLFramebufferObject *smallFbo;
+    GLuint pbo;
+    GLsync fence;
+    QTimer pollTimer;
+    QFutureWatcher<QImage> scaleWatch;
+    int tag;
+    bool requested;
+    bool pending;  //a readback is in flight
+
+    void finish(QImage image, bool flip);
+    static QImage scaleImage(QImage image, bool flip);
+};
+
+#endif // THUMBNAILGRABBER_H
@@ -0,0 +1,271 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :timeindex.cpp
+  @brief    :Functions of the Time Index Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "timeindex.h"
+
+#include <math.h>
+
+timeIndex::timeIndex()
+{
+    frequency = 1.0;
+    first = 0;
+    total = 0;
+    reduced = 0;
+    pending = false;
+    pending_t = 0.0;
+}
+
+void timeIndex::append(int N)
+{
+    timeSegment seg;
+
+    //if N is <= 0 we exit
+    if (N <= 0)
+        return;
+
+    if ((segments.empty() == true) || (pending == true))
+    {
+        seg.index = total;
+        seg.t_start = (segments.empty() == true) ? 0.0 : pending_t;
+        if ((segments.empty() == false) && (seg.t_start < timeOf(count() - 1)))  //the time never goes back
+            seg.t_start = timeOf(count() - 1) + 1.0 / frequency;
+        segments.push_back(seg);
+        pending = false;
+    }
+
+    total += static_cast<uint64_t>(N);
+}
+
+void timeIndex::startSegment(double t)
+{
+    pending = true;
+    pending_t = t;
+}
+
+void timeIndex::trim(uint64_t maxData)
+{
+    size_t k;
+
+    if (count() <= maxData)
+        return;
+
+    first = toAbsolute(count() - maxData);
+    if (reduced < first)
+        reduced = first;
+
+    //the segments before first are not needed anymore, except the one still valid at first
+    k = find(first);
+    if (k > 0)
+        segments.erase(segments.begin(), segments.begin() + static_cast<long>(k));
+}
+
+void timeIndex::downsample(uint64_t keep)
+{
+    //if the full resolution part is not longer than keep we exit
+    if (countFull() <= keep + 1)
+        return;
+
+    //the times are calculated from the absolute indexes, so only the mapping of the stored samples changes
+    reduced += (countFull() - keep) & ~static_cast<uint64_t>(1);
+}
+
+void timeIndex::clear()
+{
+    segments.clear();
+    first = total;
+    reduced = total;
+    pending = false;
+}
+
+double timeIndex::timeOf(uint64_t idx)
+{
+    size_t k;
+    uint64_t abs_idx;
+
+    if (segments.empty() == true)
+        return 0.0;
+
+    abs_idx = toAbsolute(idx);
+    k = find(abs_idx);
+
+    return segments[k].t_start + static_cast<double>(abs_idx - segments[k].index) / frequency;
+}
+
+uint64_t timeIndex::nearest(double t)
+{
+    size_t k;
+    double pos;
+    uint64_t abs_idx, end, idx;
+
+    if (count() == 0)
+        return 0;
+
+    k = find_time(t);
+    end = segment_end(k);
+
+    pos = floor((t - segments[k].t_start) * frequency + 0.5);
+    if (pos < 0.0)
+        abs_idx = segments[k].index;
+    else if (segments[k].index + static_cast<uint64_t>(pos) >= end)
+    {
+        abs_idx = end - 1;
+        //in a gap between two segments the first sample of the next one may be closer
+        if ((k + 1 < segments.size()) && ((segments[k + 1].t_start - t) < (t - timeOf(toStored(abs_idx, false)))))
+            abs_idx = segments[k + 1].index;
+    }
+    else
+        abs_idx = segments[k].index + static_cast<uint64_t>(pos);
+
+    if (abs_idx < first)
+        abs_idx = first;
+
+    //in the reduced part the closest stored sample is one of the two around abs_idx
+    idx = toStored(abs_idx, false);
+    if ((idx + 1 < count()) && (fabs(timeOf(idx + 1) - t) < fabs(timeOf(idx) - t)))
+        idx++;
+
+    return idx;
+}
+
+int timeIndex::range(double t0, double t1, uint64_t *start, uint64_t *end)
+{
+    size_t k;
+    double pos;
+    uint64_t a, b, seg_end;
+    const double eps = 1e-6;  //tolerance on the sample position, for the rounding of the times
+
+    if ((count() == 0) || (t1 < t0))
+        return -1;
+
+    //first sample at or after t0
+    k = find_time(t0);
+    seg_end = segment_end(k);
+    pos = ceil((t0 - segments[k].t_start) * frequency - eps);
+    if (pos < 0.0)
+        a = segments[k].index;
+    else
+        a = segments[k].index + static_cast<uint64_t>(pos);
+    if ((a >= seg_end) && (k + 1 < segments.size()))
+        a = segments[k + 1].index;
+    if (a < first)
+        a = first;
+
+    //first sample after t1
+    k = find_time(t1);
+    seg_end = segment_end(k);
+    pos = floor((t1 - segments[k].t_start) * frequency + eps);
+    if (pos < 0.0)
+        b = segments[k].index;
+    else
+        b = segments[k].index + static_cast<uint64_t>(pos) + 1;
+    if (b > seg_end)
+        b = seg_end;
+
+    if (b <= a)
+        return -1;
+
+    *start = toStored(a, true);
+    *end = toStored(b, true);
+    if (*end <= *start)  //no stored sample between t0 and t1 in the reduced part
+        return -1;
+
+    return 0;
+}
+
+size_t timeIndex::find(uint64_t abs_idx)
+{
+    size_t low, high, mid;
+
+    //binary search of the last segment with index <= abs_idx
+    low = 0;
+    high = segments.size();
+    while (high - low > 1)
+    {
+        mid = (low + high) / 2;
+        if (segments[mid].index <= abs_idx)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+size_t timeIndex::find_time(double t)
+{
+    size_t low, high, mid;
+
+    //binary search of the last segment with t_start <= t
+    low = 0;
+    high = segments.size();
+    while (high - low > 1)
+    {
+        mid = (low + high) / 2;
+        if (segments[mid].t_start <= t)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+uint64_t timeIndex::segment_end(size_t k)
+{
+    if (k + 1 < segments.size())
+        return segments[k + 1].index;
+
+    return total;
+}
+
+uint64_t timeIndex::toAbsolute(uint64_t idx)
+{
+    uint64_t n_reduced;
+
+    n_reduced = (reduced - first) / 2;
+    if (idx < n_reduced)
+        return first + 2 * idx;
+
+    return reduced + (idx - n_reduced);
+}
+
+uint64_t timeIndex::toStored(uint64_t abs_idx, bool up)
+{
+    if (abs_idx >= reduced)
+        return (reduced - first) / 2 + (abs_idx - reduced);
+
+    if (up == true)
+        return (abs_idx - first + 1) / 2;
+
+    return (abs_idx - first) / 2;
+}
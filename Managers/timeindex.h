@@ -0,0 +1,84 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :timeindex.h
+  @brief    :Header of the Time Index Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+typedef struct _timeSegment
+{
+    uint64_t index;  //absolute index of the first sample of the segment
+    double t_start;  //time of the first sample in seconds, the following ones are spaced by the sampling period
+} timeSegment;
+
+//This class maps the samples of a recording to their time and back without accessing the data
+//Samples are received at a constant frequency: a new segment is opened only when the acquisition restarts after a pause
+//Sample indexes used in the interface are relative to the oldest sample still stored, as for the signals
+class timeIndex
+{
+public:
+    timeIndex();
+
+    void setFrequency(double frequency) { if (frequency > 0) this->frequency = frequency; }
+    void append(int N);  //adds N contiguous samples
+    void startSegment(double t);  //the next samples start at time t
+    void trim(uint64_t maxData);  //keeps only the last maxData samples
+    void downsample(uint64_t keep);  //halves the resolution of the samples older than the last keep full resolution samples, as done for the signals
+    void clear();
+
+    uint64_t count() { return (reduced - first) / 2 + (total - reduced); }  //number of samples stored
+    uint64_t countFull() { return total - reduced; }  //number of samples stored at full resolution
+    double timeOf(uint64_t idx);  //time of a sample, O(log n)
+    uint64_t nearest(double t);  //sample closest to t, O(log n)
+    int range(double t0, double t1, uint64_t *start, uint64_t *end);  //samples with t0 <= time <= t1 are [start, end), returns -1 if there are none
+
+private:
+    std::vector<timeSegment> segments;  //the first segment always starts at or before first
+    double frequency;
+    uint64_t first;  //absolute index of the oldest sample stored
+    uint64_t total;  //absolute index following the last sample stored
+    uint64_t reduced;  //absolute index of the first sample stored at full resolution, one sample every two is stored before it
+    bool pending;  //a new segment starts with the next samples
+    double pending_t;
+
+    size_t find(uint64_t abs_idx);  //position of the segment the sample belongs to
+    size_t find_time(double t);  //position of the last segment starting at or before t
+    uint64_t segment_end(size_t k);  //absolute index following the last sample of a segment
+    uint64_t toAbsolute(uint64_t idx);  //absolute index of a stored sample
+    uint64_t toStored(uint64_t abs_idx, bool up);  //stored sample at or before (up = false) or at or after (up = true) an absolute index
+};
+
+#endif // TIMEINDEX_H
@@ -0,0 +1,376 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :triggerengine.cpp
+  @brief    :Functions of the Trigger Engine Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "triggerengine.h"
+#include "floatkernels.h"
+
+#include <cstring>
+#include <algorithm>
+
+triggerEngine::triggerEngine(triggerSettings settings)
+{
+    if (settings.pre < 0)
+        settings.pre = 0;
+    if (settings.post < 1)
+        settings.post = 1;  //the trigger sample is always stored
+    if (settings.max_segments < 1)
+        settings.max_segments = 1;
+    this->settings = settings;
+
+    reset();
+}
+
+void triggerEngine::reset()
+{
+    int nc;
+
+    nc = settings.conditions.count();
+
+    total = 0;
+    armed_from = 0;
+    triggers = 0;
+
+    last_state.assign(static_cast<size_t>(nc), 1);  //no event on the first sample if the condition is already true
+    last_level.assign(static_cast<size_t>(nc), 1);
+    last_value.assign(static_cast<size_t>(nc), NAN);  //no edge on the first sample
+    pulse_start.assign(static_cast<size_t>(nc), UINT64_MAX);  //a pulse already started has no known width
+
+    pending.clear();
+    segments.clear();
+    input_positions.clear();  //set again by the first scan
+}
+
+QString triggerEngine::getTypeText(int type)
+{
+    switch (type)
+    {
+    case TRIGGER_COND_EDGE:
+        return "Edge";
+    case TRIGGER_COND_WINDOW:
+        return "Window";
+    case TRIGGER_COND_PULSE:
+        return "Pulse width";
+    default:
+        return "Unknown";
+    }
+}
+
+qint64 triggerEngine::getMemoryData()
+{
+    return static_cast<qint64>(segments.size()) * static_cast<qint64>(settings.capture.count()) * static_cast<qint64>(settings.pre + settings.post) * static_cast<qint64>(sizeof(float));
+}
+
+void triggerEngine::evaluate(int c, const float *s, int N, uint8_t *st, uint8_t *ev)
+{
+    const triggerCondition *cond = &settings.conditions[c];
+    size_t ci = static_cast<size_t>(c);
+    int k;
+    float level, low, high;
+    uint8_t prev;
+    uint64_t width;
+
+    level = cond->level;
+    low = cond->low;
+    high = cond->high;
+
+    //states: the comparisons are false for NAN, so that missing samples never trigger
+    switch (cond->type)
+    {
+    case TRIGGER_COND_WINDOW:
+        if (cond->slope == TRIGGER_SLOPE_FALLING)
+            for (k = 0; k < N; k++)
+                st[k] = static_cast<uint8_t>((s[k] < low) | (s[k] > high));
+        else
+            for (k = 0; k < N; k++)
+                st[k] = static_cast<uint8_t>((s[k] >= low) & (s[k] <= high));
+        break;
+
+    default:  //edge and pulse compare with the level
+        if (cond->slope == TRIGGER_SLOPE_FALLING)
+            for (k = 0; k < N; k++)
+                st[k] = static_cast<uint8_t>(s[k] <= level);
+        else
+            for (k = 0; k < N; k++)
+                st[k] = static_cast<uint8_t>(s[k] >= level);
+        break;
+    }
+
+    if (cond->type == TRIGGER_COND_PULSE)
+    {
+        //only the transitions of the level are followed, the event is the end of a pulse of the right width
+        std::memset(ev, 0, static_cast<size_t>(N));
+        prev = last_level[ci];
+        for (k = 0; k < N; k++)
+        {
+            if (st[k] != prev)
+            {
+                if (st[k] == 1)
+                    pulse_start[ci] = total + static_cast<uint64_t>(k);
+                else if (pulse_start[ci] != UINT64_MAX)
+                {
+                    width = total + static_cast<uint64_t>(k) - pulse_start[ci];
+                    if ((width >= cond->min_width) && (width <= cond->max_width))
+                        ev[k] = 1;
+                }
+                prev = st[k];
+            }
+        }
+        last_level[ci] = prev;
+        std::memcpy(st, ev, static_cast<size_t>(N));  //the condition is true only at the end of the pulse
+        return;
+    }
+
+    //edges: the previous sample is on the other side of the level, as in floatKernels::findCrossing
+    if ((cond->type == TRIGGER_COND_EDGE) && (cond->slope != TRIGGER_SLOPE_ANY))
+    {
+        if (cond->slope == TRIGGER_SLOPE_FALLING)
+        {
+            ev[0] = st[0] & static_cast<uint8_t>(last_value[ci] > level);
+            for (k = 1; k < N; k++)
+                ev[k] = st[k] & static_cast<uint8_t>(s[k - 1] > level);
+        }
+        else
+        {
+            ev[0] = st[0] & static_cast<uint8_t>(last_value[ci] < level);
+            for (k = 1; k < N; k++)
+                ev[k] = st[k] & static_cast<uint8_t>(s[k - 1] < level);
+        }
+        last_value[ci] = s[N - 1];
+        return;
+    }
+
+    //events: the state becomes true (edge any: the state changes)
+    prev = last_state[ci];
+    last_state[ci] = st[N - 1];
+    if (cond->type == TRIGGER_COND_EDGE)
+    {
+        ev[0] = st[0] ^ prev;
+        for (k = 1; k < N; k++)
+            ev[k] = st[k] ^ st[k - 1];
+        std::memcpy(st, ev, static_cast<size_t>(N));
+    }
+    else
+    {
+        ev[0] = st[0] & (prev ^ 1);
+        for (k = 1; k < N; k++)
+            ev[k] = st[k] & (st[k - 1] ^ 1);
+    }
+}
+
+void triggerEngine::add_Trigger(uint64_t pos, uint64_t row)
+{
+    pendingTrigger trig;
+
+    trig.pos = pos;
+    trig.row = row;
+    pending.push_back(trig);
+    triggers++;
+    armed_from = pos + std::max(settings.holdoff, static_cast<uint64_t>(1));
+}
+
+int triggerEngine::scan_Edge(const float *s, int N, uint64_t row, int rate_divider)
+{
+    const triggerCondition *cond = &settings.conditions[0];
+    int k, from, edge, found;
+
+    edge = KERNEL_EDGE_RISING;
+    if (cond->slope == TRIGGER_SLOPE_FALLING)
+        edge = KERNEL_EDGE_FALLING;
+
+    found = 0;
+
+    //the first sample is compared with the last one of the previous batch
+    if (total >= armed_from)
+    {
+        if (((edge == KERNEL_EDGE_RISING) && (last_value[0] < cond->level) && (s[0] >= cond->level)) ||
+            ((edge == KERNEL_EDGE_FALLING) && (last_value[0] > cond->level) && (s[0] <= cond->level)))
+        {
+            add_Trigger(total, row);
+            found++;
+        }
+    }
+
+    //the samples in the holdoff are skipped instead of being tested
+    from = 1;
+    while (from < N)
+    {
+        if (armed_from > total + static_cast<uint64_t>(from))
+        {
+            if (armed_from >= total + static_cast<uint64_t>(N))
+                break;
+            from = static_cast<int>(armed_from - total);
+        }
+        k = floatKernels::findCrossing(s, from, N, cond->level, edge);
+        if (k < 0)
+            break;
+        add_Trigger(total + static_cast<uint64_t>(k), row + static_cast<uint64_t>(k) * static_cast<uint64_t>(rate_divider));
+        found++;
+        from = k + 1;
+    }
+
+    last_value[0] = s[N - 1];
+    total += static_cast<uint64_t>(N);
+
+    return found;
+}
+
+int triggerEngine::process(const float **in, int N, uint64_t row, int rate_divider)
+{
+    int c, nc, k, b, e, found;
+    uint8_t acc;
+    uint8_t *st, *ev, *comb;
+    uint64_t pos;
+
+    nc = settings.conditions.count();
+    if ((nc == 0) || (N <= 0))
+        return 0;
+
+    //a single edge is searched directly in the samples, the masks are needed to combine several conditions, windows and pulses
+    if ((nc == 1) && (settings.conditions[0].type == TRIGGER_COND_EDGE) && (settings.conditions[0].slope != TRIGGER_SLOPE_ANY))
+        return scan_Edge(in[0], N, row, rate_divider);
+
+    state.resize(static_cast<size_t>(nc) * static_cast<size_t>(N));
+    event.resize(static_cast<size_t>(nc) * static_cast<size_t>(N));
+    combined.resize(static_cast<size_t>(N));
+    comb = combined.data();
+
+    for (c = 0; c < nc; c++)
+        evaluate(c, in[c], N, state.data() + (c * N), event.data() + (c * N));
+
+    //OR: any event; AND: any event while all the conditions are true
+    std::memcpy(comb, event.data(), static_cast<size_t>(N));
+    for (c = 1; c < nc; c++)
+    {
+        ev = event.data() + (c * N);
+        for (k = 0; k < N; k++)
+            comb[k] |= ev[k];
+    }
+    if (settings.combine == TRIGGER_COMBINE_AND)
+    {
+        for (c = 0; c < nc; c++)
+        {
+            st = state.data() + (c * N);
+            for (k = 0; k < N; k++)
+                comb[k] &= st[k];
+        }
+    }
+
+    found = 0;
+    for (b = 0; b < N; b += TRIGGER_SCAN_BLOCK)
+    {
+        e = std::min(b + TRIGGER_SCAN_BLOCK, N);
+        acc = 0;
+        for (k = b; k < e; k++)
+            acc |= comb[k];
+        if (acc == 0)
+            continue;
+
+        for (k = b; k < e; k++)
+        {
+            pos = total + static_cast<uint64_t>(k);
+            if ((comb[k] == 1) && (pos >= armed_from))
+            {
+                add_Trigger(pos, row + static_cast<uint64_t>(k) * static_cast<uint64_t>(rate_divider));
+                found++;
+            }
+        }
+    }
+
+    total += static_cast<uint64_t>(N);
+
+    return found;
+}
+
+int triggerEngine::capture(const signalSnapshot *snaps)
+{
+    int j, n_cap, length, done;
+    int64_t diff, div, first, a, b;
+    bool ready;
+    pendingTrigger trig;
+    triggerSegment seg;
+    std::vector<int64_t> trig_abs;
+
+    n_cap = settings.capture.count();
+    length = settings.pre + settings.post;
+    trig_abs.resize(static_cast<size_t>(n_cap));
+    done = 0;
+
+    while ((pending.empty() == false) && ((pending.front().pos + static_cast<uint64_t>(settings.post)) <= total))
+    {
+        trig = pending.front();
+
+        //absolute position of the trigger in each captured signal, negative if the signal started later
+        ready = true;
+        for (j = 0; j < n_cap; j++)
+        {
+            if (snaps[j].data == nullptr)
+                continue;
+            diff = static_cast<int64_t>(trig.row) - static_cast<int64_t>(snaps[j].origin);
+            div = static_cast<int64_t>(snaps[j].rate_divider);
+            if (diff >= 0)
+                trig_abs[static_cast<size_t>(j)] = diff / div;
+            else
+                trig_abs[static_cast<size_t>(j)] = -((div - 1 - diff) / div);
+            if (trig_abs[static_cast<size_t>(j)] + settings.post > static_cast<int64_t>(snaps[j].received))
+                ready = false;
+        }
+
+        //a signal that falls behind, e.g. a filter delaying its output, is waited for at most one more segment of the conditions
+        if ((ready == false) && ((trig.pos + static_cast<uint64_t>(settings.post + length)) > total))
+            break;
+        pending.pop_front();
+
+        seg.position = trig.row;
+        seg.data.resize(static_cast<size_t>(n_cap));
+        for (j = 0; j < n_cap; j++)
+        {
+            seg.data[static_cast<size_t>(j)].assign(static_cast<size_t>(length), NAN);
+            if (snaps[j].data == nullptr)
+                continue;
+
+            //position in the snapshot of the first sample of the segment
+            first = trig_abs[static_cast<size_t>(j)] - settings.pre - (static_cast<int64_t>(snaps[j].received) - static_cast<int64_t>(snaps[j].count));
+            a = std::max(first, static_cast<int64_t>(0));
+            b = std::min(first + length, static_cast<int64_t>(snaps[j].count));
+            if (b > a)
+                std::copy(snaps[j].data + a, snaps[j].data + b, seg.data[static_cast<size_t>(j)].begin() + (a - first));
+        }
+
+        segments.push_back(seg);
+        while (static_cast<int>(segments.size()) > settings.max_segments)
+            segments.pop_front();
+        done++;
+    }
+
+    return done;
+}
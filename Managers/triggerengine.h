@@ -0,0 +1,147 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :triggerengine.h
+  @brief    :Header of the Trigger Engine Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef TRIGGERENGINE_H
+#define TRIGGERENGINE_H
+
+#include <QVector>
+#include <QString>
+
+#include <deque>
+#include <vector>
+#include <stdint.h>
+#include <math.h>
+
+#include "signal_data.h"
+
+#define TRIGGER_COND_EDGE       0
+#define TRIGGER_COND_WINDOW     1
+#define TRIGGER_COND_PULSE      2
+
+#define TRIGGER_SLOPE_RISING    0  //edge: rising; window: entering; pulse: positive
+#define TRIGGER_SLOPE_FALLING   1  //edge: falling; window: leaving; pulse: negative
+#define TRIGGER_SLOPE_ANY       2  //edge only
+
+#define TRIGGER_COMBINE_OR      0  //any condition triggers
+#define TRIGGER_COMBINE_AND     1  //a condition triggers while all the others are true
+
+#define TRIGGER_SCAN_BLOCK          64  //samples of the trigger mask tested at once before looking for the triggering one
+#define TRIGGER_DEFAULT_SEGMENTS    256
+
+typedef struct _triggerCondition
+{
+    uint32_t signal_index;  //index of the signal in the pool
+    int type;
+    int slope;
+    float level;  //edge and pulse
+    float low, high;  //window
+    uint64_t min_width, max_width;  //pulse, in samples
+} triggerCondition;
+
+typedef struct _triggerSettings
+{
+    QVector<triggerCondition> conditions;
+    int combine;
+    uint64_t holdoff;  //samples after a trigger in which no other trigger is accepted
+    int pre;  //samples stored before the trigger
+    int post;  //samples stored from the trigger on
+    int max_segments;  //the oldest segments are dropped
+    QVector<uint32_t> capture;  //signals stored in each segment
+} triggerSettings;
+
+typedef struct _pendingTrigger
+{
+    uint64_t row;  //acquisition sample of the trigger
+    uint64_t pos;  //trigger sample, counted from the first sample scanned by the engine
+} pendingTrigger;
+
+typedef struct _triggerSegment
+{
+    uint64_t position;  //acquisition sample of the trigger
+    std::vector<std::vector<float>> data;  //pre + post samples per captured signal, NAN if they were not available anymore
+} triggerSegment;
+
+//Evaluates the trigger conditions on every received sample and stores each event in segmented memory, as the acquisition of a scope.
+//A single edge condition is searched directly with the crossing kernels. Otherwise each condition is first turned into a mask of states
+//and events with branch free loops over the batch, then the combined mask is tested in blocks so that only the blocks containing
+//an event are scanned sample by sample.
+//The condition signals are read from the absolute position following the last one scanned, as the math channels.
+//Each trigger is kept as an acquisition sample, so every captured signal is cut around its own sample of the same instant,
+//also when it is filtered, decimated or created later than the conditions.
+class triggerEngine
+{
+public:
+    triggerEngine(triggerSettings settings);
+
+    void reset();  //drops the segments and the events waiting for their post-trigger samples
+    int process(const float **in, int N, uint64_t row, int rate_divider);  //N new samples of each condition signal, the first one is the acquisition sample row, returns the triggers found
+    int capture(const signalSnapshot *snaps);  //completes the segments whose samples have all been received, snaps follow settings.capture
+
+    void setInputPositions(QVector<uint64_t> pos) { input_positions = pos; }
+    QVector<uint64_t> getInputPositions() { return input_positions; }
+
+    triggerSettings getSettings() { return settings; }
+    int getSegmentCount() { return static_cast<int>(segments.size()); }
+    const triggerSegment *getSegment(int i) { return &segments[static_cast<size_t>(i)]; }
+    uint64_t getTriggerCount() { return triggers; }  //also the ones dropped from the segmented memory
+    qint64 getMemoryData();
+
+    static QString getTypeText(int type);
+
+private:
+    triggerSettings settings;
+
+    uint64_t total;  //samples scanned since the last reset
+    uint64_t armed_from;  //end of the holdoff
+    uint64_t triggers;
+
+    //state of each condition at the last sample of the previous batch
+    std::vector<uint8_t> last_state;
+    std::vector<uint8_t> last_level;  //pulse: signal beyond the level
+    std::vector<uint64_t> pulse_start;
+    std::vector<float> last_value;  //edge: last sample of the previous batch
+
+    std::vector<uint8_t> state;  //per batch, reused
+    std::vector<uint8_t> event;
+    std::vector<uint8_t> combined;
+
+    std::deque<pendingTrigger> pending;  //triggers waiting for their post-trigger samples
+    QVector<uint64_t> input_positions;  //absolute position (received samples) of the next sample of each condition signal to be scanned
+    std::deque<triggerSegment> segments;
+
+    void evaluate(int c, const float *s, int N, uint8_t *st, uint8_t *ev);
+    void add_Trigger(uint64_t pos, uint64_t row);
+    int scan_Edge(const float *s, int N, uint64_t row, int rate_divider);  //single edge condition, searched with floatKernels::findCrossing
+};
+
+#endif // TRIGGERENGINE_H
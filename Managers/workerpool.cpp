@@ -0,0 +1,297 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :workerpool.cpp
+  @brief    :Functions of the Worker Pool Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#include "workerpool.h"
+
+workerPool *workerPool::instance = nullptr;
+static QMutex instanceLock;
+static thread_local int currentWorker = -1;  //index of the worker running on this thread, -1 outside the pool
+
+taskGroup::taskGroup()
+{
+    pending = 0;
+}
+
+taskGroup::~taskGroup()
+{
+    wait();
+}
+
+void taskGroup::add()
+{
+    QMutexLocker locker(&lock);
+
+    pending++;
+}
+
+void taskGroup::finish()
+{
+    QMutexLocker locker(&lock);
+
+    //the counter is changed under the lock, so the waiting thread cannot return and destroy the group before the wake up
+    pending--;
+    if (pending == 0)
+        done.wakeAll();
+}
+
+bool taskGroup::isDone()
+{
+    QMutexLocker locker(&lock);
+
+    return pending == 0;
+}
+
+void taskGroup::wait()
+{
+    workerPool *pool;
+
+    lock.lock();
+    while (pending > 0)
+    {
+        lock.unlock();
+        pool = workerPool::instance;
+        if ((pool != nullptr) && (pool->runOne(currentWorker) == true))  //helps while its tasks are queued
+        {
+            lock.lock();
+            continue;
+        }
+
+        //all the tasks are running on the other threads
+        lock.lock();
+        if (pending > 0)
+            done.wait(&lock);
+    }
+    lock.unlock();
+}
+
+void workerThread::run()
+{
+    currentWorker = index;
+    pool->work(index);
+}
+
+workerPool::workerPool()
+{
+    int i, n;
+
+    queued = 0;
+    stopping = false;
+    nextQueue = 0;
+
+    n = QThread::idealThreadCount() - 1;  //the thread waiting for a group works as well
+    if (n < 1)
+        n = 1;
+
+    for (i = 0; i < n; i++)
+        queues.append(new workerQueue);
+    for (i = 0; i < n; i++)
+    {
+        threads.append(new workerThread(this, i));
+        threads[i]->start();
+    }
+}
+
+workerPool::~workerPool()
+{
+    int i;
+
+    sleepLock.lock();
+    stopping = true;
+    wake.wakeAll();
+    sleepLock.unlock();
+
+    for (i = 0; i < threads.count(); i++)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+    for (i = 0; i < queues.count(); i++)
+        delete queues[i];
+}
+
+workerPool *workerPool::get()
+{
+    QMutexLocker locker(&instanceLock);
+
+    if (instance == nullptr)
+        instance = new workerPool;
+
+    return instance;
+}
+
+void workerPool::shutdown()
+{
+    QMutexLocker locker(&instanceLock);
+
+    delete instance;
+    instance = nullptr;
+}
+
+int workerPool::getThreadCount()
+{
+    return get()->threads.count();
+}
+
+void workerPool::run(taskGroup *group, std::function<void()> task)
+{
+    poolTask t;
+
+    t.run = task;
+    t.group = group;
+    if (group != nullptr)
+        group->add();
+
+    get()->push(t);
+}
+
+void workerPool::parallelFor(taskGroup *group, int count, int cost, std::function<void(int)> body)
+{
+    int first, batch;
+
+    if (count <= 0)
+        return;
+
+    if (cost < 1)
+        cost = 1;
+    batch = (POOL_MIN_TASK_SAMPLES + cost - 1) / cost;
+    if (batch < 1)
+        batch = 1;
+
+    for (first = 0; first < count; first += batch)
+    {
+        run(group, [first, batch, count, body]()
+        {
+            int i;
+
+            for (i = first; (i < first + batch) && (i < count); i++)
+                body(i);
+        });
+    }
+}
+
+void workerPool::push(poolTask task)
+{
+    int q;
+
+    //a worker keeps its own tasks, which are likely to use the data it is working on
+    if ((currentWorker >= 0) && (currentWorker < queues.count()))
+        q = currentWorker;
+    else
+    {
+        sleepLock.lock();
+        q = nextQueue;
+        nextQueue = (nextQueue + 1) % queues.count();
+        sleepLock.unlock();
+    }
+
+    sleepLock.lock();
+    queued++;
+    sleepLock.unlock();
+
+    queues[q]->lock.lock();
+    queues[q]->tasks.push_back(task);
+    queues[q]->lock.unlock();
+
+    sleepLock.lock();
+    wake.wakeOne();
+    sleepLock.unlock();
+}
+
+bool workerPool::runOne(int self)
+{
+    int i, q;
+    bool found;
+    poolTask task;
+
+    found = false;
+    //the own queue from the back, then the others from the front
+    if ((self >= 0) && (self < queues.count()))
+    {
+        queues[self]->lock.lock();
+        if (queues[self]->tasks.empty() == false)
+        {
+            task = queues[self]->tasks.back();
+            queues[self]->tasks.pop_back();
+            found = true;
+        }
+        queues[self]->lock.unlock();
+    }
+
+    for (i = 1; (i <= queues.count()) && (found == false); i++)
+    {
+        q = (self + i) % queues.count();  //self is -1 outside the pool
+        if (q == self)
+            continue;
+
+        queues[q]->lock.lock();
+        if (queues[q]->tasks.empty() == false)
+        {
+            task = queues[q]->tasks.front();
+            queues[q]->tasks.pop_front();
+            found = true;
+        }
+        queues[q]->lock.unlock();
+    }
+
+    if (found == false)
+        return false;
+
+    sleepLock.lock();
+    queued--;
+    sleepLock.unlock();
+
+    task.run();
+    if (task.group != nullptr)
+        task.group->finish();
+
+    return true;
+}
+
+void workerPool::work(int self)
+{
+    while (true)
+    {
+        if (runOne(self) == true)
+            continue;
+
+        sleepLock.lock();
+        while ((queued == 0) && (stopping == false))
+            wake.wait(&sleepLock);
+        if ((queued == 0) && (stopping == true))
+        {
+            sleepLock.unlock();
+            return;
+        }
+        sleepLock.unlock();
+    }
+}
@@ -0,0 +1,134 @@
+/**
+  *********************************************************************************************************************************************************
+  @file     :workerpool.h
+  @brief    :Header of the Worker Pool Class
+  *********************************************************************************************************************************************************
+  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+ 
+  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+ 
+  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+ 
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Affero General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or any later version.
+ 
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU Affero General Public License for more details.
+ 
+  You should have received a copy of the GNU Affero General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ 
+  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+ 
+  Commercial licensing opportunities
+  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+  *********************************************************************************************************************************************************
+  */
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+
+#include <deque>
+#include <functional>
+
+#define POOL_MIN_TASK_SAMPLES   32768  //samples processed by one task at least, the items of smaller jobs are batched together
+
+class workerPool;
+
+//Set of tasks that can be waited for together
+//wait() blocks without polling, the waiting thread executes queued tasks meanwhile so that no core is left idle
+class taskGroup
+{
+public:
+    taskGroup();
+    ~taskGroup();  //waits for the tasks still running
+
+    void wait();
+    bool isDone();
+
+private:
+    friend class workerPool;
+
+    QMutex lock;
+    QWaitCondition done;
+    int pending;  //tasks queued or running
+
+    void add();
+    void finish();
+};
+
+typedef struct _poolTask
+{
+    std::function<void()> run;
+    taskGroup *group;
+} poolTask;
+
+//Tasks queued to one worker, the owner takes the last one and the others steal the first one
+class workerQueue
+{
+public:
+    QMutex lock;
+    std::deque<poolTask> tasks;
+};
+
+class workerThread : public QThread
+{
+public:
+    workerThread(workerPool *pool, int index) { this->pool = pool; this->index = index; }
+
+protected:
+    void run() override;
+
+private:
+    workerPool *pool;
+    int index;
+};
+
+//Persistent threads shared by all the plot windows, created at the first use and kept till shutdown()
+//Each thread has its own queue and steals from the others when it is empty, so the tasks of several windows are spread over all the cores
+class workerPool
+{
+public:
+    static void run(taskGroup *group, std::function<void()> task);
+    //calls body(i) for every i in [0, count), cost is the number of samples processed by each call
+    //the calls are batched so that every task processes at least POOL_MIN_TASK_SAMPLES samples
+    static void parallelFor(taskGroup *group, int count, int cost, std::function<void(int)> body);
+
+    static int getThreadCount();
+    static void shutdown();  //finishes the queued tasks and stops the threads, to be called before the application exits
+
+private:
+    friend class workerThread;
+    friend class taskGroup;
+
+    workerPool();
+    ~workerPool();
+
+    QVector<workerQueue*> queues;
+    QVector<workerThread*> threads;
+    QMutex sleepLock;  //protects queued and stopping for the threads going to sleep
+    QWaitCondition wake;
+    int queued;  //tasks in all the queues
+    bool stopping;
+    int nextQueue;  //queue receiving the next task submitted from outside the pool
+
+    static workerPool *get();
+    static workerPool *instance;
+
+    void push(poolTask task);
+    bool runOne(int self);  //executes one queued task, false if all the queues are empty
+    void work(int self);
+};
+
+#endif // WORKERPOOL_H
@@ -53,6 +53,7 @@ typedef struct _statisticInfo
 {
     bool initialized;  //says whether min and max have been initialized
     float min, max, mean;
+    float rms, std;
     long n_samples;  //number of samples used on the mean
 } statisticInfo;
 
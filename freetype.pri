@@ -0,0 +1,89 @@
+#  *********************************************************************************************************************************************************
+#  @file     :freetype.pri
+#  @brief    :FreeType sources shared by the QT projects of ESPlot
+#  *********************************************************************************************************************************************************
+#  ESPlot allows real-time communication between an embedded system and a computer offering signal processing and plotting capabilities and it relies on
+#  hardware graphics acceleration for systems disposing of OpenGL-compatible graphic units. More info at www.uni-saarland.de/lehrstuhl/nienhaus/esplot.
+
+#  Copyright (C) Universität des Saarlandes 2020. Authors: Emanuele Grasso and Niklas König.
+
+#  The Software and the associated materials have been developed at the Universität des Saarlandes (hereinafter "UdS").
+#  Any copyright or patent right is owned by and proprietary material of the UdS hereinafter the “Licensor”.
+
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU Affero General Public License as
+#  published by the Free Software Foundation, either version 3 of the
+#  License, or any later version.
+
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#  GNU Affero General Public License for more details.
+
+#  You should have received a copy of the GNU Affero General Public License
+#  along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#  This Agreement shall be governed by the laws of the Federal Republic of Germany except for the UN Sales Convention and the German rules of conflict of law.
+
+#  Commercial licensing opportunities
+#  For commercial uses of the Software beyond the conditions applied by AGPL 3.0 please contact the Licensor sending an email to patentverwertungsagentur@uni-saarland.de
+#  *********************************************************************************************************************************************************
+
+INCLUDEPATH += $$PWD/3rdparty/FreeType/include
+INCLUDEPATH += $$PWD/3rdparty/FreeType/include/freetype/config
+
+SOURCES += \
+    $$PWD/3rdparty/FreeType/src/autofit/afangles.c \
+    $$PWD/3rdparty/FreeType/src/autofit/afdummy.c \
+    $$PWD/3rdparty/FreeType/src/autofit/afglobal.c \
+    $$PWD/3rdparty/FreeType/src/autofit/afhints.c \
+    $$PWD/3rdparty/FreeType/src/autofit/aflatin.c \
+    $$PWD/3rdparty/FreeType/src/autofit/afloader.c \
+    $$PWD/3rdparty/FreeType/src/autofit/afmodule.c \
+    $$PWD/3rdparty/FreeType/src/autofit/autofit.c \
+    $$PWD/3rdparty/FreeType/src/base/ftbase.c \
+    $$PWD/3rdparty/FreeType/src/base/ftbitmap.c \
+    $$PWD/3rdparty/FreeType/src/base/ftbbox.c \
+    $$PWD/3rdparty/FreeType/src/base/ftdebug.c \
+    $$PWD/3rdparty/FreeType/src/base/ftglyph.c \
+    $$PWD/3rdparty/FreeType/src/base/ftfntfmt.c \
+    $$PWD/3rdparty/FreeType/src/base/ftinit.c \
+    $$PWD/3rdparty/FreeType/src/base/ftlcdfil.c \
+    $$PWD/3rdparty/FreeType/src/base/ftmm.c \
+    $$PWD/3rdparty/FreeType/src/base/ftsynth.c \
+    $$PWD/3rdparty/FreeType/src/base/fttype1.c \
+    $$PWD/3rdparty/FreeType/src/bdf/bdf.c \
+    $$PWD/3rdparty/FreeType/src/cache/ftcache.c \
+    $$PWD/3rdparty/FreeType/src/cff/cff.c \
+    $$PWD/3rdparty/FreeType/src/cid/type1cid.c \
+    $$PWD/3rdparty/FreeType/src/gzip/ftgzip.c \
+    $$PWD/3rdparty/FreeType/src/lzw/ftlzw.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvalid.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvbase.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvcommn.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvgdef.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvgpos.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvgsub.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvjstf.c \
+    $$PWD/3rdparty/FreeType/src/otvalid/otvmod.c \
+    $$PWD/3rdparty/FreeType/src/pcf/pcf.c \
+    $$PWD/3rdparty/FreeType/src/pfr/pfr.c \
+    $$PWD/3rdparty/FreeType/src/psaux/psaux.c \
+    $$PWD/3rdparty/FreeType/src/pshinter/pshinter.c \
+    $$PWD/3rdparty/FreeType/src/psnames/psmodule.c \
+    $$PWD/3rdparty/FreeType/src/raster/raster.c \
+    $$PWD/3rdparty/FreeType/src/sfnt/sfnt.c \
+    $$PWD/3rdparty/FreeType/src/smooth/smooth.c \
+    $$PWD/3rdparty/FreeType/src/truetype/truetype.c \
+    $$PWD/3rdparty/FreeType/src/type1/type1.c \
+    $$PWD/3rdparty/FreeType/src/type42/type42.c \
+    $$PWD/3rdparty/FreeType/src/winfonts/winfnt.c
+
+win32 {
+    SOURCES += $$PWD/3rdparty/FreeType/src/base/ftsystem.c
+} else {
+   INCLUDEPATH += $$PWD/3rdparty/FreeType/builds/unix
+   SOURCES += $$PWD/3rdparty/FreeType/builds/unix/ftsystem.c
+}
+
+DEFINES += FT2_BUILD_LIBRARY
@@ -49,6 +49,7 @@
 
 #include "Managers/sgnalplottermanager.h"
 #include "Dialogs/plot_window.h"
+#include "Managers/workerpool.h"
 
 QPointer<LogBrowser> logBrowser;
 
@@ -65,6 +66,8 @@ void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QS
 int main(int argc, char *argv[])
 {
     Q_INIT_RESOURCE(resources);
+    //all the plot windows share their OpenGL objects, the shader programs and the font textures are created only once
+    QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
     QApplication app(argc, argv);
 
     logBrowser = new LogBrowser;
@@ -131,7 +134,10 @@ int main(int argc, char *argv[])
     mainApp.show();
     loadWdw.finish(&mainApp);
 
-    return app.exec();
+    int res = app.exec();
+    workerPool::shutdown();  //the windows are not prepared anymore, the threads of the pool can be stopped
+
+    return res;
 }
 
 void delay(int n)
@@ -227,6 +227,38 @@ void mainApplication::exportSignals()
     }
 }
 
+void mainApplication::exportTimeRange()
+{
+    double t_min, t_max, t0, t1;
+    bool ok;
+
+    if ((connectionStatus == false) || (spManager == 0))
+        return;
+
+    if (spManager->Get_Time_Bounds(&t_min, &t_max) != 0)
+        return;
+
+    t0 = QInputDialog::getDouble(this, "Export time range", "Start time in seconds:", t_min, t_min, t_max, 4, &ok);
+    if (ok == false)
+        return;
+    t1 = QInputDialog::getDouble(this, "Export time range", "End time in seconds:", t_max, t0, t_max, 4, &ok);
+    if (ok == false)
+        return;
+
+    QString filename = QFileDialog::getSaveFileName(this, "Export data", "", "Matlab File (*.mat)");
+
+    if (filename.isEmpty() == false)
+    {
+        int res = spManager->exportTimeRangeToFile(filename, t0, t1);
+        if (res != 0)
+        {
+            QMessageBox msgBox;
+            msgBox.setText("Error during export of data");
+            msgBox.exec();
+        }
+    }
+}
+
 void mainApplication::autoexportSignals()
 {
     //First we check if there are data to be saved in the buffer
@@ -409,6 +441,7 @@ void mainApplication::recordData()
 void mainApplication::stopData()
 {
     playTimer.stop();
+    spManager->Acquisition_Stopped();
     appStatus = STOP;
     updateStatus();
 }
@@ -421,7 +454,7 @@ void mainApplication::clearData()
     if (reply == QMessageBox::Yes)
     {
         spManager->clearAllData();  //clears all the data
-        memoryLabel->setText(interpretMemorySize(spManager->getSignalMemoryData()));
+        updateMemoryLabel();
         updateStatus();
     }
 }
@@ -437,6 +470,12 @@ void mainApplication::playIntervalChanged()
     playInterval = playTimeSB->value();
 }
 
+void mainApplication::maxFpsChanged()
+{
+    if (spManager != 0)
+        spManager->set_Max_Fps(maxFpsSB->value());  //the plots are not rendered more often than this, independently from the polling time
+}
+
 void mainApplication::nSamplesChanged()
 {
     if (spManager != 0)
@@ -486,6 +525,58 @@ void mainApplication::exportSignalFFT()
     spManager->exportFFT();
 }
 
+void mainApplication::memoryBudget()
+{
+    spManager->memoryBudgetSettings();
+    updateMemoryLabel();
+}
+
+void mainApplication::signalPriority()
+{
+    spManager->signalPrioritySettings();
+}
+
+void mainApplication::compressHistory()
+{
+    spManager->setHistoryCompression(compressHistoryAct->isChecked());
+}
+
+void mainApplication::mathChannel()
+{
+    spManager->newMathChannel();
+    updateMemoryLabel();
+}
+
+void mainApplication::filterChannel()
+{
+    spManager->newFilterChannel();
+    updateMemoryLabel();
+}
+
+void mainApplication::triggerEngineSettings()
+{
+    spManager->triggerEngineSettings();
+}
+
+void mainApplication::exportTriggerSegments()
+{
+    if ((connectionStatus == false) || (spManager == 0))
+        return;
+
+    QString filename = QFileDialog::getSaveFileName(this, "Export trigger segments", "", "Matlab File (*.mat)");
+
+    if (filename.isEmpty() == false)
+    {
+        int res = spManager->exportTriggerSegments(filename);
+        if (res != 0)
+        {
+            QMessageBox msgBox;
+            msgBox.setText("No trigger segments to be exported");
+            msgBox.exec();
+        }
+    }
+}
+
 void mainApplication::CreateMenuBar()
 {
     fileMenu = menuBar()->addMenu("&File");
@@ -498,6 +589,8 @@ void mainApplication::CreateMenuBar()
     fileMenu->addAction(clearAct);
     fileMenu->addSeparator();
     fileMenu->addAction(exportAct);
+    fileMenu->addAction(exportRangeAct);
+    fileMenu->addAction(exportSegmentsAct);
     fileMenu->addAction(autoExportAct);
     fileMenu->addAction(saveSettAct);
     fileMenu->addSeparator();
@@ -522,6 +615,14 @@ void mainApplication::CreateMenuBar()
     fftMenu->addAction(removeFFTAct);
     fftMenu->addSeparator();
     fftMenu->addAction(exportSignalFFTAct);
+    memoryMenu = toolMenu->addMenu("&Memory");
+    memoryMenu->addAction(memoryBudgetAct);
+    memoryMenu->addAction(signalPriorityAct);
+    memoryMenu->addSeparator();
+    memoryMenu->addAction(compressHistoryAct);
+    toolMenu->addAction(mathChannelAct);
+    toolMenu->addAction(filterChannelAct);
+    toolMenu->addAction(triggerEngineAct);
     toolMenu->addSeparator();
     toolMenu->addAction(organizeWndsAct);
 
@@ -552,6 +653,9 @@ void mainApplication::CreateMenuBar()
     toolBar->addWidget(new QLabel("Time(ms):  "));
     toolBar->addWidget(playTimeSB);
     toolBar->addSeparator();
+    toolBar->addWidget(new QLabel("FPS:  "));
+    toolBar->addWidget(maxFpsSB);
+    toolBar->addSeparator();
     toolBar->addWidget(new QLabel("Samples:  "));
     toolBar->addWidget(nSamplesSB);
     toolBar->addSeparator();
@@ -586,6 +690,14 @@ void mainApplication::CreateActions()
     exportAct->setStatusTip("Exports the recorded data");
     connect(exportAct, &QAction::triggered, this, &mainApplication::exportSignals);
 
+    exportRangeAct = new QAction("Export &time range...");
+    exportRangeAct->setStatusTip("Exports the data recorded between two instants");
+    connect(exportRangeAct, &QAction::triggered, this, &mainApplication::exportTimeRange);
+
+    exportSegmentsAct = new QAction("Export trigger &segments...");
+    exportSegmentsAct->setStatusTip("Exports the segments captured by the trigger engine");
+    connect(exportSegmentsAct, &QAction::triggered, this, &mainApplication::exportTriggerSegments);
+
     autoExportAct = new QAction("&Auto Export");
     autoExportAct->setIcon(QIcon(":/Icons/Icons/autosave.ico"));
     autoExportAct->setStatusTip("Automatically exports the recorded data");
@@ -709,6 +821,38 @@ void mainApplication::CreateActions()
     exportSignalFFTAct->setText("&Export to Matlab");
     connect(exportSignalFFTAct, &QAction::triggered, this, &mainApplication::exportSignalFFT);
 
+    memoryBudgetAct = new QAction(this);
+    memoryBudgetAct->setToolTip("Set the maximum memory to be used and the action taken when it is exceeded");
+    memoryBudgetAct->setText("&Memory Budget");
+    connect(memoryBudgetAct, &QAction::triggered, this, &mainApplication::memoryBudget);
+
+    signalPriorityAct = new QAction(this);
+    signalPriorityAct->setToolTip("Set which signals are reduced first when the memory budget is exceeded");
+    signalPriorityAct->setText("&Signal Priority");
+    connect(signalPriorityAct, &QAction::triggered, this, &mainApplication::signalPriority);
+
+    compressHistoryAct = new QAction(this);
+    compressHistoryAct->setCheckable(true);
+    compressHistoryAct->setChecked(false);
+    compressHistoryAct->setToolTip("Compress the recorded data older than the maximum number of samples");
+    compressHistoryAct->setText("&Compress Recorded History");
+    connect(compressHistoryAct, &QAction::triggered, this, &mainApplication::compressHistory);
+
+    mathChannelAct = new QAction(this);
+    mathChannelAct->setToolTip("Creates a new signal calculated from the received ones");
+    mathChannelAct->setText("New M&ath Channel");
+    connect(mathChannelAct, &QAction::triggered, this, &mainApplication::mathChannel);
+
+    filterChannelAct = new QAction(this);
+    filterChannelAct->setToolTip("Creates a new signal by filtering and decimating a received one");
+    filterChannelAct->setText("New &Filtered Signal");
+    connect(filterChannelAct, &QAction::triggered, this, &mainApplication::filterChannel);
+
+    triggerEngineAct = new QAction(this);
+    triggerEngineAct->setToolTip("Scans every received sample for trigger events and stores each event in segmented memory");
+    triggerEngineAct->setText("&Trigger Engine...");
+    connect(triggerEngineAct, &QAction::triggered, this, &mainApplication::triggerEngineSettings);
+
     showInfoDlg = new QAction(this);
     showInfoDlg->setToolTip("Show the info log");
     showInfoDlg->setText("Show info log");
@@ -732,6 +876,13 @@ void mainApplication::CreateMainWindow()
     playTimeSB->resize(playTimeSB->sizeHint());
     connect(playTimeSB, SIGNAL (editingFinished()), this, SLOT (playIntervalChanged()));
 
+    maxFpsSB = new QSpinBox(this);
+    maxFpsSB->setMinimum(1);
+    maxFpsSB->setMaximum(RENDER_MAX_FPS);
+    maxFpsSB->setValue(RENDER_DEFAULT_FPS);
+    maxFpsSB->resize(maxFpsSB->sizeHint());
+    connect(maxFpsSB, SIGNAL (editingFinished()), this, SLOT (maxFpsChanged()));
+
     nSamplesSB = new QSpinBox(this);
     nSamplesSB->setMinimum(2);
     nSamplesSB->setMaximum(std::numeric_limits<int>::max());
@@ -820,6 +971,7 @@ void mainApplication::ConnectAndPrepare(unsigned int index, int baudrate)
                 //We create spManager
                 spManager = new SgnalPlotterManager(prefMng->getPreferences(), fontMgr, fileGen);
                 spManager->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+                spManager->set_Max_Fps(maxFpsSB->value());
                 spManager->setMinimumHeight(600);
                 connect(spManager, &SgnalPlotterManager::replotCalled, this, &mainApplication::replotSlot);
                 connect(spManager, &SgnalPlotterManager::gridChanged, this, &mainApplication::gridChanged);
@@ -905,6 +1057,7 @@ void mainApplication::ConnectAndPrepare(unsigned int index, int baudrate)
                 //We create spManager
                 spManager = new SgnalPlotterManager(prefMng->getPreferences(), fontMgr, fileGen);
                 spManager->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+                spManager->set_Max_Fps(maxFpsSB->value());
 
                 QSplitter *split = new QSplitter(Qt::Vertical);
                 split->addWidget(devEdit);
@@ -1059,6 +1212,9 @@ void mainApplication::PollDataAndPlot()
         {
             spManager->Pass_Data_to_Signal(static_cast<unsigned int>(sig_indexes[static_cast<int>(i)]), data[i].data(), static_cast<int>(N_data));
         }
+        spManager->Update_Derived_Signals(static_cast<int>(N_data));  //math channels after all their inputs
+        spManager->Update_Triggers(static_cast<int>(N_data));  //the conditions may use the math channels
+        spManager->Update_Sweeps();  //every sweep is collected, also when the plots are not drawn
 
         if (autorecord_status == true)
         {
@@ -1127,7 +1283,7 @@ void mainApplication::PollDataAndPlot()
         messLabel->setStyleSheet("QLabel { color : black; }");
     messLabel->setText(QString::number(passed_time) + " ms");
 
-    memoryLabel->setText(interpretMemorySize(spManager->getSignalMemoryData()));
+    updateMemoryLabel();
 
     playTimer.start();
 }
@@ -1184,6 +1340,49 @@ QColor mainApplication::get_random_color()
     return col;
 }
 
+void mainApplication::updateMemoryLabel()
+{
+    memoryReport report;
+    mem_status_t st;
+    QString tip;
+
+    if (spManager == 0)
+        return;
+
+    st = spManager->enforceMemoryBudget(&report);
+
+    tip = "Signals: " + interpretMemorySize(report.signalBytes);
+    tip += "\nCommands: " + interpretMemorySize(report.commandBytes);
+    tip += "\nFFT: " + interpretMemorySize(report.fftBytes);
+    tip += "\nPlot buffers: " + interpretMemorySize(report.stagingBytes);
+    if (report.systemAvailable >= 0)
+        tip += "\nSystem free: " + interpretMemorySize(report.systemAvailable);
+
+    switch (st)
+    {
+    case MEM_WARNING:
+        memoryLabel->setStyleSheet("QLabel { color : orange; }");
+        tip += "\nThe memory budget is almost reached";
+        break;
+
+    case MEM_BUDGET_HIT:
+        memoryLabel->setStyleSheet("QLabel { color : red; }");
+        tip += "\nThe memory budget has been exceeded";
+        break;
+
+    case MEM_SYSTEM_LOW:
+        memoryLabel->setStyleSheet("QLabel { color : red; }");
+        tip += "\nThe system is running out of memory";
+        break;
+
+    default:
+        memoryLabel->setStyleSheet("QLabel { color : black; }");
+    }
+
+    memoryLabel->setText(interpretMemorySize(report.totalBytes));
+    memoryLabel->setToolTip(tip);
+}
+
 QString mainApplication::interpretMemorySize(qint64 mem)
 {
     QString ret;
@@ -1255,6 +1454,10 @@ void mainApplication:: updateStatus()
         loadSettAct->setEnabled(false);
         organizeWndsAct->setEnabled(false);
         fftMenu->setEnabled(false);
+        memoryMenu->setEnabled(false);
+        mathChannelAct->setEnabled(false);
+        filterChannelAct->setEnabled(false);
+        triggerEngineAct->setEnabled(false);
         newFFTWindowAct->setEnabled(false);
         remFFTWindowAct->setEnabled(false);
         associateFFTAct->setEnabled(false);
@@ -1264,6 +1467,8 @@ void mainApplication:: updateStatus()
         nGridSB->setEnabled(false);
         gridTrigAct->setEnabled(false);
         exportAct->setEnabled(false);
+        exportRangeAct->setEnabled(false);
+        exportSegmentsAct->setEnabled(false);
         autoExportAct->setEnabled(false);
         loadStyle1Act->setEnabled(false);
         loadStyle2Act->setEnabled(false);
@@ -1278,6 +1483,7 @@ void mainApplication:: updateStatus()
         loadSettAct->setEnabled(true);
         organizeWndsAct->setEnabled(true);
         fftMenu->setEnabled(true);
+        memoryMenu->setEnabled(true);
         nSamplesSB->setEnabled(true);
         nGridSB->setEnabled(true);
         gridTrigAct->setEnabled(true);
@@ -1293,6 +1499,8 @@ void mainApplication:: updateStatus()
             recordTimer.stop();
             recordTimeAct->setVisible(false);
             exportAct->setEnabled(true);
+            exportRangeAct->setEnabled(true);
+            exportSegmentsAct->setEnabled(true);
             autoExportAct->setEnabled(true);
             openConnAct->setEnabled(false);
             closeConnAct->setEnabled(true);
@@ -1310,6 +1518,9 @@ void mainApplication:: updateStatus()
             playAct->setEnabled(true);
             stopAct->setEnabled(false);
             clearAct->setEnabled(false);
+            mathChannelAct->setEnabled(true);
+            filterChannelAct->setEnabled(true);
+            triggerEngineAct->setEnabled(true);
             newFFTWindowAct->setEnabled(true);
             remFFTWindowAct->setEnabled(true);
             associateFFTAct->setEnabled(true);
@@ -1324,6 +1535,8 @@ void mainApplication:: updateStatus()
             recordTimer.stop();
             recordTimeAct->setVisible(false);
             exportAct->setEnabled(false);
+            exportRangeAct->setEnabled(false);
+            exportSegmentsAct->setEnabled(false);
             autoExportAct->setEnabled(false);
             openConnAct->setEnabled(false);
             closeConnAct->setEnabled(true);
@@ -1339,6 +1552,9 @@ void mainApplication:: updateStatus()
             playAct->setEnabled(false);
             stopAct->setEnabled(true);
             clearAct->setEnabled(false);
+            mathChannelAct->setEnabled(false);
+            filterChannelAct->setEnabled(false);
+            triggerEngineAct->setEnabled(false);
             newFFTWindowAct->setEnabled(false);
             remFFTWindowAct->setEnabled(false);
             associateFFTAct->setEnabled(false);
@@ -1355,6 +1571,8 @@ void mainApplication:: updateStatus()
             recordTime = 0;
             recordTimer.start(1000);  //updates each second
             exportAct->setEnabled(false);
+            exportRangeAct->setEnabled(false);
+            exportSegmentsAct->setEnabled(false);
             autoExportAct->setEnabled(false);
             openConnAct->setEnabled(false);
             closeConnAct->setEnabled(true);
@@ -1364,6 +1582,9 @@ void mainApplication:: updateStatus()
             playAct->setChecked(true);
             stopAct->setEnabled(true);
             clearAct->setEnabled(false);
+            mathChannelAct->setEnabled(false);
+            filterChannelAct->setEnabled(false);
+            triggerEngineAct->setEnabled(false);
             newFFTWindowAct->setEnabled(false);
             remFFTWindowAct->setEnabled(false);
             associateFFTAct->setEnabled(false);
@@ -1377,6 +1598,8 @@ void mainApplication:: updateStatus()
             stat = "Ready for communication";
             recordTimer.stop();
             exportAct->setEnabled(true);
+            exportRangeAct->setEnabled(true);
+            exportSegmentsAct->setEnabled(true);
             autoExportAct->setEnabled(true);
             openConnAct->setEnabled(false);
             closeConnAct->setEnabled(true);
@@ -1391,6 +1614,9 @@ void mainApplication:: updateStatus()
             else {
                 clearAct->setEnabled(true);
             }
+            mathChannelAct->setEnabled(true);
+            filterChannelAct->setEnabled(true);
+            triggerEngineAct->setEnabled(true);
             newFFTWindowAct->setEnabled(true);
             remFFTWindowAct->setEnabled(true);
             associateFFTAct->setEnabled(true);
@@ -101,6 +101,8 @@ private slots:
     void openConnection();
     void closeConnection();
     void exportSignals();
+    void exportTimeRange();
+    void exportTriggerSegments();
     void autoexportSignals();
     void saveSettings();
     void preferenceWindow();
@@ -117,6 +119,7 @@ private slots:
     void clearData();
     void organizeWds();
     void playIntervalChanged();
+    void maxFpsChanged();
     void nSamplesChanged();
     void nGridChanged();
     void gridTrigActivated();
@@ -125,6 +128,12 @@ private slots:
     void associateSignalFFT();
     void removeSignalFFT();
     void exportSignalFFT();
+    void memoryBudget();
+    void signalPriority();
+    void compressHistory();
+    void mathChannel();
+    void filterChannel();
+    void triggerEngineSettings();
 
     void PollDataAndPlot();
     void updateRecordTime();
@@ -158,6 +167,7 @@ private:
     uint64_t recordTime;
     int playInterval;  //it indicates the minimum time to wait for polling new data
     QSpinBox *playTimeSB;
+    QSpinBox *maxFpsSB;  //frame rate cap of the plots
     QSpinBox *nSamplesSB;
     QSpinBox *nGridSB;
 
@@ -179,10 +189,13 @@ private:
     QMenu *optionsMenu;
     QMenu *toolMenu;
     QMenu *fftMenu;
+    QMenu *memoryMenu;
     QMenu *helpMenu;
     QAction *openConnAct;
     QAction *closeConnAct;
     QAction *exportAct;
+    QAction *exportRangeAct;
+    QAction *exportSegmentsAct;
     QAction *autoExportAct;
     QAction *saveSettAct;
     QAction *exitAct;
@@ -204,6 +217,12 @@ private:
     QAction *associateFFTAct;
     QAction *removeFFTAct;
     QAction *exportSignalFFTAct;
+    QAction *memoryBudgetAct;
+    QAction *signalPriorityAct;
+    QAction *compressHistoryAct;
+    QAction *mathChannelAct;
+    QAction *filterChannelAct;
+    QAction *triggerEngineAct;
     QAction *recordTimeAct;
     QAction *showInfoDlg;
     QAction *gridTrigAct;
@@ -216,6 +235,7 @@ private:
     void PreparePlots();
     QColor get_random_color();  //TO BE DELETED LATER ON
     QString interpretMemorySize(qint64 mem);
+    void updateMemoryLabel();  //applies the memory budget and shows the memory status
     parse_res parseCmd(vector<uint8_t> c);
 };
 